@@ -49,5 +49,7 @@
 #include <isl_connect.h>
 #include <isl_instances.h>
 #include <isl_simulations.h>
+#include <isl_trace.h>
+#include <isl_manifest.h>
 
 #endif // _ISL_API_H_
@@ -53,12 +53,15 @@ extern "C" {
 #endif // __cplusplus
 
 	ISL_API_EXPORT const char * ISL_GetVersionNumber();
+	ISL_API_EXPORT int ISL_ReloadSettings();
 
 	ISL_API_EXPORT const char * ISL_GetLogFile();
 	ISL_API_EXPORT void ISL_LogError(unsigned int uId, const char * sFormat, ...);
 	ISL_API_EXPORT void ISL_LogWarning(unsigned int uId, const char * sFormat, ...);
 	ISL_API_EXPORT void ISL_LogInfo(unsigned int uId, const char * sFormat, ...);
 	ISL_API_EXPORT void ISL_LogDebug(unsigned int uLevel, unsigned int uId, const char * sFormat, ...);
+	ISL_API_EXPORT void ISL_FlushLog();
+	ISL_API_EXPORT unsigned int ISL_GetLogDropped();
 
 	ISL_API_EXPORT int ISL_StartThreadListenToStop(void * pConnect);
 	ISL_API_EXPORT int ISL_SendStopRequest();
@@ -94,6 +97,16 @@ extern "C" {
 	ISL_API_EXPORT double ISL_ConnectGetStepSize(void * pConnect);
 	ISL_API_EXPORT int ISL_ConnectSetStepTolerance(void * pConnect, double dVal);
 	ISL_API_EXPORT double ISL_ConnectGetStepTolerance(void * pConnect);
+	ISL_API_EXPORT int ISL_ConnectSetLockFree(void * pConnect, int nVal);
+	ISL_API_EXPORT int ISL_ConnectIsLockFree(void * pConnect);
+	ISL_API_EXPORT int ISL_ConnectSetFutex(void * pConnect, int nVal);
+	ISL_API_EXPORT int ISL_ConnectIsFutex(void * pConnect);
+	ISL_API_EXPORT int ISL_ConnectSetWaitPolicy(void * pConnect, int nPolicy); // 0: block, 1: spin, 2: spinpause, 3: busypoll
+	ISL_API_EXPORT int ISL_ConnectGetWaitPolicy(void * pConnect);
+	ISL_API_EXPORT int ISL_ConnectSetSpinCount(void * pConnect, int nCount);
+	ISL_API_EXPORT int ISL_ConnectGetSpinCount(void * pConnect);
+	ISL_API_EXPORT int ISL_ConnectSetConnectThreads(void * pConnect, int nNbThreads); // 0: number of cores
+	ISL_API_EXPORT int ISL_ConnectGetConnectThreads(void * pConnect);
 
 	// Causality values: IN = 0, OUT = 1;
 	// Type values: Real = 0, Integer = 1, Boolean = 3, String = 4
@@ -124,6 +137,14 @@ extern "C" {
 	ISL_API_EXPORT int ISL_ConnectCreate(void * pConnect, const char * sSessionId);
 	ISL_API_EXPORT int ISL_ConnectConnect(void * pConnect, int nWait);
 	ISL_API_EXPORT int ISL_ConnectDisconnect(void * pConnect);
+	ISL_API_EXPORT int ISL_ConnectBeginFrame(void * pConnect);
+	ISL_API_EXPORT int ISL_ConnectCommitFrame(void * pConnect, int nKeepOpen);
+	// Bitmaps of the inputs: bit i%8 of byte i/8 for the input i, all selected if pSelected is NULL
+	ISL_API_EXPORT int ISL_ConnectWaitInputs(void * pConnect, double dTime, int nTimeout, int nAny,
+		const unsigned char * pSelected, unsigned char * pReady);
+	ISL_API_EXPORT int ISL_ConnectGetNotifyHandle(void * pConnect);
+	ISL_API_EXPORT int ISL_ConnectResetNotifyHandle(void * pConnect);
+	ISL_API_EXPORT int ISL_ConnectTraceStep(void * pConnect, double dTime);
 
 	ISL_API_EXPORT int ISL_ConnectListenToExitSession(void * pConnect);
 	ISL_API_EXPORT int ISL_ConnectSendStopSession(void * pConnect);
@@ -154,11 +175,32 @@ extern "C" {
 	ISL_API_EXPORT int ISL_IOIsStoreUsed(void * pData);
 	ISL_API_EXPORT int ISL_IOSetSyncTimeout(void * pData, int nTimeout); // Set in seconds
 	ISL_API_EXPORT int ISL_IOGetSyncTimeout(void * pData);
+	ISL_API_EXPORT int ISL_IOSetWaitPolicy(void * pData, int nPolicy); // 4: policy of the connector
+	ISL_API_EXPORT int ISL_IOGetWaitPolicy(void * pData);
+	ISL_API_EXPORT int ISL_IOSetMode(void * pData, int nMode); // 0: fifo, 1: latest
+	ISL_API_EXPORT int ISL_IOGetMode(void * pData);
+	ISL_API_EXPORT int ISL_IOSetBackPressure(void * pData, int nPolicy); // 0: block, 1: dropoldest, 2: dropnewest
+	ISL_API_EXPORT int ISL_IOGetBackPressure(void * pData);
+	ISL_API_EXPORT int ISL_IOGetOverruns(void * pData, unsigned int * uCount);
+	ISL_API_EXPORT int ISL_IOGetDropped(void * pData, unsigned int * uCount);
+	ISL_API_EXPORT int ISL_IOUseHugePages(void * pData, int nUse);
+	ISL_API_EXPORT int ISL_IOSetNumaPolicy(void * pData, int nPolicy, int nNode); // 0: default, 1: bind to nNode, 2: interleave
+	ISL_API_EXPORT int ISL_IOGetNumaPolicy(void * pData);
+	ISL_API_EXPORT int ISL_IOSetSpinCount(void * pData, int nCount); // <0: value of the connector
+	ISL_API_EXPORT int ISL_IOGetSpinCount(void * pData);
 
 	ISL_API_EXPORT int ISL_IOSetData(void * pData, void * pVal, double dTime, int nWait);
 	ISL_API_EXPORT int ISL_IOSetDataAndNextStep(void * pData, void * pVal, double dTime, double dStep, int nWait);
 	ISL_API_EXPORT int ISL_IOGetLastData(void * pData, void * pVal, double * dTime, int nWait);
 	ISL_API_EXPORT int ISL_IOGetData(void * pData, void * pVal, double * dOutTime, double dInTime, int nWait);
+	// Return the number of values written/read, dSteps can be NULL
+	ISL_API_EXPORT int ISL_IOSetDataBatch(void * pData, void * pVals, double * dTimes, double * dSteps, int nCount, int nWait);
+	ISL_API_EXPORT int ISL_IOGetDataBatch(void * pData, void * pVals, double * dTimes, double * dSteps, int nCount, int nWait);
+	// Zero-copy accesses: the returned pointer is valid until the commit/release
+	ISL_API_EXPORT void * ISL_IOReserveSlot(void * pData, int nWait);
+	ISL_API_EXPORT int ISL_IOCommitSlot(void * pData, double dTime);
+	ISL_API_EXPORT const void * ISL_IOAcquireReadSlot(void * pData, double * dTime, int nWait);
+	ISL_API_EXPORT int ISL_IOReleaseReadSlot(void * pData);
 
 	ISL_API_EXPORT int ISL_IOSetEventData(void * pData, void * pVal, int nWait);
 	ISL_API_EXPORT int ISL_IOGetEventData(void * pData, void * pVal, int nWait);
@@ -176,6 +218,7 @@ extern "C" {
 
 	ISL_API_EXPORT int ISL_SimsGetMaxNb();
 	ISL_API_EXPORT int ISL_SimsGet(int nInd);
+	ISL_API_EXPORT int ISL_SimsFind(const char * sSessionId, int nNext);
 	ISL_API_EXPORT int ISL_SimsClose();
 
 	ISL_API_EXPORT unsigned int ISL_SimsGetType();
@@ -52,6 +52,10 @@
 namespace isl {
 	class CSHMConnect;
 	class CSHM;
+	class CNotify;
+	class CPublish;
+	class CSessionKeys;
+	class CManifest;
 	class CDataType;
 	class CVariable;
 	class CData;
@@ -107,6 +111,17 @@ namespace isl {
 		double GetStepSize();
 		void SetStepTolerance(double dVal);
 		double GetStepTolerance();
+		void SetLockFree(bool bVal);
+		bool IsLockFree();
+		void SetFutex(bool bVal);
+		bool IsFutex();
+		void SetWaitPolicy(CVariable::tWaitPolicy eWaitPolicy);
+		CVariable::tWaitPolicy GetWaitPolicy();
+		void SetSpinCount(int nCount);
+		int GetSpinCount();
+		// Threads creating the outputs and attaching the inputs (0: number of cores, 1: no thread)
+		void SetConnectThreads(unsigned int uNbThreads);
+		unsigned int GetConnectThreads();
 
 		CData * NewIO(const std::string & sId, CVariable::tCausality eCausality, CDataType::tType eType, int nSize = 1);
 		bool AddIO(CData * cData);
@@ -138,9 +153,40 @@ namespace isl {
 		bool Connect(bool bWait = true);
 		bool Disconnect();
 
+		// The outputs written between BeginFrame and CommitFrame are published together
+		bool BeginFrame();
+		bool CommitFrame(bool bKeepOpen = false); // bKeepOpen: a new frame starts
+		bool IsInFrame();
+
+		// Wait until the selected inputs have a value at dTime: all of them or, with bAny, at least one.
+		// lSelected and lReady are indexed as GetInput(i), all the inputs are selected without lSelected.
+		// nTimeout in milliseconds, no timeout if negative. Return the number of inputs ready, -1 on error.
+		int WaitInputs(double dTime, int nTimeout, std::vector<bool> * lReady = 0, bool bAny = false,
+			const std::vector<bool> * lSelected = 0);
+		// Handle (file descriptor) readable when a value is published on an input, to be used
+		// in an event loop (Linux only, -1 otherwise). ResetNotifyHandle is called before
+		// reading the inputs without waiting.
+		int GetNotifyHandle();
+		bool ResetNotifyHandle();
+
+		// Records a step boundary in the trace of the data exchanges (Trace setting)
+		void TraceStep(double dTime);
+
+		// Publication of the variables of the session (opened when first used, 0 on failure)
+		CPublish * GetPublish();
+		// Identifiers of the IPC objects of the session (opened when first used, 0 if not used)
+		CSessionKeys * GetSessionKeys();
+		// Variables written in the session (opened when first used, 0 on failure)
+		CManifest * GetManifest();
+		// Notification of a connector reading the outputs, shared by them (0 if not attached)
+		CNotify * GetNotify(unsigned int uId);
+
 	private:
 		bool ConnectAsViewer(bool bWait);
 		bool DisconnectAsViewer();
+		// Logs one error for all the variables failed to connect, with nRet their results
+		void LogFailedIOs(int nCode, const char * sCausality, size_t nCount,
+			const std::vector<CData *> & lFailed, const std::vector<int> & lRet);
 
 	public:
 		void StartTimer();
@@ -168,6 +214,11 @@ namespace isl {
 		double m_dEndTime;
 		double m_dStepSize;
 		double m_dStepTolerance;
+		bool m_bLockFree; // FIFO accessed without the SHM lock
+		bool m_bFutex; // Waits on shared memory words (Linux only)
+		CVariable::tWaitPolicy m_eWaitPolicy; // Default policy of the variables
+		int m_nSpinCount;
+		unsigned int m_uConnectThreads;
 
 		std::vector<CData *> m_lIOs;
 		std::vector<CData *> m_lIns;
@@ -179,15 +230,26 @@ namespace isl {
 
 		CSHM * m_cContainer;
 		CSHMConnect * m_cData;
+		CNotify * m_cNotify; // Released by the writers of the inputs
+		std::map<unsigned int, CNotify *> m_mNotify; // Connectors reading the outputs, by id
+		CPublish * m_cPublish; // Released when a variable of the session is created
+		bool m_bNoPublish; // The publication cannot be opened: the inputs are polled
+		CSessionKeys * m_cKeys;
+		bool m_bNoKeys; // The IPC objects are created from their keys
+		CManifest * m_cManifest;
+		bool m_bNoManifest;
 
 		bool m_bCloseLog;
 		bool m_bManager;
 		tStopMode m_eMode;
 		bool m_bViewer;
 		bool m_bTerminated;
+		bool m_bInFrame;
 
 		unsigned char m_ucState; // 1: Completed, 3: Session created, 7: Transmitters connected
 
+		unsigned int m_uTraceName;
+
 #if 0 // TODO: To add
 		void * m_cStore;
 #endif
@@ -62,4 +62,19 @@
 // Default Step Tolerance
 #define DEFAULT_STEP_TOLERANCE	1e-6
 
+// Default wait policy of the synchronous exchanges (block, spin, spinpause, busypoll)
+#define DEFAULT_WAIT_POLICY		"block"
+
+// Default number of polling iterations before blocking (spin policies)
+#define DEFAULT_SPIN_COUNT		4000
+
+// Default shared memory backend on Linux (sysv, posix)
+#define DEFAULT_SHM_BACKEND		"sysv"
+
+// Default number of records kept by the trace of the data exchanges
+#define DEFAULT_TRACE_SIZE		65536
+
+// Default number of threads connecting the variables of a connector (0: number of cores)
+#define DEFAULT_CONNECT_THREADS	0
+
 #endif // _ISL_CONST_H_
@@ -49,7 +49,9 @@
 namespace isl {
 	class CSHMData;
 	class CSem;
+	class CFutex;
 	class CSHM;
+	class CNotify;
 
 	class ISL_API_EXPORT CData : public CVariable
 	{
@@ -57,21 +59,24 @@ namespace isl {
 		CData(CConnect * cParent, const std::string & sId);
 		~CData();
 
-		void SetFifoDepth(unsigned short usDepth);
-		unsigned short GetFifoDepth();
-		unsigned short GetMaxFifoDepth();
+		void SetFifoDepth(unsigned int uDepth);
+		unsigned int GetFifoDepth();
+		unsigned int GetMaxFifoDepth();
 
 		bool IsFifoFull();
 		bool IsFifoEmpty();
+		bool IsDataReady(double dTime); // GetData at dTime would not wait
+		bool IsTerminated();
 
 		int GetReaders();
-		unsigned char GetIndWriter();
-		unsigned char GetIndReader(int i);
+		unsigned int GetIndWriter();
+		unsigned int GetIndReader(int i);
 
 		int GetMaxReaders();
 
 		bool Initialize(double dTime);
 
+		// The times written shall not decrease, an older value is rejected (except the events)
 		bool SetData(void * pData, double dTime, bool bWait);
 		bool SetData(void * pData, double dTime, double dStep, bool bWait);
 		bool SetLastData(double dTime, double dStep, bool bWait);
@@ -80,6 +85,23 @@ namespace isl {
 		bool GetData(void * pData, double * dOutTime, double dInTime, bool bWait);
 		bool GetDataAndStep(void * pData, double * dTime, double * dStep, bool bWait);
 
+		// Return the number of values written/read (-1 if not connected). With bWait,
+		// SetDataBatch writes all the values and GetDataBatch waits for at least one.
+		int SetDataBatch(void * pData, double * dTimes, double * dSteps, int nCount, bool bWait);
+		int GetDataBatch(void * pData, double * dTimes, double * dSteps, int nCount, bool bWait);
+
+		// Zero-copy accesses: the pointers are in the shared memory and remain valid until
+		// CommitSlot/ReleaseReadSlot. The structures are stored packed, field after field.
+		void * ReserveSlot(bool bWait);
+		bool CommitSlot(double dTime);
+		bool CommitSlot(double dTime, double dStep);
+		const void * AcquireReadSlot(double * dTime, bool bWait);
+		bool ReleaseReadSlot();
+
+		// Used by the connector frames: the values written are published by Commit only
+		void SetDeferred(bool bVal);
+		bool Commit();
+
 		bool SetEventData(void * pData, bool bWait);
 		bool GetEventData(void * pData, bool bWait);
 
@@ -92,6 +114,8 @@ namespace isl {
 
 		int Connect(bool bWait, int nTimeOut = -1);
 		bool Disconnect();
+		// Writer: attaches the notifications of the connectors already reading the variable
+		void AttachNotify();
 
 		bool ConnectAsViewer(bool bWait);
 		bool DisconnectAsViewer();
@@ -105,30 +129,63 @@ namespace isl {
 		double GetOriginalStep();
 		double GetStepTolerance();
 
+		bool IsLockFree();
+		bool IsFutex();
+
+		// Values lost with the drop policies: skipped for this reader or discarded by the writer
+		unsigned int GetOverruns();
+		unsigned int GetDropped();
+
 	protected:
 		void InitOnCheck();
 
+	private:
+		void LockData();
+		void UnlockData();
+
+		bool AcquireListen(CSem * cListen, CFutex * cWake);
+		bool PollListen(CSem * cListen, CFutex * cWake);
+		bool AcquireWriterListen(double dTime = -1.0); // dTime: only used by the trace
+		void ReleaseWriterListen(int n);
+		bool AcquireReaderListen(double dTime = -1.0);
+		void ReleaseReaderListen(int n);
+		void WakeReaders();
+		void NotifyReaders(bool bNotify = true); // bNotify false: only attach the new readers
+		void CloseNotify();
+
 	private:
 		CSem * m_cWriterListen;
 		CSem * m_cReaderListen;
+		CFutex * m_cWriterWake; // Used instead of the semaphores in futex mode
+		CFutex * m_cReaderWake;
+		// Connectors of the readers waiting for several inputs, by reader slot (owned by the connector)
+		std::vector<CNotify *> m_lNotify;
+		std::vector<unsigned int> m_lNotifyGen;
 
 		CSHM * m_cContainer;
 		CSHMData * m_cData;
+		// Kept between two attempts to attach: its lock semaphore may already be the one of the writer
+		CSHM * m_cAttachPending;
+		int m_nManifest; // Entry of the variable in the manifest of the session, -1 if not listed
 
-		unsigned short m_usMaxFifoDepth;
-		unsigned short m_usFifoDepth;
+		unsigned int m_uMaxFifoDepth;
+		unsigned int m_uFifoDepth;
 
 		int m_nMaxNbReaders;
 
 		bool m_bManager;
 		bool m_bIsConnected;
 		bool m_bIsViewer;
+		bool m_bLockFree; // Set by the writer of the shared memory
+		bool m_bFutex;
 
 		double m_dOriginalStep;
 		double m_dStepTolerance;
 
 		double m_dTmpStep; // Used by GetDataAndStep
 
+		unsigned int m_uTraceName;
+
 		// TODO: Implement void * m_cCompute;
 	};
 
@@ -127,7 +127,17 @@ enum {
 	//
 	ISLSIMS_CONNECT_FAILEDTOATTACHSHM,
 	ISLSIMS_CONNECT_FAILEDTOCREATESHM,
-	ISLSIMS_CONNECT_FAILEDTOGETDATA
+	ISLSIMS_CONNECT_FAILEDTOGETDATA,
+	//
+	ISLDATA_WRONG_SHMLAYOUT,
+	ISLDATA_CONNECT_NOREADERSLOT,
+	ISLCONNECT_WAITINPUTS_NOTCONNECTED,
+	ISLCONNECT_NOTIFYHANDLE_FAILED,
+	ISLTRACE_OPEN_FAILED,
+	ISLCONNECT_CREATE_OUTPUTSFAILED,
+	ISLCONNECT_CONNECT_INPUTSFAILED,
+	ISLSIMS_CONNECT_WRONGLAYOUT,
+	ISLSIMS_ADD_NOSLOT
 };
 
 // Warning codes
@@ -170,7 +180,19 @@ enum {
 	ISLCONNECT_REMOVEIO_NOTFOUND,
 	ISLCONNECT_GETIN_NOTCHECKED,
 	ISLCONNECT_GETOUT_NOTCHECKED,
-	ISLCONNECT_CREATE_NOTCHECKED
+	ISLCONNECT_CREATE_NOTCHECKED,
+	ISLCONNECT_CHECK_FUTEXNOTAVAILABLE,
+	ISLCONNECT_CHECK_WRONGWAITPOLICY,
+	//
+	ISLDATA_CONNECT_MODEMISMATCH,
+	ISLSHMDATA_READER_RECLAIMED,
+	ISLDATA_CONNECT_HUGEPAGESNOTUSED,
+	ISLDATA_CONNECT_NUMANOTAPPLIED,
+	ISLCONNECT_PUBLISH_FAILED,
+	ISLCONNECT_SESSIONKEYS_FAILED,
+	ISLCONNECT_MANIFEST_FAILED,
+	ISLDATA_MANIFEST_FULL,
+	ISLSHMDATA_TIME_BACKWARD
 };
 
 // Info codes
@@ -221,7 +243,11 @@ enum {
 	ISLCONNECT_SAVE_SAVED,
 	//
 	ISLSIMS_CONNECT_CONNECTED,
-	ISLSIMS_CONNECT_CREATED
+	ISLSIMS_CONNECT_CREATED,
+	//
+	ISLDATA_CONNECT_PLACEMENT,
+	ISLTRACE_OPENED,
+	ISLCONNECT_BRINGUP_COMPLETED
 };
 
 // Debug codes
@@ -0,0 +1,86 @@
+/*
+ *     Name: isl_keys.h
+ *
+ *     Description: ISL API identifiers of the IPC objects of a session.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+
+#ifndef _ISL_KEYS_H_
+#define _ISL_KEYS_H_
+
+/*
+ *     Header files
+ */
+
+#include <string>
+
+
+/*
+ *     Classes declaration
+ */
+
+namespace isl {
+	class CSHM;
+
+	// Identifiers of the shared memories and semaphores of a session. The first process
+	// asking for a connection id allocates its entry in a table shared by the session:
+	// the objects are then created from the identifiers, without key file nor hash.
+	// The table owns a range of identifiers, found from the session id.
+	class CSessionKeys
+	{
+	public:
+		enum tKey {
+			KEY_SHM = 0, // Shared memory and its lock semaphore
+			KEY_SEM_WRITER,
+			KEY_SEM_READER,
+			KEY_SEM_NOTIFY // Notification of a connector, its entry is named from the connector id
+		};
+
+		CSessionKeys();
+		~CSessionKeys();
+
+		// Created by the first process of the session opening it
+		bool Open(const std::string & sSessionId);
+		void Close();
+
+		// 0 if the connection id cannot be stored (too long, table full):
+		// the objects are then created from their keys
+		unsigned int GetId(const std::string & sConnectId, tKey eKey);
+		unsigned int GetBase();
+
+	private:
+		CSHM * m_cContainer;
+		void * m_pData;
+		unsigned int m_uBase;
+	};
+}
+
+#endif // _ISL_KEYS_H_
@@ -0,0 +1,139 @@
+/*
+ *     Name: isl_manifest.h
+ *
+ *     Description: Manifest of the variables of a session.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+
+#ifndef _ISL_MANIFEST_H_
+#define _ISL_MANIFEST_H_
+
+/*
+ *     Header files
+ */
+
+#include <string>
+
+#include <isl_api_global.h>
+
+
+/*
+ *     Macros and constants definition
+ */
+
+#define MANIFEST_VERSION		2
+#define MANIFEST_CAPACITY		16384
+#define MANIFEST_SESSION_SIZE	128
+#define MANIFEST_CONNECTID_SIZE	128
+
+
+/*
+ *     Types definition
+ */
+
+// Layout of the manifest shared memory: header, then the entries. An entry is
+// read once its state is ready. The entries removed are reused: the low byte of
+// the state is the CManifest::tState, the next bits count the reuses.
+typedef struct structManifestHeader {
+	unsigned int uState; // Written by the first process opening the manifest
+	unsigned int uVersion;
+	unsigned int uEntrySize;
+	unsigned int uCapacity;
+	unsigned int uCount; // Entries appended (may exceed the capacity)
+	unsigned int uRemoved; // Entries removed and not reused yet
+	char sSessionId[MANIFEST_SESSION_SIZE];
+} tsManifestHeader;
+
+typedef struct structManifestEntry {
+	unsigned int uState;
+	unsigned int uType; // CDataType::tType
+	unsigned int uSize; // Number of elements
+	unsigned int uSizeOf; // Size of one element in bytes
+	unsigned int uFifoDepth;
+	unsigned int uMode; // CVariable::tMode
+	unsigned int uWriter; // Unique id of the writer connector
+	unsigned int uSegmentId; // Identifier of the shared memory, 0 if created from its key
+	unsigned int uSegmentSize; // Size of the shared memory in bytes
+	unsigned int uOffset; // Offset of the variable in the shared memory
+	char sConnectId[MANIFEST_CONNECTID_SIZE];
+} tsManifestEntry;
+
+
+/*
+ *     Classes declaration
+ */
+
+namespace isl {
+	class CSHM;
+
+	// Variables written in a session: each writer appends the description of its
+	// variables when their shared memory is created, and removes it when done.
+	// The viewers and the tools enumerate the session without probing the names.
+	class ISL_API_EXPORT CManifest
+	{
+	public:
+		enum tState {
+			ME_EMPTY = 0, // Appended but not written yet
+			ME_READY,
+			ME_REMOVED
+		};
+
+		CManifest();
+		~CManifest();
+
+		// Created by the first process of the session opening it if bCreate is true
+		bool Open(const std::string & sSessionId, bool bCreate = true);
+		void Close();
+		bool IsOpen();
+
+		// Return the index of the entry, -1 if the manifest is full or not open,
+		// or if the connection id is too long. A removed entry is used first.
+		int Append(const tsManifestEntry & stEntry);
+		void Remove(int nIndex);
+
+		// Number of entries used at least once, including the ones removed
+		int GetCount();
+		// False if the entry is not written yet. The state tells if it is removed.
+		bool GetEntry(int nIndex, tsManifestEntry & stEntry);
+
+	private:
+		// Claims a removed entry
+		bool Reuse(unsigned int & uIndex, unsigned int & uReuse);
+
+	private:
+		CSHM * m_cContainer;
+		tsManifestHeader * m_pHeader;
+		tsManifestEntry * m_pEntries;
+		unsigned int m_uNextReuse; // Where the last removed entry was found
+	};
+}
+
+#endif // _ISL_MANIFEST_H_
@@ -0,0 +1,132 @@
+/*
+ *     Name: isl_notify.h
+ *
+ *     Description: ISL API inputs notification class.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+
+#ifndef _ISL_NOTIFY_H_
+#define _ISL_NOTIFY_H_
+
+/*
+ *     Header files
+ */
+
+#include <string>
+
+
+/*
+ *     Classes declaration
+ */
+
+namespace isl {
+	class CSHM;
+	class CSHMConnect;
+	class CSem;
+	class CFutex;
+	class CSessionKeys;
+
+	// Notification of a connector: the writers of its inputs release it when they
+	// publish a value, so that the connector waits for several inputs at once.
+	class CNotify
+	{
+	public:
+		CNotify();
+		~CNotify();
+
+		// The connector uses its own shared memory, the writers attach it.
+		// The semaphore is created from the identifiers of the session when cKeys is given.
+		bool Open(CSHMConnect * cData, const std::string & sSessionId, unsigned int uId,
+			CSessionKeys * cKeys);
+		bool Attach(const std::string & sSessionId, unsigned int uId, CSessionKeys * cKeys);
+		void Close();
+
+		unsigned int GetId();
+
+		// Connector side: register, check the inputs, then wait or cancel
+		void Listen();
+		void CancelListen();
+		bool Wait(int nTimeout); // milliseconds, no timeout if negative
+		bool IsTimeout();
+
+		// Connector side: handle readable when a value is published (named pipe, Linux only).
+		// ResetHandle is called before reading the inputs.
+		int OpenHandle();
+		void ResetHandle();
+
+		// Writer side
+		void Notify();
+
+	private:
+		bool OpenWake(const std::string & sSessionId, unsigned int uId, CSessionKeys * cKeys);
+		void CloseHandle();
+
+	private:
+		CSHM * m_cContainer; // Set when attached by a writer
+		CSHMConnect * m_cData;
+		CSem * m_cListen;
+		CFutex * m_cWake; // Used instead of the semaphore in futex mode
+		unsigned int m_uId;
+		bool m_bTimeout;
+
+		std::string m_sHandle; // Path of the named pipe
+		int m_nHandle; // Both ends are opened: no hang-up nor broken pipe when one side ends
+		bool m_bOwner;
+	};
+
+	// Publication of the variables of a session: the writers signal each shared memory
+	// they create, so that the readers waiting for it attach at once.
+	class CPublish
+	{
+	public:
+		CPublish();
+		~CPublish();
+
+		// Created by the first process of the session opening it
+		bool Open(const std::string & sSessionId);
+		void Close();
+
+		// Reader side: read the generation, try to attach, then wait for a new publication
+		unsigned int GetGeneration();
+		bool Wait(unsigned int uGeneration, int nTimeout); // milliseconds
+
+		// Writer side
+		void Publish();
+
+	private:
+		CSHM * m_cContainer;
+		unsigned int * m_pData;
+		CSem * m_cListen;
+		CFutex * m_cWake; // Used instead of the semaphore on Linux
+	};
+}
+
+#endif // _ISL_NOTIFY_H_
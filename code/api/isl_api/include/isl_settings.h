@@ -41,6 +41,7 @@
 
 #include <string>
 #include <map>
+#include <boost/shared_ptr.hpp>
 
 
 /*
@@ -48,8 +49,10 @@
  */
 
 namespace isl {
-	class CINI;
+	class CSettingsSnapshot;
 
+	// The file isl_api.ini is loaded once per process: the objects share a read-only
+	// snapshot of its values and are cheap to create.
 	class ISL_API_EXPORT CAppSettings
 	{
 	public:
@@ -66,6 +69,19 @@ namespace isl {
 			AS_CMN_STEPTOLERANCE,
 			AS_CMN_ISLCOMPATIBLE,
 			AS_CMN_ISGLOBALIPC,
+			AS_CMN_LOCKFREEFIFO,
+			AS_CMN_FUTEX,
+			AS_CMN_WAITPOLICY,
+			AS_CMN_SPINCOUNT,
+			AS_CMN_SHMBACKEND,
+			AS_CMN_SHMHUGEPAGES,
+			AS_CMN_ASYNCLOG,
+			AS_CMN_ASYNCLOGSIZE,
+			AS_CMN_TRACE,
+			AS_CMN_TRACESIZE,
+			AS_CMN_TRACEPATH,
+			AS_CMN_CONNECTTHREADS,
+			AS_CMN_SESSIONKEYS,
 			AS_KEY_UNKNOWN = 500
 		} tKey;
 
@@ -74,6 +90,9 @@ namespace isl {
 		CAppSettings();
 		~CAppSettings();
 
+		// Loads the file again: the objects created afterwards use the new values
+		static bool Reload();
+
 		bool GetBoolValue(tGroup eGroup, tKey eKey, bool bDefault = false);
 		int GetIntValue(tGroup eGroup, tKey eKey, int nDefault = 0);
 		double GetDoubleValue(tGroup eGroup, tKey eKey, double dDefault = 0.0);
@@ -82,20 +101,40 @@ namespace isl {
 
 		// Get values of known parameters
 		unsigned int GetMaxSHMStringSize();
-		unsigned short GetMaxFIFODepth();
+		unsigned int GetMaxFIFODepth();
 		int GetMaxNbReaders();
 		int GetMaxNbRunSims();
 		double GetStepTolerance();
 		bool IsISLCompatible();
 		bool IsGlobalIPC();
+		bool IsLockFreeFIFO();
+		bool IsFutex();
+		std::string GetWaitPolicy();
+		int GetSpinCount();
+		std::string GetSHMBackend();
+		bool IsSHMHugePages();
+		bool IsAsyncLog();
+		unsigned int GetAsyncLogSize();
+		bool IsTrace();
+		unsigned int GetTraceSize();
+		std::string GetTracePath();
+		unsigned int GetConnectThreads();
+		bool IsSessionKeys();
 
 	protected:
+		// Groups and keys added by the derived classes
 		std::map<unsigned int, std::string> m_mGroupNames;
 		std::map<unsigned int, std::string> m_mKeyNames;
 
 	private:
-		CINI * m_cProperties;
-		bool m_bLoaded;
+		CAppSettings(const boost::shared_ptr<const CSettingsSnapshot> & cSnapshot);
+
+		static boost::shared_ptr<const CSettingsSnapshot> Load();
+
+		bool GetNames(tGroup eGroup, tKey eKey, std::string & sGroup, std::string & sKey);
+
+	private:
+		boost::shared_ptr<const CSettingsSnapshot> m_cSnapshot;
 	};
 }
 
@@ -80,6 +80,17 @@ namespace isl {
 
 		int GetNbData();
 
+		// Notification of the inputs: the writers release the connector waiting in WaitInputs
+		bool IsNotifyFutex();
+		unsigned int * GetNotifyWake();
+		void AddNotifyListen();
+		void CancelNotifyListen();
+		int ResetNotifyListen();
+		bool IsNotifyHandle();
+		void SetNotifyHandle(bool bVal);
+		bool SetNotifyPending(); // False if already pending
+		void ResetNotifyPending();
+
 	private:
 		unsigned int * m_uType; // Compatibility with the enum type of ISL
 
@@ -97,6 +108,12 @@ namespace isl {
 
 		int * m_nNbData;
 
+		int * m_nNotifyListen; // On its own cache line
+		unsigned int * m_uNotifyWake; // Futex word
+		bool * m_bNotifyFutex;
+		int * m_nNotifyHandle; // The connector polls a handle
+		unsigned int * m_uNotifyPending; // The handle is already readable
+
 		CConnect * m_cParent;
 	};
 }
@@ -54,6 +54,7 @@ namespace isl {
 	{
 	public:
 		static int GetSizeOf(CData * cData);
+		static unsigned int GetCapacity(unsigned int uDepth);
 
 		CSHMData(void * pData, CData * cData);
 		~CSHMData();
@@ -68,13 +69,17 @@ namespace isl {
 		int GetSizeType();
 		int GetSize();
 
-		unsigned short GetFifoDepth();
-		unsigned short GetIndWriter();
-		unsigned short GetIndReader(int i);
+		unsigned int GetFifoDepth();
+		unsigned int GetIndWriter(); // Slot positions
+		unsigned int GetIndReader(int i);
 
-		void SetReader();
+		bool SetReader(unsigned int uNotify); // uNotify: id of the connector notified, 0 if none
+		void ReleaseReader();
 		bool IsReader();
-		int GetReaders();
+		int GetReaders(); // Connected readers
+		int ReclaimReaders(); // Slots of the readers which process ended
+		int GetReaderSlots();
+		unsigned int GetReaderNotify(int i, unsigned int * uGeneration); // 0 if the slot is free
 
 		int GetReaderListen();
 		void SetReaderListen(int nVal);
@@ -82,29 +87,93 @@ namespace isl {
 		int GetWriterListen();
 		void SetWriterListen(int nVal);
 
+		int ResetReaderListen();
+		int ResetWriterListen();
+
 		void SetTerminated();
 		bool IsTerminated();
 
+		bool IsInitialized();
+		bool IsCompatible();
+
+		bool IsLockFree();
+
+		bool IsFutex();
+		bool IsLatest();
+		CVariable::tBackPressure GetBackPressure();
+		unsigned int GetOverruns(); // Values of the reader skipped by the writer
+		unsigned int GetDropped(); // Values discarded by the writer
+		unsigned int * GetWriterWake();
+		unsigned int * GetReaderWake();
+
 		bool IsFifoFullForReader();
 		bool IsFifoFull();
 		bool IsFifoEmpty();
+		bool IsDataReady(double dInTime); // GetData would not wait for the value at dInTime
 
 		bool SetData(void * pData, double dTime, bool * bListen);
 		bool SetData(void * pData, double dTime, double dStep, bool * bListen);
 		bool SetLastData(double dTime, double dStep, bool * bListen);
+		int SetDataBatch(void * pData, double * dTimes, double * dSteps, int nCount, bool * bListen);
+		void * ReserveSlot(bool * bListen);
+		bool CommitSlot(double dTime, double dStep);
 
 		bool GetData(void * pData, double * dTime, double * dStep, bool * bListen);
 		bool GetData(void * pData, double * dOutTime, double * dOutStep, double dInTime, bool * bListen);
+		int GetDataBatch(void * pData, double * dTimes, double * dSteps, int nCount, bool * bListen);
+		void * AcquireReadSlot(double * dTime, double * dStep, bool * bListen);
+		bool ReleaseReadSlot();
 
 		bool SetData(void * pData, double dTime, int nInd);
 		bool GetData(void * pData, double * dTime, int nInd);
 
 		bool GetMemData(void * pData, double * dTime, double * dStep, int nInd);
 
+		// Deferred mode: the values are written but published by Commit only
+		void SetDeferred(bool bVal);
+		bool IsDeferred();
+		bool Commit();
+
 	private:
+		int Map(CData * cData, char * pBase);
+		unsigned int * IndRead(int i);
+		unsigned int * Overruns(int i);
+		unsigned int * Owner(int i);
+		unsigned int * Generation(int i);
+		unsigned int * Notify(int i);
+		bool IsActiveReader(int i, int nReaders);
+
+		bool IsFifoEmpty(unsigned int uRead);
+		unsigned int GetFreeSlots();
+		bool AcquireRoom(bool * bListen, bool * bDropped);
+		void DropOldest(unsigned int uCount);
+		bool MoveReadInd(unsigned int uRead, unsigned int uNewRead);
+		unsigned int GetWriteInd();
+		void Publish(unsigned int uWrite);
+		// Latest mode: the newest slot is copied then validated against the write index
+		bool GetLatest(void * pData, double * dTime, double * dStep, bool * bListen);
+		bool GetLatest(void * pData, double * dOutTime, double * dOutStep, double dInTime, bool * bListen);
+		bool ReadLatest(void * pData, double * dTime, double * dStep, unsigned int * uWrite);
+		void CancelReaderListen();
+		bool FindData(void * pData, double * dOutTime, double * dOutStep, double dInTime,
+			bool * bWait, unsigned int * uRead);
+		bool IsSuperseded(unsigned int uInd, double dInTime);
+		bool IsValidAt(int nInd, double dLimit);
+		unsigned int SkipData(unsigned int uInd, double dInTime);
+		int SearchHistory(unsigned int uLast, unsigned int uCount, double dLimit);
+		bool IsTimeOrdered(double dTime, const double * dPrevious = NULL);
+
+		void BeginWrite();
+		void EndWrite();
+		unsigned int BeginRead();
+		bool EndRead(unsigned int uSeq);
+
 		bool MemCopy(void * pDst, void * pSrc, size_t nSize, bool bToSHM);
 
 	private:
+		unsigned int * m_uMagic;
+		unsigned int * m_uVersion;
+		int * m_nLayoutSize;
 		unsigned int * m_uId;
 
 		int * m_nSizeName;
@@ -116,22 +185,38 @@ namespace isl {
 		int * m_nSize;
 		//std::vector<size_t> m_lSizes;
 
-		unsigned short * m_usIndWrite;
-		int * m_nReaders;
-		unsigned short * m_usIndReads;
+		unsigned int * m_uWriteSeq; // Odd while the writer updates a slot
+		unsigned int * m_uIndWrite; // Monotonic counters, the slot is given by the mask
+		unsigned int * m_uDropped;
+		int * m_nReaders; // Slots used at least once
+		unsigned int * m_uIndReads; // One cache line per reader
 
 		int * m_nReaderListen;
 		int * m_nWriterListen;
+		unsigned int * m_uReaderWake; // Futex words
+		unsigned int * m_uWriterWake;
 
 		bool * m_bIsTerminated;
+		bool * m_bLockFree;
+		bool * m_bFutex;
+		bool * m_bLatest; // Single value channel, the writer never waits
+		int * m_nBackPressure;
 
-		unsigned short * m_usFifoDepth;
+		unsigned int * m_uFifoDepth;
+		unsigned int * m_uFifoMask; // Number of slots - 1 (power of 2)
 		double * m_dTimes;
 		double * m_dSteps;
 		void * m_pData;
 
 		CData * m_cParent;
 		int m_nReaderInd;
+		unsigned int m_uGeneration; // Of the reader slot, changed on each registration
+		unsigned int m_uOverrunBase;
+		bool m_bDeferred;
+		unsigned int m_uPending; // Values written but not yet published
+		bool m_bReserved; // Slot handed out by ReserveSlot
+		bool m_bAcquired; // Slot handed out by AcquireReadSlot
+		bool m_bTimeWarned; // A time going backward was already reported
 
 		double m_dOriginalStep;
 		double m_dStepTolerance;
@@ -50,8 +50,8 @@
  */
 
 namespace isl {
-	class CSHMConnect;
 	class CSHM;
+	struct tsSimsRegistry;
 
 	class ISL_API_EXPORT CSimulations
 	{
@@ -89,17 +89,27 @@ namespace isl {
 		void * Add();
 		bool Remove(void * pASimData);
 		bool Get(int nInd);
+		// Indexes of the simulations of a session, to be used with Get()
+		std::vector<int> Find(const std::string & sSessionId);
 
 	private:
 		bool Connect();
 		bool Disconnect();
-		bool Initialize();
+		void * GetChunk(int nChunk, bool bCreate);
+		int Allocate(unsigned int uNbChunks);
+		void Release(int nSlot);
+		int GetSlot(void * pASimData);
+		bool ReadSlot(int nSlot, unsigned int & uId, unsigned long & ulPID,
+			std::string & sName, std::string & sSessionId);
+		void AddToIndex(const std::string & sSessionId, int nSlot);
+		void RemoveFromIndex(const std::string & sSessionId, int nSlot);
+		void ClearIndex(unsigned int uPos, unsigned long long ulEntry);
 
 	private:
 		static CSimulations * m_cInstance;
 
 		unsigned int m_uMaxStrSize;
-		int m_nMaxNbSims;
+		int m_nMaxNbSims;		// Number of simulations of a chunk
 
 		int m_nSizeId;			// ISL id of a model
 		int m_nSizePID;			// PID of a model
@@ -119,8 +129,11 @@ namespace isl {
 		std::string m_sAFile;
 		std::string m_sASessionId;
 
-		CSHM * m_cContainer;
-		CSHMConnect * m_cData;
+		// Layout of the chunks, allocation of the slots and index of the sessions
+		CSHM * m_cRegistry;
+		tsSimsRegistry * m_pRegistry;
+		// The first chunk is the list of simulations of the previous versions
+		std::vector<CSHM *> m_lChunks;
 
 	public:
 		static CSimulations * Instance();
@@ -0,0 +1,160 @@
+/*
+ *     Name: isl_trace.h
+ *
+ *     Description: Binary trace of the data exchanges.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+#ifndef _ISL_TRACE_H_
+#define _ISL_TRACE_H_
+
+/*
+ *     Header files
+ */
+
+#include <string>
+
+#include <isl_api_global.h>
+
+
+/*
+ *     Macros and constants definition
+ */
+
+#define TRACE_MAGIC			"ISLTRACE"
+#define TRACE_VERSION		1
+#define TRACE_HEADER_SIZE	128
+#define TRACE_MAX_NAMES		1024
+#define TRACE_NAME_SIZE		64
+#define TRACE_FILE_EXT		"trc"
+
+
+/*
+ *     Types definition
+ */
+
+// Layout of a trace file: header, names table (TRACE_MAX_NAMES x TRACE_NAME_SIZE),
+// then the ring of records. The name 0 is reserved (no name).
+typedef struct structTraceHeader {
+	char sMagic[8];
+	unsigned int uVersion;
+	unsigned int uRecordSize;
+	unsigned int uCapacity; // Number of records (power of 2)
+	unsigned int uNbNames;
+	unsigned long long ulPID;
+	unsigned long long ulWallTime; // Time of creation since the epoch (us)
+	unsigned long long ulWrite; // Number of records written since the creation
+	char sPad[TRACE_HEADER_SIZE - 48];
+} tsTraceHeader;
+
+typedef struct structTraceRecord {
+	unsigned long long ulTime; // Steady clock since the creation (ns)
+	double dSimTime; // Simulation time (-1 if unknown)
+	unsigned int uName;
+	unsigned short usEvent;
+	unsigned short usThread;
+	unsigned int uArg;
+	unsigned int uSeq; // Low bits of the record index + 1, written last
+} tsTraceRecord;
+
+
+/*
+ *     Classes declaration
+ */
+
+namespace isl {
+	// Per process trace of the data exchanges, written in a memory mapped file:
+	// the records remain available after a crash. The ring keeps the last records.
+	class ISL_API_EXPORT CTrace
+	{
+	public:
+		enum tEvent {
+			TE_NONE = 0,
+			TE_SET_ENTER,
+			TE_SET_EXIT,
+			TE_GET_ENTER,
+			TE_GET_EXIT,
+			TE_WAIT_BEGIN, // uArg: 0 for a writer (FIFO full), 1 for a reader (FIFO empty)
+			TE_WAIT_END,
+			TE_WAKEUP, // uArg: number of threads released
+			TE_FRAME_BEGIN,
+			TE_FRAME_END,
+			TE_STEP // Step boundary given by the connector
+		};
+
+		// The file isl_trace_<pid>.trc is created in sPath (temporary directory if empty)
+		static bool Open(const std::string & sPath, unsigned int uSize);
+		static bool IsEnabled() { return m_pHeader != 0; }
+		static std::string GetFile();
+
+		// Return the identifier used by the records (0 if the trace is disabled)
+		static unsigned int RegisterName(const std::string & sName);
+
+		static void Record(tEvent eEvent, unsigned int uName, double dSimTime, unsigned int uArg = 0);
+
+	private:
+		static tsTraceHeader * m_pHeader;
+		static tsTraceRecord * m_pRecords;
+		static char * m_pNames;
+	};
+
+	// Records the enter and exit events of a call
+	class CTraceScope
+	{
+	public:
+		CTraceScope(CTrace::tEvent eEnter, unsigned int uName, double dSimTime, unsigned int uArg = 0) {
+			m_bEnabled = CTrace::IsEnabled();
+			m_eEnter = eEnter;
+			m_uName = uName;
+			m_dSimTime = dSimTime;
+			m_uArg = uArg;
+			if (m_bEnabled) {
+				CTrace::Record(eEnter, uName, dSimTime, uArg);
+			}
+		}
+
+		~CTraceScope() {
+			if (m_bEnabled) {
+				CTrace::Record((CTrace::tEvent)(m_eEnter + 1), m_uName, m_dSimTime, m_uArg);
+			}
+		}
+
+		void SetSimTime(double dSimTime) { m_dSimTime = dSimTime; }
+
+	private:
+		bool m_bEnabled;
+		CTrace::tEvent m_eEnter;
+		unsigned int m_uName;
+		double m_dSimTime;
+		unsigned int m_uArg;
+	};
+}
+
+#endif // _ISL_TRACE_H_
@@ -61,6 +61,9 @@ namespace isl {
 		static void Debug(unsigned int uLevel, unsigned int uId, const char * sFormat, ...);
 
 		static void CloseLog();
+		// Asynchronous log (AsyncLog setting): writes the queued messages
+		static void FlushLog();
+		static unsigned int GetLogDropped();
 	};
 }
 
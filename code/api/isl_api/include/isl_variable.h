@@ -127,6 +127,35 @@ namespace isl {
 			CS_UNKNOWN
 		};
 
+		// Waiting strategy of the synchronous exchanges (FIFO full or empty)
+		enum tWaitPolicy {
+			WP_BLOCK,		// Sleeps on the semaphore (or futex) straight away
+			WP_SPIN,		// Polls a number of times, then sleeps
+			WP_SPINPAUSE,	// Polls with a CPU pause hint, then sleeps
+			WP_BUSYPOLL,	// Polls with a CPU pause hint, never sleeps
+			WP_DEFAULT		// Policy of the connector
+		};
+
+		// Exchange semantics of the values
+		enum tMode {
+			MD_FIFO,		// Every value is read, the writer waits for the slowest reader
+			MD_LATEST		// Only the newest value is read, the writer never waits
+		};
+
+		// Behavior of the writer when the FIFO is full for a reader (FIFO mode)
+		enum tBackPressure {
+			BP_BLOCK,		// The writer waits for the slowest reader
+			BP_DROPOLDEST,	// The lagging readers lose their oldest values
+			BP_DROPNEWEST	// The new values are discarded
+		};
+
+		// Placement of the shared memory on the NUMA nodes (Linux only)
+		enum tNumaPolicy {
+			NP_DEFAULT,		// Node of the first process touching the memory
+			NP_BIND,		// Node given
+			NP_INTERLEAVE	// Spread over the online nodes
+		};
+
 		enum tState {
 			ST_NOT_DEFINED,
 			ST_PARTIALLY_DEFINED,
@@ -162,6 +191,36 @@ namespace isl {
 		bool IsStoreUsed();
 		void SetSyncTimeout(int nTimeout); // Set in seconds
 		int GetSyncTimeout();
+		void SetWaitPolicy(const std::string & sVal);
+		void SetWaitPolicy(tWaitPolicy eWaitPolicy);
+		tWaitPolicy GetWaitPolicy();
+		std::string GetWaitPolicyAsStr();
+		void SetSpinCount(int nCount);
+		int GetSpinCount();
+
+		void SetMode(const std::string & sVal);
+		void SetMode(tMode eMode);
+		tMode GetMode();
+		std::string GetModeAsStr();
+		void SetBackPressure(const std::string & sVal);
+		void SetBackPressure(tBackPressure eBackPressure);
+		tBackPressure GetBackPressure();
+		std::string GetBackPressureAsStr();
+		// Memory placement, applied by the writer when it creates the shared memory
+		void UseHugePages(bool bUse);
+		bool IsHugePagesUsed();
+		void SetNumaPolicy(const std::string & sVal); // Node number or interleave
+		void SetNumaPolicy(tNumaPolicy ePolicy, int nNode = 0);
+		tNumaPolicy GetNumaPolicy();
+		int GetNumaNode();
+		std::string GetNumaPolicyAsStr();
+
+		static tWaitPolicy GetWaitPolicyFromStr(const std::string & sVal);
+		static std::string GetWaitPolicyStr(tWaitPolicy eWaitPolicy);
+		static tMode GetModeFromStr(const std::string & sVal);
+		static std::string GetModeStr(tMode eMode);
+		static tBackPressure GetBackPressureFromStr(const std::string & sVal);
+		static std::string GetBackPressureStr(tBackPressure eBackPressure);
 
 		bool IsChecked();
 		bool Check();
@@ -185,6 +244,13 @@ namespace isl {
 		double m_dStepSize;
 		bool m_bStore;
 		int m_nSyncTimeout; // Used by semaphores (in milliseconds)
+		tWaitPolicy m_eWaitPolicy;
+		int m_nSpinCount; // <0 means the value of the connector is used
+		tMode m_eMode;
+		tBackPressure m_eBackPressure; // Defined by the writer
+		bool m_bHugePages; // Defined by the writer
+		tNumaPolicy m_eNumaPolicy; // Defined by the writer
+		int m_nNumaNode;
 
 		// TODO: Implement CComputeSettings (map of settings)
 	};
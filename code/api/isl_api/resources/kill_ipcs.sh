@@ -2,8 +2,8 @@
 
 ME=`whoami`
 
-IPCS_S=`ipcs -s | egrep "0x49[0-9a-f]+ [0-9]+" | grep $ME | cut -f2 -d" "`
-IPCS_M=`ipcs -m | egrep "0x49[0-9a-f]+ [0-9]+" | grep $ME | cut -f2 -d" "`
+IPCS_S=`ipcs -s | egrep "0x4[9a][0-9a-f]+ [0-9]+" | grep $ME | cut -f2 -d" "`
+IPCS_M=`ipcs -m | egrep "0x4[9a][0-9a-f]+ [0-9]+" | grep $ME | cut -f2 -d" "`
 
 for id in $IPCS_M; do
   echo "Removing shm $id"
@@ -15,5 +15,12 @@ for id in $IPCS_S; do
   ipcrm -s $id
 done
 
+for f in /dev/shm/isl_sysshm_* /dev/hugepages/isl_sysshm_*; do
+  if [ -O "$f" ]; then
+    echo "Removing posix shm $f"
+    rm -f "$f"
+  fi
+done
+
 echo "IPC listing"
 ipcs
@@ -77,6 +77,14 @@ EXTERN ISL_API_EXPORT const char * ISL_GetVersionNumber()
 	return ISL_AllocateAndCopy("ISL_GetVersionNumber", isl::CConnect::GetVersionNumber());
 }
 
+EXTERN ISL_API_EXPORT int ISL_ReloadSettings()
+{
+	if (isl::CAppSettings::Reload() == false) {
+		return -2;
+	}
+	return 0;
+}
+
 EXTERN ISL_API_EXPORT const char * ISL_GetLogFile()
 {
 	return ISL_AllocateAndCopy("ISL_GetLogFile", isl::CUtils::GetLogFile());
@@ -123,6 +131,9 @@ EXTERN ISL_API_EXPORT void ISL_LogInfo(unsigned int uId, const char * sFormat, .
 
 EXTERN ISL_API_EXPORT void ISL_LogDebug(unsigned int uLevel, unsigned int uId, const char * sFormat, ...)
 {
+	if (isl::CMsgLogger::IsDebugEnabled(uLevel) == false) {
+		return;
+	}
 	va_list lArgs;
 	va_start(lArgs, sFormat);
 	size_t len = std::vsnprintf(NULL, 0, sFormat, lArgs);
@@ -134,6 +145,16 @@ EXTERN ISL_API_EXPORT void ISL_LogDebug(unsigned int uLevel, unsigned int uId, c
 	AppLogDebug(uLevel, uId, &sVec[0]);
 }
 
+EXTERN ISL_API_EXPORT void ISL_FlushLog()
+{
+	isl::CUtils::FlushLog();
+}
+
+EXTERN ISL_API_EXPORT unsigned int ISL_GetLogDropped()
+{
+	return isl::CUtils::GetLogDropped();
+}
+
 EXTERN ISL_API_EXPORT int ISL_StartThreadListenToStop(void * pConnect)
 {
 	if (pConnect == 0) {
@@ -464,6 +485,110 @@ EXTERN ISL_API_EXPORT double ISL_ConnectGetStepTolerance(void * pConnect)
 	return cConnect->GetStepTolerance();
 }
 
+EXTERN ISL_API_EXPORT int ISL_ConnectSetLockFree(void * pConnect, int nVal)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	cConnect->SetLockFree(nVal != 0);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectIsLockFree(void * pConnect)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	if (cConnect->IsLockFree()) {
+		return 1;
+	}
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectSetFutex(void * pConnect, int nVal)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	cConnect->SetFutex(nVal != 0);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectIsFutex(void * pConnect)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	if (cConnect->IsFutex()) {
+		return 1;
+	}
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectSetWaitPolicy(void * pConnect, int nPolicy)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	if ((nPolicy < isl::CVariable::WP_BLOCK) || (nPolicy > isl::CVariable::WP_BUSYPOLL)) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	cConnect->SetWaitPolicy((isl::CVariable::tWaitPolicy)nPolicy);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectGetWaitPolicy(void * pConnect)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	return cConnect->GetWaitPolicy();
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectSetSpinCount(void * pConnect, int nCount)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	cConnect->SetSpinCount(nCount);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectGetSpinCount(void * pConnect)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	return cConnect->GetSpinCount();
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectSetConnectThreads(void * pConnect, int nNbThreads)
+{
+	if ((pConnect == 0) || (nNbThreads < 0)) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	cConnect->SetConnectThreads((unsigned int)nNbThreads);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectGetConnectThreads(void * pConnect)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	return (int)cConnect->GetConnectThreads();
+}
+
 EXTERN ISL_API_EXPORT void * ISL_ConnectNewIO(void * pConnect, const char * sId, int nCausality, int nType, int nSize)
 {
 	if (pConnect == 0) {
@@ -710,6 +835,99 @@ EXTERN ISL_API_EXPORT int ISL_ConnectDisconnect(void * pConnect)
 	return -2;
 }
 
+EXTERN ISL_API_EXPORT int ISL_ConnectBeginFrame(void * pConnect)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	if (cConnect->BeginFrame()) {
+		return 0;
+	}
+	return -2;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectCommitFrame(void * pConnect, int nKeepOpen)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	if (cConnect->CommitFrame(nKeepOpen != 0)) {
+		return 0;
+	}
+	return -2;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectWaitInputs(void * pConnect, double dTime, int nTimeout, int nAny,
+	const unsigned char * pSelected, unsigned char * pReady)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	int nInputs = cConnect->GetNbInputs();
+	std::vector<bool> lSelected;
+	if (pSelected != 0) {
+		lSelected.resize(nInputs);
+		for (int i = 0; i < nInputs; i++) {
+			lSelected[i] = ((pSelected[i / 8] >> (i % 8)) & 1) != 0;
+		}
+	}
+	std::vector<bool> lReady;
+	int nReady = cConnect->WaitInputs(dTime, nTimeout, &lReady, nAny != 0,
+		(pSelected != 0 ? &lSelected : 0));
+	if (nReady < 0) {
+		return -2;
+	}
+	if (pReady != 0) {
+		for (int i = 0; i < nInputs; i++) {
+			if (lReady[i]) {
+				pReady[i / 8] |= (unsigned char)(1 << (i % 8));
+			}
+			else {
+				pReady[i / 8] &= (unsigned char)~(1 << (i % 8));
+			}
+		}
+	}
+	return nReady;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectGetNotifyHandle(void * pConnect)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	int nHandle = cConnect->GetNotifyHandle();
+	if (nHandle < 0) {
+		return -2;
+	}
+	return nHandle;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectResetNotifyHandle(void * pConnect)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	if (cConnect->ResetNotifyHandle()) {
+		return 0;
+	}
+	return -2;
+}
+
+EXTERN ISL_API_EXPORT int ISL_ConnectTraceStep(void * pConnect, double dTime)
+{
+	if (pConnect == 0) {
+		return -1;
+	}
+	isl::CConnect * cConnect = (isl::CConnect *)pConnect;
+	cConnect->TraceStep(dTime);
+	return 0;
+}
+
 EXTERN ISL_API_EXPORT int ISL_ConnectListenToExitSession(void * pConnect)
 {
 	if (pConnect == 0) {
@@ -973,6 +1191,146 @@ EXTERN ISL_API_EXPORT int ISL_IOGetSyncTimeout(void * pData)
 	return cData->GetSyncTimeout();
 }
 
+EXTERN ISL_API_EXPORT int ISL_IOSetWaitPolicy(void * pData, int nPolicy)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	if ((nPolicy < isl::CVariable::WP_BLOCK) || (nPolicy > isl::CVariable::WP_DEFAULT)) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	cData->SetWaitPolicy((isl::CVariable::tWaitPolicy)nPolicy);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOGetWaitPolicy(void * pData)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	return cData->GetWaitPolicy();
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOSetMode(void * pData, int nMode)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	if ((nMode < isl::CVariable::MD_FIFO) || (nMode > isl::CVariable::MD_LATEST)) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	cData->SetMode((isl::CVariable::tMode)nMode);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOGetMode(void * pData)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	return cData->GetMode();
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOSetBackPressure(void * pData, int nPolicy)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	if ((nPolicy < isl::CVariable::BP_BLOCK) || (nPolicy > isl::CVariable::BP_DROPNEWEST)) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	cData->SetBackPressure((isl::CVariable::tBackPressure)nPolicy);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOGetBackPressure(void * pData)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	return cData->GetBackPressure();
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOGetOverruns(void * pData, unsigned int * uCount)
+{
+	if ((pData == 0) || (uCount == 0)) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	*uCount = cData->GetOverruns();
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOGetDropped(void * pData, unsigned int * uCount)
+{
+	if ((pData == 0) || (uCount == 0)) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	*uCount = cData->GetDropped();
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOUseHugePages(void * pData, int nUse)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	cData->UseHugePages(nUse != 0);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOSetNumaPolicy(void * pData, int nPolicy, int nNode)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	if ((nPolicy < isl::CVariable::NP_DEFAULT) || (nPolicy > isl::CVariable::NP_INTERLEAVE)) {
+		return -1;
+	}
+	if ((nPolicy == isl::CVariable::NP_BIND) && (nNode < 0)) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	cData->SetNumaPolicy((isl::CVariable::tNumaPolicy)nPolicy, nNode);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOGetNumaPolicy(void * pData)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	return cData->GetNumaPolicy();
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOSetSpinCount(void * pData, int nCount)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	cData->SetSpinCount(nCount);
+	return 0;
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOGetSpinCount(void * pData)
+{
+	if (pData == 0) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	return cData->GetSpinCount();
+}
+
 EXTERN ISL_API_EXPORT int ISL_IOSetData(void * pData, void * pVal, double dTime, int nWait)
 {
 	if (pData == NULL) {
@@ -1021,6 +1379,74 @@ EXTERN ISL_API_EXPORT int ISL_IOGetData(void * pData, void * pVal, double * dOut
 	return -2;
 }
 
+EXTERN ISL_API_EXPORT int ISL_IOSetDataBatch(void * pData, void * pVals, double * dTimes, double * dSteps, int nCount, int nWait)
+{
+	if (pData == NULL) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	int nRet = cData->SetDataBatch(pVals, dTimes, dSteps, nCount, nWait != 0);
+	if (nRet < 0) {
+		return -2;
+	}
+	return nRet;
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOGetDataBatch(void * pData, void * pVals, double * dTimes, double * dSteps, int nCount, int nWait)
+{
+	if (pData == NULL) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	int nRet = cData->GetDataBatch(pVals, dTimes, dSteps, nCount, nWait != 0);
+	if (nRet < 0) {
+		return -2;
+	}
+	return nRet;
+}
+
+EXTERN ISL_API_EXPORT void * ISL_IOReserveSlot(void * pData, int nWait)
+{
+	if (pData == NULL) {
+		return NULL;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	return cData->ReserveSlot(nWait != 0);
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOCommitSlot(void * pData, double dTime)
+{
+	if (pData == NULL) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	if (cData->CommitSlot(dTime)) {
+		return 0;
+	}
+	return -2;
+}
+
+EXTERN ISL_API_EXPORT const void * ISL_IOAcquireReadSlot(void * pData, double * dTime, int nWait)
+{
+	if (pData == NULL) {
+		return NULL;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	return cData->AcquireReadSlot(dTime, nWait != 0);
+}
+
+EXTERN ISL_API_EXPORT int ISL_IOReleaseReadSlot(void * pData)
+{
+	if (pData == NULL) {
+		return -1;
+	}
+	isl::CData * cData = (isl::CData *)pData;
+	if (cData->ReleaseReadSlot()) {
+		return 0;
+	}
+	return -2;
+}
+
 EXTERN ISL_API_EXPORT int ISL_IOSetEventData(void * pData, void * pVal, int nWait)
 {
 	if (pData == NULL) {
@@ -1145,6 +1571,19 @@ EXTERN ISL_API_EXPORT int ISL_SimsGet(int nInd)
 	return -1;
 }
 
+// Index of the nNext-th simulation of a session, to be used with ISL_SimsGet()
+EXTERN ISL_API_EXPORT int ISL_SimsFind(const char * sSessionId, int nNext)
+{
+	if (sSessionId == 0) {
+		return -1;
+	}
+	std::vector<int> lSims = ISLSims->Find(sSessionId);
+	if ((nNext < 0) || (nNext >= (int)lSims.size())) {
+		return -1;
+	}
+	return lSims[nNext];
+}
+
 EXTERN ISL_API_EXPORT int ISL_SimsClose()
 {
 	ISLSims_Close;
@@ -37,6 +37,7 @@
  */
 
 #include <algorithm>
+#include <chrono>
 
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
@@ -45,19 +46,68 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/process/environment.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <isl_misc.h>
 #include <isl_log.h>
 #include <isl_xml.h>
 #include <isl_shm.h>
+#include <isl_futex.h>
+#include <isl_thread.h>
 
 #include "isl_api.h"
 #include "isl_shm_connect.h"
+#include "isl_notify.h"
+#include "isl_keys.h"
+#include "isl_manifest.h"
 #include "isl_exitthread.h"
 #include "isl_settings.h"
 #include "isl_errorcodes.h"
 
 
+/*
+ *     Macros and constants definition
+ */
+
+// The inputs not created yet are tried at least every period (milliseconds)
+#define CONNECT_CHECK_PERIOD	500
+
+// Minimum number of variables handled by each thread of the bring-up of a connector
+#define CONNECT_PARALLEL_MIN	32
+
+// Maximum number of threads of the bring-up when set to the number of cores
+#define CONNECT_MAX_THREADS		8
+
+
+/*
+ *     Local functions
+ */
+
+// Number of threads creating or attaching nCount variables
+static unsigned int GetBringUpThreads(unsigned int uThreads, size_t nCount)
+{
+	if (uThreads == 0) {
+		uThreads = isl::CThread::GetNbCores();
+		if (uThreads > CONNECT_MAX_THREADS) {
+			uThreads = CONNECT_MAX_THREADS;
+		}
+	}
+	// Below, the threads cost more than they save
+	size_t nMaxThreads = nCount / CONNECT_PARALLEL_MIN;
+	if (uThreads > nMaxThreads) {
+		uThreads = (unsigned int)nMaxThreads;
+	}
+	return (uThreads > 1 ? uThreads : 1);
+}
+
+// Protects the notifications of the connectors reading the outputs
+static boost::mutex & GetNotifyLock()
+{
+	static boost::mutex * cLock = new boost::mutex();
+	return *cLock;
+}
+
+
 /*
  *     Classes definition
  */
@@ -94,6 +144,12 @@ isl::CConnect::CConnect()
 	boost::filesystem::path bpLogFile(boost::filesystem::temp_directory_path());
 	bpLogFile.append("isl_api.log");
 	AppLog->Init(bpLogFile.string());
+	if (CAppSettings().IsAsyncLog()) {
+		AppLog->SetAsync(true, CAppSettings().GetAsyncLogSize());
+	}
+	if (CAppSettings().IsTrace()) {
+		CTrace::Open(CAppSettings().GetTracePath(), CAppSettings().GetTraceSize());
+	}
 	m_uType = 0;
 	m_ulPID = boost::this_process::get_id();
 	m_nConnectTimeOut = 0;
@@ -101,19 +157,33 @@ isl::CConnect::CConnect()
 	m_dEndTime = 0.0;
 	m_dStepSize = -1.0;
 	m_dStepTolerance = CAppSettings().GetStepTolerance();
+	m_bLockFree = CAppSettings().IsLockFreeFIFO();
+	m_bFutex = CAppSettings().IsFutex();
+	m_eWaitPolicy = CVariable::GetWaitPolicyFromStr(CAppSettings().GetWaitPolicy());
+	m_nSpinCount = CAppSettings().GetSpinCount();
+	m_uConnectThreads = CAppSettings().GetConnectThreads();
 	m_cData = 0;
+	m_cNotify = 0;
+	m_cPublish = 0;
+	m_bNoPublish = false;
+	m_cKeys = 0;
+	m_bNoKeys = false;
+	m_cManifest = 0;
+	m_bNoManifest = false;
 	m_cContainer = 0;
 	m_bCloseLog = false;
 	m_bManager = true;
 	m_eMode = SMD_STOP;
 	m_bViewer = false;
 	m_bTerminated = false;
+	m_bInFrame = false;
 	m_ucState = 0;
 #if 0 // TODO: To add
 	m_cStore = 0;
 #endif
 	m_cSimData = 0;
 	m_lTimer = 0;
+	m_uTraceName = 0;
 }
 
 isl::CConnect::CConnect(bool bOwner)
@@ -121,6 +191,12 @@ isl::CConnect::CConnect(bool bOwner)
 	boost::filesystem::path bpLogFile(boost::filesystem::temp_directory_path());
 	bpLogFile.append("isl_api.log");
 	AppLog->Init(bpLogFile.string());
+	if (CAppSettings().IsAsyncLog()) {
+		AppLog->SetAsync(true, CAppSettings().GetAsyncLogSize());
+	}
+	if (CAppSettings().IsTrace()) {
+		CTrace::Open(CAppSettings().GetTracePath(), CAppSettings().GetTraceSize());
+	}
 	m_uType = 0;
 	m_ulPID = boost::this_process::get_id();
 	m_nConnectTimeOut = 0;
@@ -128,19 +204,33 @@ isl::CConnect::CConnect(bool bOwner)
 	m_dEndTime = 0.0;
 	m_dStepSize = -1.0;
 	m_dStepTolerance = CAppSettings().GetStepTolerance();
+	m_bLockFree = CAppSettings().IsLockFreeFIFO();
+	m_bFutex = CAppSettings().IsFutex();
+	m_eWaitPolicy = CVariable::GetWaitPolicyFromStr(CAppSettings().GetWaitPolicy());
+	m_nSpinCount = CAppSettings().GetSpinCount();
+	m_uConnectThreads = CAppSettings().GetConnectThreads();
 	m_cData = 0;
+	m_cNotify = 0;
+	m_cPublish = 0;
+	m_bNoPublish = false;
+	m_cKeys = 0;
+	m_bNoKeys = false;
+	m_cManifest = 0;
+	m_bNoManifest = false;
 	m_cContainer = 0;
 	m_bCloseLog = false;
 	m_bManager = bOwner;
 	m_eMode = SMD_STOP;
 	m_bViewer = false;
 	m_bTerminated = false;
+	m_bInFrame = false;
 	m_ucState = 0;
 #if 0 // TODO: To add
 	m_cStore = 0;
 #endif
 	m_cSimData = 0;
 	m_lTimer = 0;
+	m_uTraceName = 0;
 }
 
 isl::CConnect::~CConnect()
@@ -153,6 +243,18 @@ isl::CConnect::~CConnect()
 #if 0 // TODO: To add
 	CData::CloseComputeLibrary();
 #endif
+	if (m_cPublish != 0) {
+		delete m_cPublish;
+	}
+	m_cPublish = 0;
+	if (m_cKeys != 0) {
+		delete m_cKeys;
+	}
+	m_cKeys = 0;
+	if (m_cManifest != 0) {
+		delete m_cManifest;
+	}
+	m_cManifest = 0;
 	//
 	m_lIns.clear();
 	m_lOuts.clear();
@@ -290,6 +392,22 @@ bool isl::CConnect::Load(const std::string & sFileName)
 	if (m_dStepTolerance == 0.0) {
 		m_dStepTolerance = CAppSettings().GetStepTolerance();
 	}
+	std::string sLockFree = xCosim->GetAttribute("lockfree");
+	if (sLockFree.empty() == false) {
+		m_bLockFree = (sLockFree == "true");
+	}
+	std::string sFutex = xCosim->GetAttribute("futex");
+	if (sFutex.empty() == false) {
+		m_bFutex = (sFutex == "true");
+	}
+	std::string sWaitPolicy = xCosim->GetAttribute("waitpolicy");
+	if (sWaitPolicy.empty() == false) {
+		m_eWaitPolicy = CVariable::GetWaitPolicyFromStr(sWaitPolicy);
+	}
+	std::string sSpinCount = xCosim->GetAttribute("spincount");
+	if (sSpinCount.empty() == false) {
+		m_nSpinCount = CString::GetInteger(sSpinCount);
+	}
 	// Load new data types definition
 	// TODO: Add management of new types defintion
 	// Get the variables
@@ -326,6 +444,15 @@ bool isl::CConnect::Load(const std::string & sFileName)
 				nVal = -1; // Check if we keep the value of 0 or not
 			}
 			cVar->SetSyncTimeout(nVal);
+			cVar->SetWaitPolicy(xVar->GetAttribute("waitpolicy"));
+			std::string sSpinCount = xVar->GetAttribute("spincount");
+			if (sSpinCount.empty() == false) {
+				cVar->SetSpinCount(CString::GetInteger(sSpinCount));
+			}
+			cVar->SetMode(xVar->GetAttribute("mode"));
+			cVar->SetBackPressure(xVar->GetAttribute("backpressure"));
+			cVar->UseHugePages(xVar->GetAttribute("hugepages") == "true");
+			cVar->SetNumaPolicy(xVar->GetAttribute("numa"));
 			// Data types
 			std::string sInit;
 			int nSize = 0;
@@ -409,7 +536,7 @@ bool isl::CConnect::Check()
 	// Co-simulation parameters
 	if (m_sSessionId.empty()) {
 		AppLogWarning(ISLCONNECT_CHECK_NOSESSIONID, "Connector '%s': no session identifier is defined."
-			" The session id shall be set during the 'Create' function call.");
+			" The session id shall be set during the 'Create' function call.", m_sName.c_str());
 	}
 	if (m_nConnectTimeOut < 0) {
 		AppLogWarning(ISLCONNECT_CHECK_NEGCONNECTTIMEOUT,
@@ -454,6 +581,19 @@ bool isl::CConnect::Check()
 			return false;
 		}
 	}
+	if (m_bFutex && ((CFutex::IsAvailable() == false) || CAppSettings().IsISLCompatible())) {
+		AppLogWarning(ISLCONNECT_CHECK_FUTEXNOTAVAILABLE,
+			"Connector '%s': Futex synchronization is not available, semaphores will be used.", m_sName.c_str());
+		m_bFutex = false;
+	}
+	if (m_eWaitPolicy == CVariable::WP_DEFAULT) {
+		AppLogWarning(ISLCONNECT_CHECK_WRONGWAITPOLICY,
+			"Connector '%s': Wrong wait policy. The default value (%s) will be used.", m_sName.c_str(), DEFAULT_WAIT_POLICY);
+		m_eWaitPolicy = CVariable::GetWaitPolicyFromStr(DEFAULT_WAIT_POLICY);
+	}
+	if (m_nSpinCount < 0) {
+		m_nSpinCount = DEFAULT_SPIN_COUNT;
+	}
 	if ((m_dStepTolerance <= 0.0) || (m_dStepTolerance >= 1.0)) {
 		AppLogWarning(ISLCONNECT_CHECK_WRONGSTEPTOLERANCE,
 			"Connector '%s': Wrong step tolerance (%g). The default value (%g) will be used.",
@@ -462,8 +602,11 @@ bool isl::CConnect::Check()
 	}
 	AppLogInfo(ISLCONNECT_CHECK_COSIMINFO,
 		"Connector '%s': Co-simulation parameters:\n\tSession id: %s\n\tStart time: %gs\n\tEnd time: %gs\n"
-		"\tStep size: %gs\n\tStep tolerance: %g\n\tConnection timeout: %ds",
-		m_sName.c_str(), m_sSessionId.c_str(), m_dStartTime, m_dEndTime, m_dStepSize, m_dStepTolerance, m_nConnectTimeOut);
+		"\tStep size: %gs\n\tStep tolerance: %g\n\tConnection timeout: %ds\n\tLock-free FIFO: %s\n\tFutex: %s"
+		"\n\tWait policy (Spin count): %s (%d)",
+		m_sName.c_str(), m_sSessionId.c_str(), m_dStartTime, m_dEndTime, m_dStepSize, m_dStepTolerance, m_nConnectTimeOut,
+		(m_bLockFree ? "true" : "false"), (m_bFutex ? "true" : "false"),
+		CVariable::GetWaitPolicyStr(m_eWaitPolicy).c_str(), m_nSpinCount);
 	// Check the variables, refine the parameters and build the maps
 	if (m_lIOs.empty()) {
 		AppLogError(ISLCONNECT_CHECK_NOIOS, "Connector '%s': no variables have been defined.", m_sName.c_str());
@@ -545,6 +688,10 @@ bool isl::CConnect::Save(const std::string & sFileName)
 	xCosim->SetAttribute("endtime", boost::str(boost::format("%1%") % m_dEndTime));
 	xCosim->SetAttribute("stepsize", boost::str(boost::format("%1%") % m_dStepSize));
 	xCosim->SetAttribute("steptolerance", boost::str(boost::format("%1%") % m_dStepTolerance));
+	xCosim->SetAttribute("lockfree", (m_bLockFree ? "true" : "false"));
+	xCosim->SetAttribute("futex", (m_bFutex ? "true" : "false"));
+	xCosim->SetAttribute("waitpolicy", CVariable::GetWaitPolicyStr(m_eWaitPolicy));
+	xCosim->SetAttribute("spincount", boost::str(boost::format("%1%") % m_nSpinCount));
 	// Types definition
 	// TODO: To implement
 	// Variables
@@ -561,6 +708,24 @@ bool isl::CConnect::Save(const std::string & sFileName)
 			}
 			xVar->SetAttribute("store", (m_lIOs[i]->IsStoreUsed() ? "true" : "false"));
 			xVar->SetAttribute("synctimeout", boost::str(boost::format("%1%") % m_lIOs[i]->GetSyncTimeout()));
+			if (m_eWaitPolicy != m_lIOs[i]->GetWaitPolicy()) {
+				xVar->SetAttribute("waitpolicy", m_lIOs[i]->GetWaitPolicyAsStr());
+			}
+			if (m_nSpinCount != m_lIOs[i]->GetSpinCount()) {
+				xVar->SetAttribute("spincount", boost::str(boost::format("%1%") % m_lIOs[i]->GetSpinCount()));
+			}
+			if (m_lIOs[i]->GetMode() != CVariable::MD_FIFO) {
+				xVar->SetAttribute("mode", m_lIOs[i]->GetModeAsStr());
+			}
+			if (m_lIOs[i]->GetBackPressure() != CVariable::BP_BLOCK) {
+				xVar->SetAttribute("backpressure", m_lIOs[i]->GetBackPressureAsStr());
+			}
+			if (m_lIOs[i]->IsHugePagesUsed()) {
+				xVar->SetAttribute("hugepages", "true");
+			}
+			if (m_lIOs[i]->GetNumaPolicy() != CVariable::NP_DEFAULT) {
+				xVar->SetAttribute("numa", m_lIOs[i]->GetNumaPolicyAsStr());
+			}
 			CXMLNode * xType = xVar->AddNode(m_lIOs[i]->GetType()->GetIdAsStr());
 			xType->SetAttribute("size", boost::str(boost::format("%1%") % m_lIOs[i]->GetType()->GetSize()));
 			xType->SetAttribute("initialvalue", m_lIOs[i]->GetType()->GetInitialAsStr());
@@ -765,6 +930,96 @@ double isl::CConnect::GetStepTolerance()
 	return m_dStepTolerance;
 }
 
+void isl::CConnect::SetLockFree(bool bVal)
+{
+	if (m_ucState == 1) {
+		m_ucState = 0;
+	}
+	if (m_ucState != 0) {
+		AppLogWarning(ISLCONNECT_CANNOTMODIFY_AFTERCONNECT,
+			"Connector '%s': Cannot modify the connector configuration after connection.", m_sName.c_str());
+		return;
+	}
+	m_bLockFree = bVal;
+}
+
+bool isl::CConnect::IsLockFree()
+{
+	return m_bLockFree;
+}
+
+void isl::CConnect::SetFutex(bool bVal)
+{
+	if (m_ucState == 1) {
+		m_ucState = 0;
+	}
+	if (m_ucState != 0) {
+		AppLogWarning(ISLCONNECT_CANNOTMODIFY_AFTERCONNECT,
+			"Connector '%s': Cannot modify the connector configuration after connection.", m_sName.c_str());
+		return;
+	}
+	m_bFutex = bVal;
+}
+
+bool isl::CConnect::IsFutex()
+{
+	return m_bFutex;
+}
+
+void isl::CConnect::SetWaitPolicy(CVariable::tWaitPolicy eWaitPolicy)
+{
+	if (m_ucState == 1) {
+		m_ucState = 0;
+	}
+	if (m_ucState != 0) {
+		AppLogWarning(ISLCONNECT_CANNOTMODIFY_AFTERCONNECT,
+			"Connector '%s': Cannot modify the connector configuration after connection.", m_sName.c_str());
+		return;
+	}
+	m_eWaitPolicy = eWaitPolicy;
+}
+
+isl::CVariable::tWaitPolicy isl::CConnect::GetWaitPolicy()
+{
+	return m_eWaitPolicy;
+}
+
+void isl::CConnect::SetSpinCount(int nCount)
+{
+	if (m_ucState == 1) {
+		m_ucState = 0;
+	}
+	if (m_ucState != 0) {
+		AppLogWarning(ISLCONNECT_CANNOTMODIFY_AFTERCONNECT,
+			"Connector '%s': Cannot modify the connector configuration after connection.", m_sName.c_str());
+		return;
+	}
+	m_nSpinCount = nCount;
+}
+
+int isl::CConnect::GetSpinCount()
+{
+	return m_nSpinCount;
+}
+
+void isl::CConnect::SetConnectThreads(unsigned int uNbThreads)
+{
+	if (m_ucState == 1) {
+		m_ucState = 0;
+	}
+	if (m_ucState != 0) {
+		AppLogWarning(ISLCONNECT_CANNOTMODIFY_AFTERCONNECT,
+			"Connector '%s': Cannot modify the connector configuration after connection.", m_sName.c_str());
+		return;
+	}
+	m_uConnectThreads = uNbThreads;
+}
+
+unsigned int isl::CConnect::GetConnectThreads()
+{
+	return m_uConnectThreads;
+}
+
 isl::CData * isl::CConnect::NewIO(const std::string & sId, CData::tCausality eCausality, CDataType::tType eType, int nSize)
 {
 	if (m_ucState == 1) {
@@ -1122,6 +1377,7 @@ bool isl::CConnect::Create(const std::string & sSessionId)
 	}
 	else {
 		cMem = new CSHM(sSHM, bIsGlobalIPC);
+		cMem->SetBackend(CSHM::GetBackendFromStr(CAppSettings().GetSHMBackend()));
 	}
 	if (m_bManager) {
 		AppLogInfo(ISLCONNECT_CREATE_CREATESHM, "Connector '%s': creating the shared memory '%s'...",
@@ -1176,25 +1432,42 @@ bool isl::CConnect::Create(const std::string & sSessionId)
 		cMem->Unlock();
 	}
 	m_cData = cData;
-	// Create the outputs
-	if (m_lOuts.empty() == false) {
-		bool bOk = true;
-		for (size_t i = 0; i < m_lOuts.size(); i++) {
-			// Do not connect data without SignalID
-			if (m_lOuts[i]->GetConnectId().empty()) {
-				continue;
-			}
-			int nRet = m_lOuts[i]->Connect(false);
-			if (nRet != 0) {
-				AppLogError(ISLCONNECT_CREATE_DATACONNECTFAILED,
-					"Connector '%s': Variable '%s': failed to connect the output: %d.",
-					m_sName.c_str(), m_lOuts[i]->GetId().c_str(), nRet);
-				bOk = false;
-			}
+	// Create the outputs: they are independent from each other and created by a pool of threads
+	std::vector<CData *> lOuts;
+	for (size_t i = 0; i < m_lOuts.size(); i++) {
+		// Do not connect data without SignalID
+		if (m_lOuts[i]->GetConnectId().empty() == false) {
+			lOuts.push_back(m_lOuts[i]);
+		}
+	}
+	if (lOuts.empty() == false) {
+		// Opened before the threads publish the outputs
+		GetPublish();
+		GetSessionKeys();
+		GetManifest();
+		std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+		std::vector<int> lRet(lOuts.size(), 0);
+		double dStartTime = m_dStartTime;
+		CThreadPool cPool(GetBringUpThreads(m_uConnectThreads, lOuts.size()));
+		cPool.Run(lOuts.size(), [&](size_t i) {
+			lRet[i] = lOuts[i]->Connect(false);
 			// Initialize the values in the shared memory
-			m_lOuts[i]->Initialize(m_dStartTime);
+			lOuts[i]->Initialize(dStartTime);
+		});
+		AppLogInfo(ISLCONNECT_BRINGUP_COMPLETED,
+			"Connector '%s': %d outputs created in %.1fms (%d threads).", m_sName.c_str(), (int)lOuts.size(),
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStart).count(),
+			cPool.GetNbThreads());
+		std::vector<CData *> lFailed;
+		std::vector<int> lFailedRet;
+		for (size_t i = 0; i < lOuts.size(); i++) {
+			if (lRet[i] != 0) {
+				lFailed.push_back(lOuts[i]);
+				lFailedRet.push_back(lRet[i]);
+			}
 		}
-		if (bOk == false) {
+		if (lFailed.empty() == false) {
+			LogFailedIOs(ISLCONNECT_CREATE_OUTPUTSFAILED, "outputs", lOuts.size(), lFailed, lFailedRet);
 			return false;
 		}
 	}
@@ -1238,23 +1511,84 @@ bool isl::CConnect::Connect(bool bWait)
 	ISLInstances->Add(this);
 	// Connect the inputs
 	if (m_lIns.empty() == false) {
-		bool bOk = true;
+		// Created before the readers registration: the writers notify the connector from then
+		if ((m_cNotify == 0) && (m_cData != 0)) {
+			m_cNotify = new CNotify();
+			m_cNotify->Open(m_cData, m_sSessionId, GetUId(), GetSessionKeys());
+		}
+		// The inputs are attached in parallel: all of them are tried each time
+		// a variable of the session is published, or at least every period.
+		// The attachments of a round are shared by a pool of threads.
+		CPublish * cPublish = (bWait ? GetPublish() : 0);
+		GetSessionKeys();
+		std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+		std::chrono::steady_clock::time_point tpEnd = tpStart +
+			std::chrono::seconds(m_nConnectTimeOut > 0 ? m_nConnectTimeOut : 0);
+		std::vector<CData *> lPending;
 		for (size_t i = 0; i != m_lIns.size(); i++) {
 			// Do not connect data without ConnectID
-			if (m_lIns[i]->GetConnectId().empty()) {
-				continue;
+			if (m_lIns[i]->GetConnectId().empty() == false) {
+				lPending.push_back(m_lIns[i]);
 			}
-			if (m_lIns[i]->Connect(bWait, m_nConnectTimeOut) < 0) {
-				AppLogError(ISLCONNECT_CONNECT_FAILEDINPUT,
-					"Connector '%s': Variable '%s': failed to connect the input to the transmitters.",
-					m_sName.c_str(), m_lIns[i]->GetId().c_str());
-				bOk = false;
+		}
+		size_t nInputs = lPending.size();
+		CThreadPool cPool(GetBringUpThreads(m_uConnectThreads, nInputs));
+		std::vector<CData *> lFailed;
+		std::vector<int> lFailedRet;
+		while (lPending.empty() == false) {
+			unsigned int uGeneration = (cPublish != 0 ? cPublish->GetGeneration() : 0);
+			std::vector<int> lRet(lPending.size(), 0);
+			cPool.Run(lPending.size(), [&](size_t i) {
+				lRet[i] = lPending[i]->Connect(false);
+			});
+			std::vector<CData *> lLeft;
+			for (size_t i = 0; i < lPending.size(); i++) {
+				if (lRet[i] == 3) {
+					// Not created yet
+					lLeft.push_back(lPending[i]);
+				}
+				else if (lRet[i] < 0) {
+					lFailed.push_back(lPending[i]);
+					lFailedRet.push_back(lRet[i]);
+				}
+			}
+			lPending.swap(lLeft);
+			if ((lPending.empty()) || (bWait == false)) {
+				break;
+			}
+			int nWait = CONNECT_CHECK_PERIOD;
+			if (m_nConnectTimeOut > 0) {
+				int nLeft = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+					tpEnd - std::chrono::steady_clock::now()).count();
+				if (nLeft <= 0) {
+					// The inputs remaining are not connected
+					break;
+				}
+				nWait = (nLeft < nWait ? nLeft : nWait);
+			}
+			if (cPublish != 0) {
+				cPublish->Wait(uGeneration, nWait);
+			}
+			else {
+				CThread::Sleep(nWait);
 			}
 		}
-		if (bOk == false) {
+		if (nInputs > lPending.size()) {
+			AppLogInfo(ISLCONNECT_BRINGUP_COMPLETED,
+				"Connector '%s': %d inputs attached in %.1fms (%d threads).", m_sName.c_str(),
+				(int)(nInputs - lPending.size()),
+				std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStart).count(),
+				cPool.GetNbThreads());
+		}
+		if (lFailed.empty() == false) {
+			LogFailedIOs(ISLCONNECT_CONNECT_INPUTSFAILED, "inputs", nInputs, lFailed, lFailedRet);
 			return false;
 		}
 	}
+	// The connectors already reading the outputs: attached once for all of them
+	for (size_t i = 0; i < m_lOuts.size(); i++) {
+		m_lOuts[i]->AttachNotify();
+	}
 	// Start timer if set
 	StartTimer();
 	//
@@ -1275,6 +1609,10 @@ bool isl::CConnect::Disconnect()
 	if (m_bViewer) {
 		return DisconnectAsViewer();
 	}
+	// Publish the values of a frame still open
+	if (m_bInFrame) {
+		CommitFrame();
+	}
 	// Compute and display the elapsed time
 	if (m_lTimer != 0) {
 		StopTimer();
@@ -1291,6 +1629,21 @@ bool isl::CConnect::Disconnect()
 	}
 	m_cSimData = 0;
 	ISLSims_Close;
+	// The notification object uses the shared memory of the connector
+	if (m_cNotify != 0) {
+		delete m_cNotify;
+	}
+	m_cNotify = 0;
+	if (m_cPublish != 0) {
+		delete m_cPublish;
+	}
+	m_cPublish = 0;
+	m_bNoPublish = false;
+	if (m_cKeys != 0) {
+		delete m_cKeys;
+	}
+	m_cKeys = 0;
+	m_bNoKeys = false;
 	// Detach the shared memory and clean
 	bool bRet = true;
 	if (m_cContainer != 0) {
@@ -1318,13 +1671,267 @@ bool isl::CConnect::Disconnect()
 			bRet = false;
 		}
 	}
+	// Used by the outputs until they are disconnected
+	for (std::map<unsigned int, CNotify *>::iterator it = m_mNotify.begin(); it != m_mNotify.end(); ++it) {
+		delete it->second;
+	}
+	m_mNotify.clear();
+	// Closed once the variables are removed from it
+	if (m_cManifest != 0) {
+		delete m_cManifest;
+	}
+	m_cManifest = 0;
+	m_bNoManifest = false;
 	AppLogInfo(ISLCONNECT_DISCONNECT_DISCONNECTED,
 		"Connector '%s': disconnected from the session.", m_sName.c_str());
+	// Asynchronous mode: the log is complete when the connector is disconnected
+	AppLog->Flush();
 	m_bTerminated = true;
 	m_ucState = 1; // Return in 'checked' mode
 	return bRet;
 }
 
+bool isl::CConnect::BeginFrame()
+{
+	if (((m_ucState != 3) && (m_ucState != 7)) || m_bViewer) {
+		return false;
+	}
+	for (size_t i = 0; i < m_lOuts.size(); i++) {
+		m_lOuts[i]->SetDeferred(true);
+	}
+	m_bInFrame = true;
+	if (CTrace::IsEnabled()) {
+		if (m_uTraceName == 0) {
+			m_uTraceName = CTrace::RegisterName(m_sName);
+		}
+		CTrace::Record(CTrace::TE_FRAME_BEGIN, m_uTraceName, -1.0);
+	}
+	return true;
+}
+
+bool isl::CConnect::CommitFrame(bool bKeepOpen)
+{
+	if (m_bInFrame == false) {
+		return false;
+	}
+	// All the values of the frame are already written: they are published in one pass
+	// and the readers waiting on them are woken up once per output.
+	for (size_t i = 0; i < m_lOuts.size(); i++) {
+		m_lOuts[i]->SetDeferred(bKeepOpen);
+		m_lOuts[i]->Commit();
+	}
+	m_bInFrame = bKeepOpen;
+	if (CTrace::IsEnabled()) {
+		CTrace::Record(CTrace::TE_FRAME_END, m_uTraceName, -1.0);
+		if (bKeepOpen) {
+			CTrace::Record(CTrace::TE_FRAME_BEGIN, m_uTraceName, -1.0);
+		}
+	}
+	return true;
+}
+
+isl::CPublish * isl::CConnect::GetPublish()
+{
+	// Not tried again after a failure: the variables connected in parallel only read the members
+	if ((m_cPublish == 0) && (m_bNoPublish == false) && (m_sSessionId.empty() == false)) {
+		m_cPublish = new CPublish();
+		if (m_cPublish->Open(m_sSessionId) == false) {
+			AppLogWarning(ISLCONNECT_PUBLISH_FAILED,
+				"Connector '%s': the publication of the variables is not available, the inputs are polled.",
+				m_sName.c_str());
+			delete m_cPublish;
+			m_cPublish = 0;
+			m_bNoPublish = true;
+		}
+	}
+	return m_cPublish;
+}
+
+isl::CSessionKeys * isl::CConnect::GetSessionKeys()
+{
+	// The ISL compatible objects keep their names. Not tried again after a failure.
+	if ((m_cKeys == 0) && (m_bNoKeys == false) && (m_sSessionId.empty() == false)) {
+		if (CAppSettings().IsSessionKeys() && (CAppSettings().IsISLCompatible() == false)) {
+			m_cKeys = new CSessionKeys();
+			if (m_cKeys->Open(m_sSessionId) == false) {
+				AppLogWarning(ISLCONNECT_SESSIONKEYS_FAILED,
+					"Connector '%s': the identifiers of the session are not available, the keys of the variables are used.",
+					m_sName.c_str());
+				delete m_cKeys;
+				m_cKeys = 0;
+			}
+		}
+		m_bNoKeys = (m_cKeys == 0);
+	}
+	return m_cKeys;
+}
+
+isl::CNotify * isl::CConnect::GetNotify(unsigned int uId)
+{
+	// The outputs may be written by several threads
+	boost::mutex::scoped_lock cLock(GetNotifyLock());
+	CNotify *& cNotify = m_mNotify[uId];
+	if (cNotify == 0) {
+		cNotify = new CNotify();
+	}
+	// Not attached yet: tried again when a variable sees a new reader of this connector
+	if ((cNotify->GetId() == 0) && (cNotify->Attach(m_sSessionId, uId, GetSessionKeys()) == false)) {
+		cNotify->Close();
+		return 0;
+	}
+	return cNotify;
+}
+
+isl::CManifest * isl::CConnect::GetManifest()
+{
+	// Not tried again after a failure: the variables created in parallel only read the members
+	if ((m_cManifest == 0) && (m_bNoManifest == false) && (m_sSessionId.empty() == false)) {
+		m_cManifest = new CManifest();
+		if (m_cManifest->Open(m_sSessionId) == false) {
+			AppLogWarning(ISLCONNECT_MANIFEST_FAILED,
+				"Connector '%s': the manifest of the session is not available, the outputs are not listed.",
+				m_sName.c_str());
+			delete m_cManifest;
+			m_cManifest = 0;
+			m_bNoManifest = true;
+		}
+	}
+	return m_cManifest;
+}
+
+void isl::CConnect::LogFailedIOs(int nCode, const char * sCausality, size_t nCount,
+	const std::vector<CData *> & lFailed, const std::vector<int> & lRet)
+{
+	// The first ones are listed, the error of each of them is logged by the variable
+	std::string sList;
+	for (size_t i = 0; (i < lFailed.size()) && (i < 10); i++) {
+		sList += boost::str(boost::format("%1%'%2%' (%3%)") % (i == 0 ? "" : ", ") %
+			lFailed[i]->GetId() % lRet[i]);
+	}
+	if (lFailed.size() > 10) {
+		sList += ", ...";
+	}
+	AppLogError(nCode, "Connector '%s': %d of %d %s failed to connect: %s.", m_sName.c_str(),
+		(int)lFailed.size(), (int)nCount, sCausality, sList.c_str());
+}
+
+void isl::CConnect::TraceStep(double dTime)
+{
+	if (CTrace::IsEnabled() == false) {
+		return;
+	}
+	if (m_uTraceName == 0) {
+		m_uTraceName = CTrace::RegisterName(m_sName);
+	}
+	CTrace::Record(CTrace::TE_STEP, m_uTraceName, dTime);
+}
+
+bool isl::CConnect::IsInFrame()
+{
+	return m_bInFrame;
+}
+
+int isl::CConnect::WaitInputs(double dTime, int nTimeout, std::vector<bool> * lReady, bool bAny,
+	const std::vector<bool> * lSelected)
+{
+	if ((m_ucState != 7) || (m_cNotify == 0)) {
+		AppLogError(ISLCONNECT_WAITINPUTS_NOTCONNECTED,
+			"Connector '%s': the inputs are not connected. State: %d", m_sName.c_str(), m_ucState);
+		return -1;
+	}
+	std::chrono::steady_clock::time_point tpEnd;
+	if (nTimeout > 0) {
+		tpEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(nTimeout);
+	}
+	// An input ready stays ready: only the caller reads the values
+	std::vector<bool> lInReady(m_lIns.size(), false);
+	bool bListen = false;
+	int nReady = 0;
+	while (true) {
+		int nSelected = 0;
+		bool bIsTerminated = false;
+		nReady = 0;
+		for (size_t i = 0; i < m_lIns.size(); i++) {
+			if ((lSelected != 0) && ((i >= lSelected->size()) || ((*lSelected)[i] == false))) {
+				continue;
+			}
+			if (m_lIns[i]->IsConnected() == false) {
+				continue;
+			}
+			nSelected++;
+			if (lInReady[i] == false) {
+				lInReady[i] = m_lIns[i]->IsDataReady(dTime);
+			}
+			if (lInReady[i]) {
+				nReady++;
+			}
+			else if (m_lIns[i]->IsTerminated()) {
+				bIsTerminated = true;
+			}
+		}
+		if ((bAny ? (nReady > 0) : (nReady == nSelected)) || bIsTerminated || (nTimeout == 0)) {
+			if (bListen) {
+				m_cNotify->CancelListen();
+			}
+			if (bIsTerminated) {
+				// Simulation ended
+				SetTerminated();
+			}
+			break;
+		}
+		if (bListen == false) {
+			// A value published before the registration is seen by the next check
+			m_cNotify->Listen();
+			bListen = true;
+			continue;
+		}
+		int nLeft = -1;
+		if (nTimeout > 0) {
+			nLeft = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+				tpEnd - std::chrono::steady_clock::now()).count();
+			if (nLeft <= 0) {
+				m_cNotify->CancelListen();
+				break;
+			}
+		}
+		bListen = false;
+		if (m_cNotify->Wait(nLeft) == false) {
+			m_cNotify->CancelListen();
+			if (m_cNotify->IsTimeout() == false) {
+				return -1;
+			}
+		}
+	}
+	if (lReady != 0) {
+		*lReady = lInReady;
+	}
+	return nReady;
+}
+
+int isl::CConnect::GetNotifyHandle()
+{
+	if ((m_ucState != 7) || (m_cNotify == 0)) {
+		AppLogError(ISLCONNECT_WAITINPUTS_NOTCONNECTED,
+			"Connector '%s': the inputs are not connected. State: %d", m_sName.c_str(), m_ucState);
+		return -1;
+	}
+	int nHandle = m_cNotify->OpenHandle();
+	if (nHandle == -1) {
+		AppLogError(ISLCONNECT_NOTIFYHANDLE_FAILED,
+			"Connector '%s': failed to open the notification handle.", m_sName.c_str());
+	}
+	return nHandle;
+}
+
+bool isl::CConnect::ResetNotifyHandle()
+{
+	if (m_cNotify == 0) {
+		return false;
+	}
+	m_cNotify->ResetHandle();
+	return true;
+}
+
 bool isl::CConnect::ConnectAsViewer(bool bWait)
 {
 	// State already checked in the Connect method
@@ -1376,6 +1983,8 @@ bool isl::CConnect::DisconnectAsViewer()
 	}
 	AppLogInfo(ISLCONNECT_DISCONNECTVIEWER_DISCONNECTED,
 		"Connector '%s': disconnected from the session.", m_sName.c_str());
+	// Asynchronous mode: the log is complete when the connector is disconnected
+	AppLog->Flush();
 	m_bTerminated = true;
 	m_ucState = 1; // Return in 'checked' mode
 	return bRet;
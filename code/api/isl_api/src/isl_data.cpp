@@ -36,18 +36,25 @@
  *     Header files
  */
 
+#include <chrono>
 #include <boost/format.hpp>
 
 #include <isl_log.h>
 #include "isl_api.h"
 #include <isl_thread.h>
 #include <isl_sem.h>
+#include <isl_futex.h>
+#include <isl_atomic.h>
 #include <isl_shm.h>
 
 #include "isl_errorcodes.h"
 #include "isl_settings.h"
 #include "isl_shm_data.h"
+#include "isl_notify.h"
+#include "isl_keys.h"
+#include "isl_manifest.h"
 #include "isl_data.h"
+#include "isl_trace.h"
 
 
 /*
@@ -58,6 +65,12 @@
 #define SEM_WR_KEY_ID	"_isl_sem_ses%1%_swr%2%"
 #define SEM_RD_KEY_ID	"_isl_sem_ses%1%_srd%2%"
 
+// A waiting writer checks the readers are still alive every period (milliseconds)
+#define READERS_CHECK_PERIOD	1000
+
+// A reader tries to attach the memory of its writer at least every period (milliseconds)
+#define ATTACH_CHECK_PERIOD		500
+
 
 /*
  *     Classes definition
@@ -68,17 +81,24 @@ isl::CData::CData(CConnect * cParent, const std::string & sId)
 {
 	m_cData = NULL;
 	m_cContainer = NULL;
+	m_cAttachPending = NULL;
+	m_nManifest = -1;
 	m_cWriterListen = NULL;
 	m_cReaderListen = NULL;
-	m_usMaxFifoDepth = CAppSettings().GetMaxFIFODepth();
-	m_usFifoDepth = m_usMaxFifoDepth;
+	m_cWriterWake = NULL;
+	m_cReaderWake = NULL;
+	m_uMaxFifoDepth = CAppSettings().GetMaxFIFODepth();
+	m_uFifoDepth = m_uMaxFifoDepth;
 	m_nMaxNbReaders = CAppSettings().GetMaxNbReaders();
 	m_bManager = false;
 	m_bIsConnected = false;
 	m_bIsViewer = false;
+	m_bLockFree = false;
+	m_bFutex = false;
 	m_dStepTolerance = CAppSettings().GetStepTolerance();
 	m_dOriginalStep = -1.0;
 	m_dTmpStep = 0.0;
+	m_uTraceName = CTrace::RegisterName(sId);
 	// Additional parameters initialization is done in InitOnCheck
 }
 
@@ -92,24 +112,28 @@ isl::CData::~CData()
 			DisconnectAsViewer();
 		}
 	}
+	if (m_cAttachPending != NULL) {
+		delete m_cAttachPending;
+	}
+	m_cAttachPending = NULL;
 	m_cParent = NULL;
 }
 
-void isl::CData::SetFifoDepth(unsigned short usDepth)
+void isl::CData::SetFifoDepth(unsigned int uDepth)
 {
-	if ((usDepth > 0) && (usDepth <= m_usMaxFifoDepth)) {
-		m_usFifoDepth = usDepth;
+	if ((uDepth > 0) && (uDepth <= m_uMaxFifoDepth)) {
+		m_uFifoDepth = uDepth;
 	}
 }
 
-unsigned short isl::CData::GetFifoDepth()
+unsigned int isl::CData::GetFifoDepth()
 {
-	return m_usFifoDepth;
+	return m_uFifoDepth;
 }
 
-unsigned short isl::CData::GetMaxFifoDepth()
+unsigned int isl::CData::GetMaxFifoDepth()
 {
-	return m_usMaxFifoDepth;
+	return m_uMaxFifoDepth;
 }
 
 bool isl::CData::IsFifoFull()
@@ -128,6 +152,25 @@ bool isl::CData::IsFifoEmpty()
 	return 0;
 }
 
+bool isl::CData::IsDataReady(double dTime)
+{
+	if (IsConnected() == false) {
+		return false;
+	}
+	LockData();
+	bool bRet = ((CSHMData *)m_cData)->IsDataReady(dTime);
+	UnlockData();
+	return bRet;
+}
+
+bool isl::CData::IsTerminated()
+{
+	if (IsConnected() == false) {
+		return false;
+	}
+	return ((CSHMData *)m_cData)->IsTerminated();
+}
+
 int isl::CData::GetReaders()
 {
 	if (m_cData != NULL) {
@@ -136,7 +179,7 @@ int isl::CData::GetReaders()
 	return 0;
 }
 
-unsigned char isl::CData::GetIndWriter()
+unsigned int isl::CData::GetIndWriter()
 {
 	if (m_cData != NULL) {
 		return ((CSHMData *)m_cData)->GetIndWriter();
@@ -144,7 +187,7 @@ unsigned char isl::CData::GetIndWriter()
 	return 0;
 }
 
-unsigned char isl::CData::GetIndReader(int i)
+unsigned int isl::CData::GetIndReader(int i)
 {
 	if (m_cData != NULL) {
 		return ((CSHMData *)m_cData)->GetIndReader(i);
@@ -174,66 +217,45 @@ bool isl::CData::SetData(void * pData, double dTime, bool bWait)
 	if (IsConnected() == false) {
 		return false;
 	}
+	CTraceScope cTrace(CTrace::TE_SET_ENTER, m_uTraceName, dTime);
 	bool bListen = false;
-	m_cContainer->Lock();
+	LockData();
 	bool bRet = ((CSHMData *)m_cData)->SetData(pData, dTime, (bWait ? &bListen : NULL));
-	m_cContainer->Unlock();
+	UnlockData();
 	// Wait until the FIFO is not full anymore
 	while (bListen == true) {
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLDATA_DEBUG, "SetData locked on t=%gs for '%s'", dTime, m_sId.c_str());
 #endif
-		if (m_cWriterListen->Acquire() == false) {
+		if (((CSHMData *)m_cData)->IsDeferred()) {
+			// The readers may wait for the values of the frame to free some space
+			m_cParent->CommitFrame(true);
+		}
+		if (AcquireWriterListen(dTime) == false) {
 			return false;
 		}
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLDATA_DEBUG, "SetData unlocked on t=%gs for '%s'",
 			dTime, m_sId.c_str());
 #endif
-		m_cContainer->Lock();
+		LockData();
 		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
-		m_cContainer->Unlock();
+		UnlockData();
 		if (bIsTerminated) {
 			// Simulation ended
 			m_cParent->SetTerminated();
 			return false;
 		}
-		m_cContainer->Lock();
+		LockData();
 		// bListen == true means bWait == true
 		bRet = ((CSHMData *)m_cData)->SetData(pData, dTime, &bListen);
 		// bListen will be set to false if we don't need to wait anymore
-		m_cContainer->Unlock();
-	}
-	// If readers are waiting then unlock them
-	m_cContainer->Lock();
-	int nListeners = ((CSHMData *)m_cData)->GetReaderListen();
-#if 0 // TODO: verify the code below
-	int nListenersToSet = nListeners;
-#endif
-	int nReaders = ((CSHMData *)m_cData)->GetReaders();
-	if (nReaders > 1) {
-		// More than one reader, then we should release the semaphore
-		// for all readers even if they are not locked
-#if 0 // TODO: verify the code below
-		if (((nListeners + nReaders > 0) && (nListeners < 0))
-			|| ((nListeners - nReaders < 0) && (nListeners > 0))) {
-			nListeners = nReaders;
-		}
-#else
-		if ((nListeners - nReaders < 0) && (nListeners > 0)) {
-			nListeners = nReaders;
-		}
-#endif
+		UnlockData();
 	}
-	if (nListeners > 0) {
-		m_cReaderListen->Release(nListeners);
-#if 0 // TODO: verify the code below
-		((CSHMData *)m_cData)->SetReaderListen(nListenersToSet - nListeners);
-#else
-		((CSHMData *)m_cData)->SetReaderListen(0);
-#endif
+	// If readers are waiting then unlock them, unless the value belongs to a frame
+	if (((CSHMData *)m_cData)->IsDeferred() == false) {
+		WakeReaders();
 	}
-	m_cContainer->Unlock();
 	return bRet;
 }
 
@@ -242,67 +264,46 @@ bool isl::CData::SetData(void * pData, double dTime, double dStep, bool bWait)
 	if (IsConnected() == false) {
 		return false;
 	}
+	CTraceScope cTrace(CTrace::TE_SET_ENTER, m_uTraceName, dTime);
 	bool bListen = false;
-	m_cContainer->Lock();
+	LockData();
 	bool bRet = ((CSHMData *)m_cData)->SetData(pData, dTime, dStep, (bWait ? &bListen : NULL));
-	m_cContainer->Unlock();
+	UnlockData();
 	// Wait until the FIFO is not full anymore
 	while (bListen == true) {
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLDATA_DEBUG, "SetData(step) locked on t=%gs for '%s'",
 			dTime, m_sId.c_str());
 #endif
-		if (m_cWriterListen->Acquire() == false) {
+		if (((CSHMData *)m_cData)->IsDeferred()) {
+			// The readers may wait for the values of the frame to free some space
+			m_cParent->CommitFrame(true);
+		}
+		if (AcquireWriterListen(dTime) == false) {
 			return false;
 		}
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLDATA_DEBUG, "SetData(step) unlocked on t=%gs for '%s'",
 			dTime, m_sId.c_str());
 #endif
-		m_cContainer->Lock();
+		LockData();
 		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
-		m_cContainer->Unlock();
+		UnlockData();
 		if (bIsTerminated) {
 			// Simulation ended
 			m_cParent->SetTerminated();
 			return false;
 		}
-		m_cContainer->Lock();
+		LockData();
 		// bListen == true means bWait == true
 		bRet = ((CSHMData *)m_cData)->SetData(pData, dTime, dStep, &bListen);
 		// bListen will be set to false if we don't need to wait anymore
-		m_cContainer->Unlock();
+		UnlockData();
 	}
-	// If readers are waiting then unlock them
-	m_cContainer->Lock();
-	int nListeners = ((CSHMData *)m_cData)->GetReaderListen();
-#if 0 // TODO: verify the code below
-	int nListenersToSet = nListeners;
-#endif
-	int nReaders = ((CSHMData *)m_cData)->GetReaders();
-	if (nReaders > 1) {
-		// More than one reader, then we should release the semaphore
-		// for all readers even if they are not locked
-#if 0 // TODO: verify the code below
-		if (((nListeners + nReaders > 0) && (nListeners < 0))
-			|| ((nListeners - nReaders < 0) && (nListeners > 0))) {
-			nListeners = nReaders;
-		}
-#else
-		if ((nListeners - nReaders < 0) && (nListeners > 0)) {
-			nListeners = nReaders;
-		}
-#endif
-	}
-	if (nListeners > 0) {
-		m_cReaderListen->Release(nListeners);
-#if 0 // TODO: verify the code below
-		((CSHMData *)m_cData)->SetReaderListen(nListenersToSet - nListeners);
-#else
-		((CSHMData *)m_cData)->SetReaderListen(0);
-#endif
+	// If readers are waiting then unlock them, unless the value belongs to a frame
+	if (((CSHMData *)m_cData)->IsDeferred() == false) {
+		WakeReaders();
 	}
-	m_cContainer->Unlock();
 	return bRet;
 }
 
@@ -311,67 +312,46 @@ bool isl::CData::SetLastData(double dTime, double dStep, bool bWait)
 	if (IsConnected() == false) {
 		return false;
 	}
+	CTraceScope cTrace(CTrace::TE_SET_ENTER, m_uTraceName, dTime);
 	bool bListen = false;
-	m_cContainer->Lock();
+	LockData();
 	bool bRet = ((CSHMData *)m_cData)->SetLastData(dTime, dStep, (bWait ? &bListen : NULL));
-	m_cContainer->Unlock();
+	UnlockData();
 	// Wait until the FIFO is not full anymore
 	while (bListen == true) {
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLDATA_DEBUG, "SetLastData(step) locked on t=%gs for '%s'",
 			dTime, m_sId.c_str());
 #endif
-		if (m_cWriterListen->Acquire() == false) {
+		if (((CSHMData *)m_cData)->IsDeferred()) {
+			// The readers may wait for the values of the frame to free some space
+			m_cParent->CommitFrame(true);
+		}
+		if (AcquireWriterListen(dTime) == false) {
 			return false;
 		}
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLDATA_DEBUG, "SetLastData(step) unlocked on t=%gs for '%s'",
 			dTime, m_sId.c_str());
 #endif
-		m_cContainer->Lock();
+		LockData();
 		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
-		m_cContainer->Unlock();
+		UnlockData();
 		if (bIsTerminated) {
 			// Simulation ended
 			m_cParent->SetTerminated();
 			return false;
 		}
-		m_cContainer->Lock();
+		LockData();
 		// bListen == true means bWait == true
 		bRet = ((CSHMData *)m_cData)->SetLastData(dTime, dStep, &bListen);
 		// bListen will be set to false if we don't need to wait anymore
-		m_cContainer->Unlock();
+		UnlockData();
 	}
-	// If readers are waiting then unlock them
-	m_cContainer->Lock();
-	int nListeners = ((CSHMData *)m_cData)->GetReaderListen();
-#if 0 // TODO: verify the code below
-	int nListenersToSet = nListeners;
-#endif
-	int nReaders = ((CSHMData *)m_cData)->GetReaders();
-	if (nReaders > 1) {
-		// More than one reader, then we should release the semaphore
-		// for all readers even if they are not locked
-#if 0 // TODO: verify the code below
-		if (((nListeners + nReaders > 0) && (nListeners < 0))
-			|| ((nListeners - nReaders < 0) && (nListeners > 0))) {
-			nListeners = nReaders;
-		}
-#else
-		if ((nListeners - nReaders < 0) && (nListeners > 0)) {
-			nListeners = nReaders;
-		}
-#endif
-	}
-	if (nListeners > 0) {
-		m_cReaderListen->Release(nListeners);
-#if 0 // TODO: verify the code below
-		((CSHMData *)m_cData)->SetReaderListen(nListenersToSet - nListeners);
-#else
-		((CSHMData *)m_cData)->SetReaderListen(0);
-#endif
+	// If readers are waiting then unlock them, unless the value belongs to a frame
+	if (((CSHMData *)m_cData)->IsDeferred() == false) {
+		WakeReaders();
 	}
-	m_cContainer->Unlock();
 	return bRet;
 }
 
@@ -380,42 +360,52 @@ bool isl::CData::GetData(void * pData, double * dTime, bool bWait)
 	if (IsConnected() == false) {
 		return false;
 	}
+	// The time is only known when the value is read
+	CTraceScope cTrace(CTrace::TE_GET_ENTER, m_uTraceName, -1.0);
 	bool bListen = false;
-	m_cContainer->Lock();
+	LockData();
 	bool bIsFifoFull = ((CSHMData *)m_cData)->IsFifoFullForReader();
 	bool bRet = ((CSHMData *)m_cData)->GetData(pData, dTime, &m_dTmpStep, (bWait ? &bListen : NULL));
-	m_cContainer->Unlock();
+	UnlockData();
 	// The FIFO is empty
 	// Wait until we get a new value in the FIFO
 	while (bListen == true) {
-		if (m_cReaderListen->Acquire() == false) {
+		if (AcquireReaderListen() == false) {
 			return false;
 		}
-		m_cContainer->Lock();
+		LockData();
 		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
-		m_cContainer->Unlock();
+		UnlockData();
 		if (bIsTerminated) {
-			// Simulation ended
-			m_cParent->SetTerminated();
-			return false;
+			// Simulation ended: the values written before the end can still be read
+			LockData();
+			bRet = ((CSHMData *)m_cData)->GetData(pData, dTime, &m_dTmpStep, NULL);
+			UnlockData();
+			if (bRet == false) {
+				m_cParent->SetTerminated();
+				return false;
+			}
+			break;
 		}
-		m_cContainer->Lock();
+		LockData();
 		bIsFifoFull = ((CSHMData *)m_cData)->IsFifoFullForReader();
 		// bListen == true means bWait == true
 		bRet = ((CSHMData *)m_cData)->GetData(pData, dTime, &m_dTmpStep, &bListen);
 		// bListen will be set to false if we don't need to wait anymore
-		m_cContainer->Unlock();
+		UnlockData();
 	}
 	// If the FIFO is considered as full for this reader
 	// then the writer is probably waiting
-	if (bIsFifoFull) {
-		m_cContainer->Lock();
-		int nListeners = ((CSHMData *)m_cData)->GetWriterListen();
+	if (bIsFifoFull || m_bLockFree) {
+		LockData();
+		int nListeners = ((CSHMData *)m_cData)->ResetWriterListen();
 		if (nListeners > 0) {
-			m_cWriterListen->Release(nListeners);
-			((CSHMData *)m_cData)->SetWriterListen(0);
+			ReleaseWriterListen(nListeners);
 		}
-		m_cContainer->Unlock();
+		UnlockData();
+	}
+	if (bRet) {
+		cTrace.SetSimTime(*dTime);
 	}
 	return bRet;
 }
@@ -425,63 +415,68 @@ bool isl::CData::GetData(void * pData, double * dOutTime, double dInTime, bool b
 	if (IsConnected() == false) {
 		return false;
 	}
+	CTraceScope cTrace(CTrace::TE_GET_ENTER, m_uTraceName, dInTime);
 	double dOutStep = 0.0;
 	bool bListen = false;
-	m_cContainer->Lock();
+	LockData();
 	bool bWasFifoFull = ((CSHMData *)m_cData)->IsFifoFullForReader();
 	bool bRet = ((CSHMData *)m_cData)->GetData(pData, dOutTime, &dOutStep, dInTime, (bWait ? &bListen : NULL));
-	m_cContainer->Unlock();
+	UnlockData();
 	// The FIFO is considered as empty
 	// Wait until we get a new value in the FIFO
 	while (bListen == true) {
 		// If the FIFO was considered as full for this reader
 		// then the writer is probably waiting
-		if (bWasFifoFull) {
-			m_cContainer->Lock();
-			int nListeners = ((CSHMData *)m_cData)->GetWriterListen();
+		if (bWasFifoFull || m_bLockFree) {
+			LockData();
+			int nListeners = ((CSHMData *)m_cData)->ResetWriterListen();
 			if (nListeners > 0) {
-				m_cWriterListen->Release(nListeners);
-				((CSHMData *)m_cData)->SetWriterListen(0);
+				ReleaseWriterListen(nListeners);
 			}
-			m_cContainer->Unlock();
+			UnlockData();
 		}
 		// Wait for a new value
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLDATA_DEBUG, "GetData locked on t=%gs for '%s'",
 			dInTime, m_sId.c_str());
 #endif
-		if (m_cReaderListen->Acquire() == false) {
+		if (AcquireReaderListen(dInTime) == false) {
 			return false;
 		}
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLDATA_DEBUG, "GetData unlocked on t=%gs for '%s'",
 			dInTime, m_sId.c_str());
 #endif
-		m_cContainer->Lock();
+		LockData();
 		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
-		m_cContainer->Unlock();
+		UnlockData();
 		if (bIsTerminated) {
-			// Simulation ended
-			m_cParent->SetTerminated();
-			return false;
+			// Simulation ended: the values written before the end can still be read
+			LockData();
+			bRet = ((CSHMData *)m_cData)->GetData(pData, dOutTime, &dOutStep, dInTime, NULL);
+			UnlockData();
+			if (bRet == false) {
+				m_cParent->SetTerminated();
+				return false;
+			}
+			break;
 		}
-		m_cContainer->Lock();
+		LockData();
 		bWasFifoFull = ((CSHMData *)m_cData)->IsFifoFullForReader();
 		// bListen == true means bWait == true
 		bRet = ((CSHMData *)m_cData)->GetData(pData, dOutTime, &dOutStep, dInTime, &bListen);
 		// bListen will be set to false if we don't need to wait anymore
-		m_cContainer->Unlock();
+		UnlockData();
 	}
 	// If the FIFO was considered as full for this reader
 	// then the writer is probably waiting
-	if (bWasFifoFull) {
-		m_cContainer->Lock();
-		int nListeners = ((CSHMData *)m_cData)->GetWriterListen();
+	if (bWasFifoFull || m_bLockFree) {
+		LockData();
+		int nListeners = ((CSHMData *)m_cData)->ResetWriterListen();
 		if (nListeners > 0) {
-			m_cWriterListen->Release(nListeners);
-			((CSHMData *)m_cData)->SetWriterListen(0);
+			ReleaseWriterListen(nListeners);
 		}
-		m_cContainer->Unlock();
+		UnlockData();
 	}
 	// If an event data is received => outtime is now intime
 	if (*dOutTime == EVENT_DEF_TIME_VAL) {
@@ -520,70 +515,278 @@ bool isl::CData::GetDataAndStep(void * pData, double * dTime, double * dStep, bo
 	return bRet;
 }
 
+int isl::CData::SetDataBatch(void * pData, double * dTimes, double * dSteps, int nCount, bool bWait)
+{
+	if ((IsConnected() == false) || (pData == NULL) || (dTimes == NULL)) {
+		return -1;
+	}
+	int nSize = ((CSHMData *)m_cData)->GetSizeType() * ((CSHMData *)m_cData)->GetSize();
+	int nDone = 0;
+	while (nDone < nCount) {
+		bool bListen = false;
+		LockData();
+		int nSet = ((CSHMData *)m_cData)->SetDataBatch((char *)pData + nDone * nSize, dTimes + nDone,
+			(dSteps == NULL ? NULL : dSteps + nDone), nCount - nDone, (bWait ? &bListen : NULL));
+		UnlockData();
+		if (nSet > 0) {
+			nDone += nSet;
+			// If readers are waiting then unlock them, once for all the values published
+			if (((CSHMData *)m_cData)->IsDeferred() == false) {
+				WakeReaders();
+			}
+			continue;
+		}
+		if (bListen == false) {
+			// The FIFO is full and we shall not wait
+			break;
+		}
+		// Wait until the FIFO is not full anymore
+#ifdef ISL_DEBUG
+		AppLogDebug(2, ISLDATA_DEBUG, "SetDataBatch locked on t=%gs for '%s'",
+			dTimes[nDone], m_sId.c_str());
+#endif
+		if (((CSHMData *)m_cData)->IsDeferred()) {
+			// The readers may wait for the values of the frame to free some space
+			m_cParent->CommitFrame(true);
+		}
+		if (AcquireWriterListen() == false) {
+			break;
+		}
+		LockData();
+		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
+		UnlockData();
+		if (bIsTerminated) {
+			// Simulation ended
+			m_cParent->SetTerminated();
+			break;
+		}
+	}
+	return nDone;
+}
+
+int isl::CData::GetDataBatch(void * pData, double * dTimes, double * dSteps, int nCount, bool bWait)
+{
+	if ((IsConnected() == false) || (pData == NULL)) {
+		return -1;
+	}
+	bool bListen = false;
+	LockData();
+	bool bIsFifoFull = ((CSHMData *)m_cData)->IsFifoFullForReader();
+	int nRet = ((CSHMData *)m_cData)->GetDataBatch(pData, dTimes, dSteps, nCount, (bWait ? &bListen : NULL));
+	UnlockData();
+	// The FIFO is empty
+	// Wait until we get at least one new value in the FIFO
+	while (bListen == true) {
+		if (AcquireReaderListen() == false) {
+			return 0;
+		}
+		LockData();
+		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
+		UnlockData();
+		if (bIsTerminated) {
+			// Simulation ended: the values written before the end can still be read
+			LockData();
+			nRet = ((CSHMData *)m_cData)->GetDataBatch(pData, dTimes, dSteps, nCount, NULL);
+			UnlockData();
+			if (nRet == 0) {
+				m_cParent->SetTerminated();
+				return 0;
+			}
+			break;
+		}
+		LockData();
+		bIsFifoFull = ((CSHMData *)m_cData)->IsFifoFullForReader();
+		// bListen == true means bWait == true
+		nRet = ((CSHMData *)m_cData)->GetDataBatch(pData, dTimes, dSteps, nCount, &bListen);
+		// bListen will be set to false if we don't need to wait anymore
+		UnlockData();
+	}
+	// If the FIFO is considered as full for this reader
+	// then the writer is probably waiting
+	if (bIsFifoFull || m_bLockFree) {
+		LockData();
+		int nListeners = ((CSHMData *)m_cData)->ResetWriterListen();
+		if (nListeners > 0) {
+			ReleaseWriterListen(nListeners);
+		}
+		UnlockData();
+	}
+	return nRet;
+}
+
+void * isl::CData::ReserveSlot(bool bWait)
+{
+	if (IsConnected() == false) {
+		return NULL;
+	}
+	bool bListen = false;
+	LockData();
+	void * pSlot = ((CSHMData *)m_cData)->ReserveSlot(bWait ? &bListen : NULL);
+	UnlockData();
+	// Wait until the FIFO is not full anymore
+	while (bListen == true) {
+		if (((CSHMData *)m_cData)->IsDeferred()) {
+			// The readers may wait for the values of the frame to free some space
+			m_cParent->CommitFrame(true);
+		}
+		if (AcquireWriterListen() == false) {
+			return NULL;
+		}
+		LockData();
+		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
+		UnlockData();
+		if (bIsTerminated) {
+			// Simulation ended
+			m_cParent->SetTerminated();
+			return NULL;
+		}
+		LockData();
+		pSlot = ((CSHMData *)m_cData)->ReserveSlot(&bListen);
+		UnlockData();
+	}
+	return pSlot;
+}
+
+bool isl::CData::CommitSlot(double dTime)
+{
+	return CommitSlot(dTime, m_dOriginalStep);
+}
+
+bool isl::CData::CommitSlot(double dTime, double dStep)
+{
+	if (IsConnected() == false) {
+		return false;
+	}
+	LockData();
+	bool bRet = ((CSHMData *)m_cData)->CommitSlot(dTime, dStep);
+	UnlockData();
+	// If readers are waiting then unlock them, unless the value belongs to a frame
+	if (bRet && (((CSHMData *)m_cData)->IsDeferred() == false)) {
+		WakeReaders();
+	}
+	return bRet;
+}
+
+const void * isl::CData::AcquireReadSlot(double * dTime, bool bWait)
+{
+	if (IsConnected() == false) {
+		return NULL;
+	}
+	bool bListen = false;
+	LockData();
+	void * pSlot = ((CSHMData *)m_cData)->AcquireReadSlot(dTime, &m_dTmpStep, (bWait ? &bListen : NULL));
+	UnlockData();
+	// The FIFO is empty
+	// Wait until we get a new value in the FIFO
+	while (bListen == true) {
+		if (AcquireReaderListen() == false) {
+			return NULL;
+		}
+		LockData();
+		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
+		UnlockData();
+		if (bIsTerminated) {
+			// Simulation ended: the values written before the end can still be read
+			LockData();
+			pSlot = ((CSHMData *)m_cData)->AcquireReadSlot(dTime, &m_dTmpStep, NULL);
+			UnlockData();
+			if (pSlot == NULL) {
+				m_cParent->SetTerminated();
+			}
+			return pSlot;
+		}
+		LockData();
+		pSlot = ((CSHMData *)m_cData)->AcquireReadSlot(dTime, &m_dTmpStep, &bListen);
+		UnlockData();
+	}
+	return pSlot;
+}
+
+bool isl::CData::ReleaseReadSlot()
+{
+	if (IsConnected() == false) {
+		return false;
+	}
+	LockData();
+	bool bIsFifoFull = ((CSHMData *)m_cData)->IsFifoFullForReader();
+	bool bRet = ((CSHMData *)m_cData)->ReleaseReadSlot();
+	UnlockData();
+	// If the FIFO was considered as full for this reader
+	// then the writer is probably waiting
+	if (bRet && (bIsFifoFull || m_bLockFree)) {
+		LockData();
+		int nListeners = ((CSHMData *)m_cData)->ResetWriterListen();
+		if (nListeners > 0) {
+			ReleaseWriterListen(nListeners);
+		}
+		UnlockData();
+	}
+	return bRet;
+}
+
+void isl::CData::SetDeferred(bool bVal)
+{
+	if (IsConnected()) {
+		((CSHMData *)m_cData)->SetDeferred(bVal);
+	}
+}
+
+bool isl::CData::Commit()
+{
+	if (IsConnected() == false) {
+		return false;
+	}
+	LockData();
+	bool bRet = ((CSHMData *)m_cData)->Commit();
+	UnlockData();
+	if (bRet) {
+		WakeReaders();
+	}
+	return bRet;
+}
+
 bool isl::CData::SetEventData(void * pData, bool bWait)
 {
 	if (IsConnected() == false) {
 		return false;
 	}
 	bool bListen = false;
-	m_cContainer->Lock();
+	LockData();
 	bool bRet = ((CSHMData *)m_cData)->SetData(pData, EVENT_DEF_TIME_VAL, (bWait ? &bListen : NULL));
-	m_cContainer->Unlock();
+	UnlockData();
 	// Wait until the FIFO is not full anymore
 	while (bListen == true) {
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLDATA_DEBUG, "SetEventData locked on for '%s'", m_sId.c_str());
 #endif
-		if (m_cWriterListen->Acquire() == false) {
+		if (((CSHMData *)m_cData)->IsDeferred()) {
+			// The readers may wait for the values of the frame to free some space
+			m_cParent->CommitFrame(true);
+		}
+		if (AcquireWriterListen() == false) {
 			return false;
 		}
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLDATA_DEBUG, "SetData unlocked on for '%s'", m_sId.c_str());
 #endif
-		m_cContainer->Lock();
+		LockData();
 		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
-		m_cContainer->Unlock();
+		UnlockData();
 		if (bIsTerminated) {
 			// Simulation ended
 			m_cParent->SetTerminated();
 			return false;
 		}
-		m_cContainer->Lock();
+		LockData();
 		// bListen == true means bWait == true
 		bRet = ((CSHMData *)m_cData)->SetData(pData, EVENT_DEF_TIME_VAL, &bListen);
 		// bListen will be set to false if we don't need to wait anymore
-		m_cContainer->Unlock();
-	}
-	// If readers are waiting then unlock them
-	m_cContainer->Lock();
-	int nListeners = ((CSHMData *)m_cData)->GetReaderListen();
-#if 0 // TODO: verify the code below
-	int nListenersToSet = nListeners;
-#endif
-	int nReaders = ((CSHMData *)m_cData)->GetReaders();
-	if (nReaders > 1) {
-		// More than one reader, then we should release the semaphore
-		// for all readers even if they are not locked
-#if 0 // TODO: verify the code below
-		if (((nListeners + nReaders > 0) && (nListeners < 0))
-			|| ((nListeners - nReaders < 0) && (nListeners > 0))) {
-			nListeners = nReaders;
-		}
-#else
-		if ((nListeners - nReaders < 0) && (nListeners > 0)) {
-			nListeners = nReaders;
-		}
-#endif
+		UnlockData();
 	}
-	if (nListeners > 0) {
-		m_cReaderListen->Release(nListeners);
-#if 0 // TODO: verify the code below
-		((CSHMData *)m_cData)->SetReaderListen(nListenersToSet - nListeners);
-#else
-		((CSHMData *)m_cData)->SetReaderListen(0);
-#endif
+	// If readers are waiting then unlock them, unless the value belongs to a frame
+	if (((CSHMData *)m_cData)->IsDeferred() == false) {
+		WakeReaders();
 	}
-	m_cContainer->Unlock();
 	return bRet;
 }
 
@@ -594,41 +797,46 @@ bool isl::CData::GetEventData(void * pData, bool bWait)
 	}
 	double dTime = 0.0;
 	bool bListen = false;
-	m_cContainer->Lock();
+	LockData();
 	bool bIsFifoFull = ((CSHMData *)m_cData)->IsFifoFullForReader();
 	bool bRet = ((CSHMData *)m_cData)->GetData(pData, &dTime, &m_dTmpStep, (bWait ? &bListen : NULL));
-	m_cContainer->Unlock();
+	UnlockData();
 	// The FIFO is empty
 	// Wait until we get a new value in the FIFO
 	while (bListen == true) {
-		if (m_cReaderListen->Acquire() == false) {
+		if (AcquireReaderListen() == false) {
 			return false;
 		}
-		m_cContainer->Lock();
+		LockData();
 		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
-		m_cContainer->Unlock();
+		UnlockData();
 		if (bIsTerminated) {
-			// Simulation ended
-			m_cParent->SetTerminated();
-			return false;
+			// Simulation ended: the values written before the end can still be read
+			LockData();
+			bRet = ((CSHMData *)m_cData)->GetData(pData, &dTime, &m_dTmpStep, NULL);
+			UnlockData();
+			if (bRet == false) {
+				m_cParent->SetTerminated();
+				return false;
+			}
+			break;
 		}
-		m_cContainer->Lock();
+		LockData();
 		bIsFifoFull = ((CSHMData *)m_cData)->IsFifoFullForReader();
 		// bListen == true means bWait == true
 		bRet = ((CSHMData *)m_cData)->GetData(pData, &dTime, &m_dTmpStep, &bListen);
 		// bListen will be set to false if we don't need to wait anymore
-		m_cContainer->Unlock();
+		UnlockData();
 	}
 	// If the FIFO is considered as full for this reader
 	// then the writer is probably waiting
-	if (bIsFifoFull) {
-		m_cContainer->Lock();
-		int nListeners = ((CSHMData *)m_cData)->GetWriterListen();
+	if (bIsFifoFull || m_bLockFree) {
+		LockData();
+		int nListeners = ((CSHMData *)m_cData)->ResetWriterListen();
 		if (nListeners > 0) {
-			m_cWriterListen->Release(nListeners);
-			((CSHMData *)m_cData)->SetWriterListen(0);
+			ReleaseWriterListen(nListeners);
 		}
-		m_cContainer->Unlock();
+		UnlockData();
 	}
 	return bRet;
 }
@@ -638,9 +846,9 @@ bool isl::CData::SetData(void * pData, double dTime, int nInd)
 	if (IsConnected() == false) {
 		return false;
 	}
-	m_cContainer->Lock();
+	LockData();
 	bool bRet = ((CSHMData *)m_cData)->SetData(pData, dTime, nInd);
-	m_cContainer->Unlock();
+	UnlockData();
 	return bRet;
 }
 
@@ -649,9 +857,9 @@ bool isl::CData::GetData(void * pData, double * dTime, int nInd)
 	if (IsConnected() == false) {
 		return false;
 	}
-	m_cContainer->Lock();
+	LockData();
 	bool bRet = ((CSHMData *)m_cData)->GetData(pData, dTime, nInd);
-	m_cContainer->Unlock();
+	UnlockData();
 	return bRet;
 }
 
@@ -749,12 +957,27 @@ int isl::CData::Connect(bool bWait, int nTimeOut)
 	std::string sSession = m_cParent->GetSessionId();
 	std::string sSHM(boost::str(boost::format(SHM_KEY_ID) % sSession % m_sConnectId));
 	bool bIsGlobalIPC = CAppSettings().IsGlobalIPC();
-	CSHM * cMem = 0;
-	if (CAppSettings().IsISLCompatible()) {
-		cMem = new CSHM(sSHM, "qipc_sharedmemory_", bIsGlobalIPC);
-	}
-	else {
-		cMem = new CSHM(sSHM, bIsGlobalIPC);
+	// Identifiers allocated for the session: no key file nor hash per object
+	CSessionKeys * cKeys = m_cParent->GetSessionKeys();
+	// The connector tries again with the same memory object
+	bool bAttachPending = (m_cAttachPending != 0);
+	CSHM * cMem = m_cAttachPending;
+	m_cAttachPending = 0;
+	if (cMem == 0) {
+		unsigned int uId = (cKeys != 0 ? cKeys->GetId(m_sConnectId, CSessionKeys::KEY_SHM) : 0);
+		if (CAppSettings().IsISLCompatible()) {
+			cMem = new CSHM(sSHM, "qipc_sharedmemory_", bIsGlobalIPC);
+		}
+		else {
+			if (uId != 0) {
+				cMem = new CSHM(uId, bIsGlobalIPC);
+			}
+			else {
+				cMem = new CSHM(sSHM, bIsGlobalIPC);
+			}
+			cMem->SetBackend(CSHM::GetBackendFromStr(CAppSettings().GetSHMBackend()),
+				m_bHugePages || CAppSettings().IsSHMHugePages());
+		}
 	}
 	if (m_bManager) {
 		AppLogInfo(ISLDATA_CONNECT_CREATESHM, "Variable '%s': creating the shared memory '%s'...",
@@ -768,6 +991,10 @@ int isl::CData::Connect(bool bWait, int nTimeOut)
 			return -2;
 		}
 		// Create the SHM
+		if (m_eNumaPolicy != NP_DEFAULT) {
+			cMem->SetNumaPolicy((m_eNumaPolicy == NP_BIND ? CSHM::NUMA_BIND : CSHM::NUMA_INTERLEAVE),
+				m_nNumaNode);
+		}
 		if (cMem->Create(nSize, CSHM::READWRITE) == false) {
 			AppLogError(ISLDATA_FAILED_CREATESHM,
 				"Variable '%s': Failed to create the shared memory. %d-%d",
@@ -775,38 +1002,65 @@ int isl::CData::Connect(bool bWait, int nTimeOut)
 			delete cMem;
 			return -3;
 		}
+		if (m_bHugePages || (m_eNumaPolicy != NP_DEFAULT)) {
+			if (m_bHugePages && (cMem->IsHugePages() == false)) {
+				AppLogWarning(ISLDATA_CONNECT_HUGEPAGESNOTUSED,
+					"Variable '%s': no huge pages available for %d bytes, the regular pages are used.",
+					m_sId.c_str(), nSize);
+			}
+			if ((m_eNumaPolicy != NP_DEFAULT) && (cMem->IsNumaApplied() == false)) {
+				AppLogWarning(ISLDATA_CONNECT_NUMANOTAPPLIED,
+					"Variable '%s': failed to apply the NUMA policy '%s'. Error: %d",
+					m_sId.c_str(), GetNumaPolicyAsStr().c_str(), cMem->GetError());
+			}
+			AppLogInfo(ISLDATA_CONNECT_PLACEMENT,
+				"Variable '%s': shared memory of %d bytes, huge pages: %s, NUMA policy: %s, NUMA node: %d.",
+				m_sId.c_str(), nSize, (cMem->IsHugePages() ? "true" : "false"),
+				GetNumaPolicyAsStr().c_str(), cMem->GetNumaNode());
+		}
 	}
 	else {
-		AppLogInfo(ISLDATA_CONNECT_CONNECTSHM, "Variable '%s': connecting to the shared memory '%s'...",
-			m_sId.c_str(), sSHM.c_str());
-		// Connect to the SHM
-		bool bContinueToListen = true;
-		int nTime = 0;
-		while (bContinueToListen) {
-			if (cMem->Attach(CSHM::READWRITE) == false) {
-				CSHM::tStatus eState = cMem->GetStatus();
-				if ((eState != CSHM::NOTFOUND) && (eState != CSHM::SUCCESS)) {
-					AppLogError(ISLDATA_FAILED_CONNECTSHM,
-						"Variable '%s': Failed to connect to the shared memory. %d-%d",
-						m_sId.c_str(), eState, cMem->GetError());
-					delete cMem;
-					return -4;
-				}
-				if (bWait == false) {
-					return 3;
-				}
-				CThread::Sleep(500); // Wait for 500ms before trying again
-				if (nTimeOut > 0) {
-					nTime += 500;
-					if (nTime >= nTimeOut * 1000) {
-						delete cMem;
-						return 3;
-					}
-				}
+		// Only once when the connector tries again
+		if (bAttachPending == false) {
+			AppLogInfo(ISLDATA_CONNECT_CONNECTSHM, "Variable '%s': connecting to the shared memory '%s'...",
+				m_sId.c_str(), sSHM.c_str());
+		}
+		// Connect to the SHM: the writer publishes it when created. The attachment is
+		// still tried periodically for the writers not publishing (ISL compatible).
+		CPublish * cPublish = (bWait ? m_cParent->GetPublish() : 0);
+		std::chrono::steady_clock::time_point tpEnd = std::chrono::steady_clock::now() +
+			std::chrono::seconds(nTimeOut > 0 ? nTimeOut : 0);
+		while (true) {
+			unsigned int uGeneration = (cPublish != 0 ? cPublish->GetGeneration() : 0);
+			if (cMem->Attach(CSHM::READWRITE)) {
+				// Found
+				break;
+			}
+			CSHM::tStatus eState = cMem->GetStatus();
+			if ((eState != CSHM::NOTFOUND) && (eState != CSHM::SUCCESS)) {
+				AppLogError(ISLDATA_FAILED_CONNECTSHM,
+					"Variable '%s': Failed to connect to the shared memory. %d-%d",
+					m_sId.c_str(), eState, cMem->GetError());
+				delete cMem;
+				return -4;
+			}
+			int nWait = ATTACH_CHECK_PERIOD;
+			if (nTimeOut > 0) {
+				int nLeft = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+					tpEnd - std::chrono::steady_clock::now()).count();
+				nWait = (nLeft < nWait ? nLeft : nWait);
+			}
+			if ((bWait == false) || (nWait <= 0)) {
+				// Deleting the memory object would remove its lock semaphore, even if the writer uses it
+				m_cAttachPending = cMem;
+				m_bIsConnected = false;
+				return 3;
+			}
+			if (cPublish != 0) {
+				cPublish->Wait(uGeneration, nWait);
 			}
 			else {
-				// Found
-				bContinueToListen = false;
+				CThread::Sleep(nWait);
 			}
 		}
 	}
@@ -818,6 +1072,9 @@ int isl::CData::Connect(bool bWait, int nTimeOut)
 	}
 	CSHMData * cData = new CSHMData(cMem->Data(), this);
 	if (m_bManager) {
+		// In latest mode the readers validate the values by themselves: no lock is needed
+		m_bLockFree = m_cParent->IsLockFree() || (m_eMode == MD_LATEST);
+		m_bFutex = m_cParent->IsFutex();
 		cMem->Lock();
 		if (cData->Initialize() == false) {
 			AppLogError(ISLDATA_FAILED_INITSHM,
@@ -826,36 +1083,113 @@ int isl::CData::Connect(bool bWait, int nTimeOut)
 			return -6;
 		}
 		cMem->Unlock();
+		// Listed before the readers waiting for this variable are released
+		CManifest * cManifest = m_cParent->GetManifest();
+		if ((cManifest != 0) && (m_sConnectId.size() < MANIFEST_CONNECTID_SIZE)) {
+			tsManifestEntry stEntry;
+			memset(&stEntry, 0, sizeof(stEntry));
+			stEntry.uType = (unsigned int)GetTypeId();
+			stEntry.uSize = (unsigned int)GetType()->GetSize();
+			stEntry.uSizeOf = (unsigned int)GetType()->GetSizeOf();
+			stEntry.uFifoDepth = GetFifoDepth();
+			stEntry.uMode = (unsigned int)m_eMode;
+			stEntry.uWriter = m_cParent->GetUId();
+			stEntry.uSegmentId = cMem->GetId();
+			stEntry.uSegmentSize = (unsigned int)cMem->Size();
+			stEntry.uOffset = 0; // One shared memory per variable
+			memcpy(stEntry.sConnectId, m_sConnectId.c_str(), m_sConnectId.size() + 1);
+			m_nManifest = cManifest->Append(stEntry);
+			if (m_nManifest < 0) {
+				AppLogWarning(ISLDATA_MANIFEST_FULL,
+					"Variable '%s': the manifest of the session is full, the variable is not listed.",
+					m_sId.c_str());
+			}
+		}
+		// The readers waiting for this variable can attach it
+		CPublish * cPublish = m_cParent->GetPublish();
+		if (cPublish != 0) {
+			cPublish->Publish();
+		}
 	}
 	else {
 		cMem->Lock();
-		cData->SetReader();
+		// The writer may not have initialized the shared memory yet
+		while (cData->IsInitialized() == false) {
+			cMem->Unlock();
+			CThread::Sleep(10);
+			cMem->Lock();
+		}
+		if (cData->IsCompatible() == false) {
+			AppLogError(ISLDATA_WRONG_SHMLAYOUT,
+				"Variable '%s': the shared memory layout does not match the writer one (version or settings).",
+				m_sId.c_str());
+			cMem->Unlock();
+			return -7;
+		}
+		if (cData->IsLatest() != (m_eMode == MD_LATEST)) {
+			AppLogWarning(ISLDATA_CONNECT_MODEMISMATCH,
+				"Variable '%s': the mode differs from the writer one, the mode '%s' is used.",
+				m_sId.c_str(), GetModeStr(cData->IsLatest() ? MD_LATEST : MD_FIFO).c_str());
+			m_eMode = (cData->IsLatest() ? MD_LATEST : MD_FIFO);
+		}
+		if (cData->SetReader(m_cParent->GetUId()) == false) {
+			AppLogError(ISLDATA_CONNECT_NOREADERSLOT,
+				"Variable '%s': no reader slot available (%d readers maximum).",
+				m_sId.c_str(), GetMaxReaders());
+			cMem->Unlock();
+			return -8;
+		}
+		m_eBackPressure = cData->GetBackPressure();
+		m_bLockFree = cData->IsLockFree();
+		m_bFutex = cData->IsFutex();
 		cMem->Unlock();
 	}
 	m_cData = cData;
-	// Create or open the semaphores
-	std::string sSem(boost::str(boost::format(SEM_WR_KEY_ID) % sSession % m_sConnectId));
-	CSem * cSem = 0;
-	if (CAppSettings().IsISLCompatible()) {
-		cSem = new CSem(sSem, "qipc_systemsem_", 0, CSem::CREATE, bIsGlobalIPC);
-	}
-	else {
-		cSem = new CSem(sSem, 0, CSem::CREATE, bIsGlobalIPC);
-	}
-	// If the semaphore is already created, it will connect in open mode.
-	cSem->SetTimeout(m_nSyncTimeout);
-	m_cWriterListen = cSem;
-	sSem = boost::str(boost::format(SEM_RD_KEY_ID) % sSession % m_sConnectId);
-	cSem = 0;
-	if (CAppSettings().IsISLCompatible()) {
-		cSem = new CSem(sSem, "qipc_systemsem_", 0, CSem::CREATE, bIsGlobalIPC);
+	// The writer wakes up periodically to check the readers are still alive
+	int nWriterTimeout = m_nSyncTimeout;
+	if ((nWriterTimeout <= 0) || (nWriterTimeout > READERS_CHECK_PERIOD)) {
+		nWriterTimeout = READERS_CHECK_PERIOD;
+	}
+	if (m_bFutex) {
+		// The waiters sleep on words of the shared memory
+		m_cWriterWake = new CFutex(cData->GetWriterWake());
+		m_cWriterWake->SetTimeout(nWriterTimeout);
+		m_cReaderWake = new CFutex(cData->GetReaderWake());
+		m_cReaderWake->SetTimeout(m_nSyncTimeout);
 	}
 	else {
-		cSem = new CSem(sSem, 0, CSem::CREATE, bIsGlobalIPC);
+		// Create or open the semaphores
+		std::string sSem(boost::str(boost::format(SEM_WR_KEY_ID) % sSession % m_sConnectId));
+		unsigned int uId = (cKeys != 0 ? cKeys->GetId(m_sConnectId, CSessionKeys::KEY_SEM_WRITER) : 0);
+		CSem * cSem = 0;
+		if (CAppSettings().IsISLCompatible()) {
+			cSem = new CSem(sSem, "qipc_systemsem_", 0, CSem::CREATE, bIsGlobalIPC);
+		}
+		else if (uId != 0) {
+			cSem = new CSem(uId, 0, CSem::CREATE, bIsGlobalIPC);
+		}
+		else {
+			cSem = new CSem(sSem, 0, CSem::CREATE, bIsGlobalIPC);
+		}
+		// If the semaphore is already created, it will connect in open mode.
+		cSem->SetTimeout(nWriterTimeout);
+		m_cWriterListen = cSem;
+		sSem = boost::str(boost::format(SEM_RD_KEY_ID) % sSession % m_sConnectId);
+		uId = (cKeys != 0 ? cKeys->GetId(m_sConnectId, CSessionKeys::KEY_SEM_READER) : 0);
+		cSem = 0;
+		if (CAppSettings().IsISLCompatible()) {
+			cSem = new CSem(sSem, "qipc_systemsem_", 0, CSem::CREATE, bIsGlobalIPC);
+		}
+		else if (uId != 0) {
+			cSem = new CSem(uId, 0, CSem::CREATE, bIsGlobalIPC);
+		}
+		else {
+			cSem = new CSem(sSem, 0, CSem::CREATE, bIsGlobalIPC);
+		}
+		cSem->SetTimeout(m_nSyncTimeout);
+		// If the semaphore is already created, it will connect in open mode.
+		m_cReaderListen = cSem;
 	}
-	cSem->SetTimeout(m_nSyncTimeout);
-	// If the semaphore is already created, it will connect in open mode.
-	m_cReaderListen = cSem;
 	// Compute method?
 #if 0 // TODO: to add
 	if (GetComputeType() != COMPUTE_TYPE_NOTYPE) {
@@ -873,43 +1207,76 @@ int isl::CData::Connect(bool bWait, int nTimeOut)
 
 bool isl::CData::Disconnect()
 {
+	if (m_nManifest >= 0) {
+		CManifest * cManifest = m_cParent->GetManifest();
+		if (cManifest != 0) {
+			cManifest->Remove(m_nManifest);
+		}
+	}
+	m_nManifest = -1;
 	// Disconnect and delete the semaphores
-	if (m_cReaderListen != NULL) {
+	// Only the writer ends the channel: a reader leaves the other readers and
+	// the writer going on, so that a tool can connect again later
+	if ((m_cReaderListen != NULL) || (m_cReaderWake != NULL)) {
 		m_cContainer->Lock();
-		int nListeners = ((CSHMData *)m_cData)->GetReaderListen();
-		((CSHMData *)m_cData)->SetTerminated();
-		if (nListeners > 0) { // Release all listeners
+		if (m_bManager) {
+			((CSHMData *)m_cData)->SetTerminated();
+			int nListeners = ((CSHMData *)m_cData)->ResetReaderListen();
+			if (nListeners > 0) { // Release all listeners
 #ifdef ISL_DEBUG
-			AppLogDebug(2, ISLDATA_DEBUG, "READERLISTEN unlock all for %s: %d",
-				m_sId.c_str(), nListeners);
+				AppLogDebug(2, ISLDATA_DEBUG, "READERLISTEN unlock all for %s: %d",
+					m_sId.c_str(), nListeners);
 #endif
-			m_cReaderListen->Release(nListeners);
-			((CSHMData *)m_cData)->SetReaderListen(0);
+				ReleaseReaderListen(nListeners);
+			}
+		}
+		else {
+			// The slot can be used by another reader
+			((CSHMData *)m_cData)->ReleaseReader();
 		}
 		m_cContainer->Unlock();
-		// Wait few milliseconds before deleting
-		CThread::Sleep(200);
-		delete m_cReaderListen;
+		if (m_cReaderListen != NULL) {
+			// Wait few milliseconds before deleting
+			CThread::Sleep(200);
+			delete m_cReaderListen;
+		}
+		if (m_cReaderWake != NULL) {
+			delete m_cReaderWake;
+		}
 	}
 	m_cReaderListen = NULL;
-	if (m_cWriterListen != NULL) {
+	m_cReaderWake = NULL;
+	if ((m_cWriterListen != NULL) || (m_cWriterWake != NULL)) {
 		m_cContainer->Lock();
-		int nListeners = ((CSHMData *)m_cData)->GetWriterListen();
-		((CSHMData *)m_cData)->SetTerminated();
+		if (m_bManager) {
+			((CSHMData *)m_cData)->SetTerminated();
+		}
+		// A writer waiting for the slot of this reader checks the FIFO again
+		int nListeners = ((CSHMData *)m_cData)->ResetWriterListen();
 		if (nListeners > 0) { // Release all listeners
 #ifdef ISL_DEBUG
 			AppLogDebug(2, ISLDATA_DEBUG, "WRITERLISTEN unlock all for %s: %d",
 				m_sId.c_str(), nListeners);
 #endif
-			m_cWriterListen->Release(nListeners);
-			((CSHMData *)m_cData)->SetWriterListen(0);
+			ReleaseWriterListen(nListeners);
 		}
 		m_cContainer->Unlock();
-		// Wait few milliseconds before deleting
-		CThread::Sleep(200);
-		delete m_cWriterListen;
+		if (m_bManager) {
+			// The connectors waiting for several inputs see the end of the simulation
+			NotifyReaders();
+		}
+		CloseNotify();
+		if (m_cWriterListen != NULL) {
+			// Wait few milliseconds before deleting
+			CThread::Sleep(200);
+			delete m_cWriterListen;
+		}
+		if (m_cWriterWake != NULL) {
+			delete m_cWriterWake;
+		}
 	}
 	m_cWriterListen = NULL;
+	m_cWriterWake = NULL;
 	bool bRet = true;
 	if (m_cContainer != NULL) {
 		// The status is not changed even if it returns false
@@ -948,12 +1315,21 @@ bool isl::CData::ConnectAsViewer(bool bWait)
 	std::string sSession = m_cParent->GetSessionId();
 	std::string sSHM(boost::str(boost::format(SHM_KEY_ID) % sSession % m_sConnectId));
 	bool bIsGlobalIPC = CAppSettings().IsGlobalIPC();
+	CSessionKeys * cKeys = m_cParent->GetSessionKeys();
+	unsigned int uId = (cKeys != 0 ? cKeys->GetId(m_sConnectId, CSessionKeys::KEY_SHM) : 0);
 	CSHM * cMem = 0;
 	if (CAppSettings().IsISLCompatible()) {
 		cMem = new CSHM(sSHM, "qipc_sharedmemory_", bIsGlobalIPC);
 	}
 	else {
-		cMem = new CSHM(sSHM, bIsGlobalIPC);
+		if (uId != 0) {
+			cMem = new CSHM(uId, bIsGlobalIPC);
+		}
+		else {
+			cMem = new CSHM(sSHM, bIsGlobalIPC);
+		}
+		cMem->SetBackend(CSHM::GetBackendFromStr(CAppSettings().GetSHMBackend()),
+			m_bHugePages || CAppSettings().IsSHMHugePages());
 	}
 	// Connect to the SHM
 	AppLogInfo(ISLDATA_CONNECT_CONNECTSHM,
@@ -1051,6 +1427,47 @@ double isl::CData::GetStepTolerance()
 	return m_dStepTolerance;
 }
 
+bool isl::CData::IsLockFree()
+{
+	return m_bLockFree;
+}
+
+bool isl::CData::IsFutex()
+{
+	return m_bFutex;
+}
+
+unsigned int isl::CData::GetOverruns()
+{
+	if (m_cData == NULL) {
+		return 0;
+	}
+	return ((CSHMData *)m_cData)->GetOverruns();
+}
+
+unsigned int isl::CData::GetDropped()
+{
+	if (m_cData == NULL) {
+		return 0;
+	}
+	return ((CSHMData *)m_cData)->GetDropped();
+}
+
+void isl::CData::LockData()
+{
+	// In lock-free mode, the FIFO indices are published with atomic operations
+	if (m_bLockFree == false) {
+		m_cContainer->Lock();
+	}
+}
+
+void isl::CData::UnlockData()
+{
+	if (m_bLockFree == false) {
+		m_cContainer->Unlock();
+	}
+}
+
 void isl::CData::InitOnCheck()
 {
 	AppLogDebug(2, ISLDATA_DEBUG, "Variable '%s': data parameters initialization.", m_sId.c_str());
@@ -1061,6 +1478,240 @@ void isl::CData::InitOnCheck()
 		if (m_dOriginalStep <= 0.0) {
 			m_dOriginalStep = m_cParent->GetStepSize();
 		}
+		if (m_eWaitPolicy == WP_DEFAULT) {
+			m_eWaitPolicy = m_cParent->GetWaitPolicy();
+		}
+		if (m_nSpinCount < 0) {
+			m_nSpinCount = m_cParent->GetSpinCount();
+		}
 	}
 	m_dTmpStep = 0.0;
 }
+
+bool isl::CData::AcquireListen(CSem * cListen, CFutex * cWake)
+{
+	if (m_eWaitPolicy != WP_BLOCK) {
+		if (PollListen(cListen, cWake)) {
+			return true;
+		}
+		if ((m_eWaitPolicy == WP_BUSYPOLL) || ((CSHMData *)m_cData)->IsTerminated()) {
+			return false;
+		}
+	}
+	if (cWake != NULL) {
+		// No semaphore removal will wake us up: the termination is checked once registered.
+		// A release done before the termination is still consumed.
+		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
+		if (cWake->TryAcquire()) {
+			return true;
+		}
+		if (bIsTerminated) {
+			return false;
+		}
+		return cWake->Acquire();
+	}
+	// Same for the semaphores: the removal may have been done before the registration
+	bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
+	if (cListen->TryAcquire()) {
+		return true;
+	}
+	if (bIsTerminated) {
+		return false;
+	}
+	return cListen->Acquire();
+}
+
+bool isl::CData::PollListen(CSem * cListen, CFutex * cWake)
+{
+	// The release is usually done within a few microseconds when the co-simulators
+	// run on dedicated cores: polling avoids the cost of sleeping and waking up.
+	// On a single core, the time slice is given back so that the other side can run.
+	bool bPause = (m_eWaitPolicy != WP_SPIN);
+	static const bool bSingleCore = (CThread::GetNbCores() == 1);
+	std::chrono::steady_clock::time_point tpEnd;
+	if (m_nSyncTimeout > 0) {
+		tpEnd = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_nSyncTimeout);
+	}
+	// A busy polling writer never sleeps: the readers are checked from time to time
+	bool bCheckReaders = (m_eWaitPolicy == WP_BUSYPOLL) &&
+		(cListen == m_cWriterListen) && (cWake == m_cWriterWake);
+	std::chrono::steady_clock::time_point tpCheck;
+	if (bCheckReaders) {
+		tpCheck = std::chrono::steady_clock::now() + std::chrono::milliseconds(READERS_CHECK_PERIOD);
+	}
+	for (int i = 1; (m_eWaitPolicy == WP_BUSYPOLL) || (i <= m_nSpinCount); i++) {
+		bool bIsTerminated = ((CSHMData *)m_cData)->IsTerminated();
+		if (cWake != NULL) {
+			if (cWake->TryAcquire()) {
+				return true;
+			}
+		}
+		else {
+			if (cListen->TryAcquire()) {
+				return true;
+			}
+			if (cListen->GetStatus() != CSem::TIMEOUTREACHED) {
+				return false; // Semaphore removed
+			}
+		}
+		if (bIsTerminated) {
+			return false;
+		}
+		if (bSingleCore) {
+			CThread::Reschedule();
+		}
+		else if (bPause) {
+			CAtomic::Pause();
+		}
+		// Check the timeout from time to time only
+		if (((m_nSyncTimeout > 0) || bCheckReaders) && ((i & 0x3FF) == 0)) {
+			std::chrono::steady_clock::time_point tpNow = std::chrono::steady_clock::now();
+			if ((m_nSyncTimeout > 0) && (tpNow >= tpEnd)) {
+				return false;
+			}
+			if (bCheckReaders && (tpNow >= tpCheck)) {
+				if (((CSHMData *)m_cData)->ReclaimReaders() > 0) {
+					return true; // The caller checks the FIFO again
+				}
+				tpCheck = tpNow + std::chrono::milliseconds(READERS_CHECK_PERIOD);
+			}
+		}
+	}
+	return false;
+}
+
+void isl::CData::WakeReaders()
+{
+	LockData();
+	int nListeners = ((CSHMData *)m_cData)->ResetReaderListen();
+#if 0 // TODO: verify the code below
+	int nListenersToSet = nListeners;
+#endif
+	int nReaders = ((CSHMData *)m_cData)->GetReaders();
+	if (nReaders > 1) {
+		// More than one reader, then we should release the semaphore
+		// for all readers even if they are not locked
+#if 0 // TODO: verify the code below
+		if (((nListeners + nReaders > 0) && (nListeners < 0))
+			|| ((nListeners - nReaders < 0) && (nListeners > 0))) {
+			nListeners = nReaders;
+		}
+#else
+		if ((nListeners - nReaders < 0) && (nListeners > 0)) {
+			nListeners = nReaders;
+		}
+#endif
+	}
+	if (nListeners > 0) {
+		ReleaseReaderListen(nListeners);
+#if 0 // TODO: verify the code below
+		((CSHMData *)m_cData)->SetReaderListen(nListenersToSet - nListeners);
+#endif
+	}
+	UnlockData();
+	NotifyReaders();
+}
+
+void isl::CData::AttachNotify()
+{
+	if (IsConnected() && m_bManager) {
+		NotifyReaders(false);
+	}
+}
+
+void isl::CData::NotifyReaders(bool bNotify)
+{
+	int nSlots = ((CSHMData *)m_cData)->GetReaderSlots();
+	if ((int)m_lNotify.size() < nSlots) {
+		m_lNotify.resize(nSlots, NULL);
+		m_lNotifyGen.resize(nSlots, 0);
+	}
+	for (int i = 0; i < nSlots; i++) {
+		unsigned int uGeneration = 0;
+		unsigned int uId = ((CSHMData *)m_cData)->GetReaderNotify(i, &uGeneration);
+		if (uId == 0) {
+			continue;
+		}
+		if (uGeneration != m_lNotifyGen[i]) {
+			// New reader on the slot: the notification of its connector is shared by the outputs
+			m_lNotifyGen[i] = uGeneration;
+			m_lNotify[i] = m_cParent->GetNotify(uId);
+#ifdef ISL_DEBUG
+			if (m_lNotify[i] == NULL) {
+				AppLogDebug(2, ISLDATA_DEBUG, "No notification for the connector %u of reader %d of '%s'",
+					uId, i, m_sId.c_str());
+			}
+#endif
+		}
+		if (bNotify && (m_lNotify[i] != NULL)) {
+			m_lNotify[i]->Notify();
+		}
+	}
+}
+
+void isl::CData::CloseNotify()
+{
+	// The notifications belong to the connector
+	m_lNotify.clear();
+	m_lNotifyGen.clear();
+}
+
+bool isl::CData::AcquireWriterListen(double dTime)
+{
+	CTraceScope cTrace(CTrace::TE_WAIT_BEGIN, m_uTraceName, dTime, 0);
+	// A reader may end without disconnecting while the writer waits for it:
+	// the wait is done by periods and the slots of such readers are reclaimed.
+	int nWaited = 0;
+	while (AcquireListen(m_cWriterListen, m_cWriterWake) == false) {
+		if ((m_eWaitPolicy == WP_BUSYPOLL) || ((CSHMData *)m_cData)->IsTerminated()) {
+			return false;
+		}
+		bool bTimeout = (m_cWriterWake != NULL ?
+			m_cWriterWake->GetStatus() == CFutex::TIMEOUTREACHED :
+			m_cWriterListen->GetStatus() == CSem::TIMEOUTREACHED);
+		if (bTimeout == false) {
+			return false;
+		}
+		if (((CSHMData *)m_cData)->ReclaimReaders() > 0) {
+			// The caller checks the FIFO again
+			return true;
+		}
+		nWaited += READERS_CHECK_PERIOD;
+		if ((m_nSyncTimeout > 0) && (nWaited >= m_nSyncTimeout)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void isl::CData::ReleaseWriterListen(int n)
+{
+	if (CTrace::IsEnabled()) {
+		CTrace::Record(CTrace::TE_WAKEUP, m_uTraceName, -1.0, (unsigned int)n);
+	}
+	if (m_cWriterWake != NULL) {
+		m_cWriterWake->Release(n);
+	}
+	else {
+		m_cWriterListen->Release(n);
+	}
+}
+
+bool isl::CData::AcquireReaderListen(double dTime)
+{
+	CTraceScope cTrace(CTrace::TE_WAIT_BEGIN, m_uTraceName, dTime, 1);
+	return AcquireListen(m_cReaderListen, m_cReaderWake);
+}
+
+void isl::CData::ReleaseReaderListen(int n)
+{
+	if (CTrace::IsEnabled()) {
+		CTrace::Record(CTrace::TE_WAKEUP, m_uTraceName, -1.0, (unsigned int)n);
+	}
+	if (m_cReaderWake != NULL) {
+		m_cReaderWake->Release(n);
+	}
+	else {
+		m_cReaderListen->Release(n);
+	}
+}
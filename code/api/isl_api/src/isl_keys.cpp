@@ -0,0 +1,260 @@
+/*
+ *     Name: isl_keys.cpp
+ *
+ *     Description: ISL API identifiers of the IPC objects of a session.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+
+/*
+ *     Header files
+ */
+
+#include <string.h>
+
+#include <isl_shm.h>
+#include <isl_atomic.h>
+#include <isl_thread.h>
+#include <isl_misc.h>
+
+#include "isl_api.h"
+#include "isl_settings.h"
+#include "isl_keys.h"
+
+
+/*
+ *     Macros and constants definition
+ */
+
+// The keys built by ftok start with 0x49 (project id 73): the identifiers use 0x4A
+#define KEYS_ID_PREFIX		0x4A000000u
+#define KEYS_NB_RANGES		256
+#define KEYS_RANGE_SIZE		0x10000u
+// Identifiers of an entry: shared memory (and its lock), writers and readers semaphores, notification
+#define KEYS_PER_ENTRY		4
+// The first identifiers of the range are used by the table
+#define KEYS_CAPACITY		(KEYS_RANGE_SIZE / KEYS_PER_ENTRY - 1)
+#define KEYS_SESSION_SIZE	128
+#define KEYS_CONNECTID_SIZE	120
+#define KEYS_VERSION		1
+
+// States of the header and of the entries
+#define KEYS_EMPTY			0u
+#define KEYS_WRITING		1u
+#define KEYS_READY			2u
+
+// A process writing an entry only copies few bytes: it is waited for a limited time
+#define KEYS_WAIT_SPINS		1000
+#define KEYS_WAIT_SLEEPS	1000 // milliseconds
+
+
+/*
+ *     Types definition
+ */
+
+typedef struct {
+	unsigned int uState;
+	unsigned int uVersion;
+	unsigned int uCapacity;
+	unsigned int uCount;
+	char sSessionId[KEYS_SESSION_SIZE];
+} tsKeysHeader;
+
+typedef struct {
+	unsigned int uState;
+	unsigned int uHash;
+	char sConnectId[KEYS_CONNECTID_SIZE];
+} tsKeysEntry;
+
+
+/*
+ *     Functions
+ */
+
+// Waits for a process writing a header or an entry, returns the state found
+static unsigned int WaitWritten(unsigned int * pState)
+{
+	unsigned int uState = isl::CAtomic::Load(pState);
+	for (int i = 0; (uState == KEYS_WRITING) && (i < KEYS_WAIT_SPINS + KEYS_WAIT_SLEEPS); i++) {
+		if (i < KEYS_WAIT_SPINS) {
+			isl::CAtomic::Pause();
+		}
+		else {
+			isl::CThread::Sleep(1);
+		}
+		uState = isl::CAtomic::Load(pState);
+	}
+	return uState;
+}
+
+// Attaches the table of the range if it belongs to the session, cTable is NULL otherwise.
+// If bCreate is true, a free range is taken for the session. Returns false on error.
+static bool OpenTable(unsigned int uBase, const std::string & sSessionId, bool bCreate, isl::CSHM ** cTable)
+{
+	*cTable = NULL;
+	int nSize = (int)(sizeof(tsKeysHeader) + KEYS_CAPACITY * sizeof(tsKeysEntry));
+	isl::CSHM * cMem = new isl::CSHM(uBase, isl::CAppSettings().IsGlobalIPC());
+	cMem->SetBackend(isl::CSHM::GetBackendFromStr(isl::CAppSettings().GetSHMBackend()));
+	// The memory is zeroed when created: header to write, empty entries
+	bool bOk = cMem->Attach(isl::CSHM::READWRITE);
+	if ((bOk == false) && (cMem->GetStatus() == isl::CSHM::NOTFOUND)) {
+		if (bCreate == false) {
+			delete cMem;
+			return true;
+		}
+		bOk = cMem->Create(nSize, isl::CSHM::READWRITE);
+		if ((bOk == false) && (cMem->GetStatus() == isl::CSHM::ALREADYEXISTS)) {
+			// Created by another process in the meantime
+			bOk = cMem->Attach(isl::CSHM::READWRITE);
+		}
+	}
+	if ((bOk == false) || (cMem->Data() == NULL)) {
+		delete cMem;
+		return false;
+	}
+	tsKeysHeader * pHeader = (tsKeysHeader *)cMem->Data();
+	unsigned int uState = KEYS_EMPTY;
+	if (bCreate && isl::CAtomic::CompareExchange(&pHeader->uState, uState, KEYS_WRITING)) {
+		pHeader->uVersion = KEYS_VERSION;
+		pHeader->uCapacity = KEYS_CAPACITY;
+		memcpy(pHeader->sSessionId, sSessionId.c_str(), sSessionId.size() + 1);
+		isl::CAtomic::Store(&pHeader->uState, KEYS_READY);
+		uState = KEYS_READY;
+	}
+	else {
+		uState = WaitWritten(&pHeader->uState);
+	}
+	if ((uState == KEYS_READY) && (pHeader->uVersion == KEYS_VERSION) &&
+		(pHeader->uCapacity == KEYS_CAPACITY) && (cMem->Size() >= nSize) &&
+		(strcmp(pHeader->sSessionId, sSessionId.c_str()) == 0)) {
+		*cTable = cMem;
+		return true;
+	}
+	// Range of another session
+	cMem->Detach();
+	delete cMem;
+	return true;
+}
+
+
+/*
+ *     Class CSessionKeys
+ */
+
+isl::CSessionKeys::CSessionKeys()
+{
+	m_cContainer = NULL;
+	m_pData = NULL;
+	m_uBase = 0;
+}
+
+isl::CSessionKeys::~CSessionKeys()
+{
+	Close();
+}
+
+bool isl::CSessionKeys::Open(const std::string & sSessionId)
+{
+	Close();
+	if (sSessionId.empty() || (sSessionId.size() >= KEYS_SESSION_SIZE)) {
+		return false;
+	}
+	// The range is chosen from the session id, the next ones are used by other sessions.
+	// A table is removed with its last process: the table of this session may follow a
+	// free range, so all the ranges are looked for it before creating one.
+	unsigned int uHash = CString::GetHash(sSessionId);
+	for (int nPass = 0; nPass < 2; nPass++) {
+		bool bCreate = (nPass == 1);
+		for (unsigned int n = 0; n < KEYS_NB_RANGES; n++) {
+			unsigned int uBase = KEYS_ID_PREFIX + ((uHash + n) % KEYS_NB_RANGES) * KEYS_RANGE_SIZE;
+			CSHM * cMem = NULL;
+			if (OpenTable(uBase, sSessionId, bCreate, &cMem) == false) {
+				return false;
+			}
+			if (cMem != NULL) {
+				m_cContainer = cMem;
+				m_pData = cMem->Data();
+				m_uBase = uBase;
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void isl::CSessionKeys::Close()
+{
+	if (m_cContainer != NULL) {
+		m_cContainer->Detach();
+		delete m_cContainer;
+	}
+	m_cContainer = NULL;
+	m_pData = NULL;
+	m_uBase = 0;
+}
+
+unsigned int isl::CSessionKeys::GetId(const std::string & sConnectId, tKey eKey)
+{
+	if ((m_pData == NULL) || sConnectId.empty() || (sConnectId.size() >= KEYS_CONNECTID_SIZE)) {
+		return 0;
+	}
+	tsKeysHeader * pHeader = (tsKeysHeader *)m_pData;
+	tsKeysEntry * pEntries = (tsKeysEntry *)(pHeader + 1);
+	// Open addressing: the entries are never removed while the session runs
+	unsigned int uHash = CString::GetHash(sConnectId);
+	for (unsigned int n = 0; n < KEYS_CAPACITY; n++) {
+		unsigned int uIndex = (uHash + n) % KEYS_CAPACITY;
+		tsKeysEntry * pEntry = &pEntries[uIndex];
+		unsigned int uState = CAtomic::Load(&pEntry->uState);
+		if (uState == KEYS_EMPTY) {
+			if (CAtomic::CompareExchange(&pEntry->uState, uState, KEYS_WRITING)) {
+				pEntry->uHash = uHash;
+				memcpy(pEntry->sConnectId, sConnectId.c_str(), sConnectId.size() + 1);
+				CAtomic::Store(&pEntry->uState, KEYS_READY);
+				CAtomic::FetchAdd(&pHeader->uCount, 1u);
+				return m_uBase + (uIndex + 1) * KEYS_PER_ENTRY + (unsigned int)eKey;
+			}
+			// Taken by another process in the meantime: uState is its current value
+		}
+		if (uState == KEYS_WRITING) {
+			uState = WaitWritten(&pEntry->uState);
+		}
+		if ((uState == KEYS_READY) && (pEntry->uHash == uHash) &&
+			(strcmp(pEntry->sConnectId, sConnectId.c_str()) == 0)) {
+			return m_uBase + (uIndex + 1) * KEYS_PER_ENTRY + (unsigned int)eKey;
+		}
+	}
+	return 0;
+}
+
+unsigned int isl::CSessionKeys::GetBase()
+{
+	return m_uBase;
+}
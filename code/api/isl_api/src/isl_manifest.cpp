@@ -0,0 +1,269 @@
+/*
+ *     Name: isl_manifest.cpp
+ *
+ *     Description: Manifest of the variables of a session.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+
+/*
+ *     Header files
+ */
+
+#include <string.h>
+
+#include <boost/format.hpp>
+
+#include <isl_shm.h>
+#include <isl_atomic.h>
+#include <isl_thread.h>
+
+#include "isl_api.h"
+#include "isl_settings.h"
+#include "isl_manifest.h"
+
+
+/*
+ *     Macros and constants definition
+ */
+
+#define SHM_MFT_KEY_ID	"_isl_shm_ses%1%_mft"
+
+// States of the header
+#define MANIFEST_EMPTY		0u
+#define MANIFEST_WRITING	1u
+#define MANIFEST_READY		2u
+
+// The process creating the manifest only writes its header (milliseconds)
+#define MANIFEST_WAIT		1000
+
+// State of an entry: tState and number of reuses
+#define ME_KIND_MASK		0xFFu
+#define ME_REUSE_ONE		0x100u
+// Attempts to copy an entry reused at the same time
+#define ME_READ_RETRIES		16
+
+
+/*
+ *     Class CManifest
+ */
+
+isl::CManifest::CManifest()
+{
+	m_cContainer = NULL;
+	m_pHeader = NULL;
+	m_pEntries = NULL;
+	m_uNextReuse = 0;
+}
+
+isl::CManifest::~CManifest()
+{
+	Close();
+}
+
+bool isl::CManifest::Open(const std::string & sSessionId, bool bCreate)
+{
+	Close();
+	if (sSessionId.empty()) {
+		return false;
+	}
+	std::string sSHM(boost::str(boost::format(SHM_MFT_KEY_ID) % sSessionId));
+	bool bIsGlobalIPC = CAppSettings().IsGlobalIPC();
+	CSHM * cMem = 0;
+	if (CAppSettings().IsISLCompatible()) {
+		cMem = new CSHM(sSHM, "qipc_sharedmemory_", bIsGlobalIPC);
+	}
+	else {
+		cMem = new CSHM(sSHM, bIsGlobalIPC);
+		cMem->SetBackend(CSHM::GetBackendFromStr(CAppSettings().GetSHMBackend()));
+	}
+	// The memory is zeroed when created: header to write, no entry
+	int nSize = (int)(sizeof(tsManifestHeader) + MANIFEST_CAPACITY * sizeof(tsManifestEntry));
+	bool bOk = cMem->Attach(CSHM::READWRITE);
+	if ((bOk == false) && bCreate && (cMem->GetStatus() == CSHM::NOTFOUND)) {
+		bOk = cMem->Create(nSize, CSHM::READWRITE);
+		if ((bOk == false) && (cMem->GetStatus() == CSHM::ALREADYEXISTS)) {
+			// Created by another process in the meantime
+			bOk = cMem->Attach(CSHM::READWRITE);
+		}
+	}
+	if ((bOk == false) || (cMem->Data() == NULL)) {
+		delete cMem;
+		return false;
+	}
+	tsManifestHeader * pHeader = (tsManifestHeader *)cMem->Data();
+	unsigned int uState = MANIFEST_EMPTY;
+	if (CAtomic::CompareExchange(&pHeader->uState, uState, MANIFEST_WRITING)) {
+		pHeader->uVersion = MANIFEST_VERSION;
+		pHeader->uEntrySize = (unsigned int)sizeof(tsManifestEntry);
+		pHeader->uCapacity = MANIFEST_CAPACITY;
+		if (sSessionId.size() < MANIFEST_SESSION_SIZE) {
+			memcpy(pHeader->sSessionId, sSessionId.c_str(), sSessionId.size() + 1);
+		}
+		CAtomic::Store(&pHeader->uState, MANIFEST_READY);
+		uState = MANIFEST_READY;
+	}
+	for (int i = 0; (uState == MANIFEST_WRITING) && (i < MANIFEST_WAIT); i++) {
+		CThread::Sleep(1);
+		uState = CAtomic::Load(&pHeader->uState);
+	}
+	// Layout of another version
+	if ((uState != MANIFEST_READY) || (pHeader->uVersion != MANIFEST_VERSION) ||
+		(pHeader->uEntrySize != sizeof(tsManifestEntry)) || (cMem->Size() < nSize)) {
+		cMem->Detach();
+		delete cMem;
+		return false;
+	}
+	m_cContainer = cMem;
+	m_pHeader = pHeader;
+	m_pEntries = (tsManifestEntry *)(pHeader + 1);
+	return true;
+}
+
+void isl::CManifest::Close()
+{
+	if (m_cContainer != NULL) {
+		m_cContainer->Detach();
+		delete m_cContainer;
+	}
+	m_cContainer = NULL;
+	m_pHeader = NULL;
+	m_pEntries = NULL;
+	m_uNextReuse = 0;
+}
+
+bool isl::CManifest::IsOpen()
+{
+	return (m_pHeader != NULL);
+}
+
+int isl::CManifest::Append(const tsManifestEntry & stEntry)
+{
+	if ((m_pHeader == NULL) || (memchr(stEntry.sConnectId, '\0', MANIFEST_CONNECTID_SIZE) == NULL)) {
+		return -1;
+	}
+	// A removed entry is claimed, else an index is reserved: the entry is visible once written
+	unsigned int uIndex = 0;
+	unsigned int uReuse = 0;
+	if (Reuse(uIndex, uReuse) == false) {
+		uIndex = CAtomic::FetchAdd(&m_pHeader->uCount, 1u);
+		if (uIndex >= m_pHeader->uCapacity) {
+			return -1;
+		}
+	}
+	tsManifestEntry * pEntry = &m_pEntries[uIndex];
+	pEntry->uType = stEntry.uType;
+	pEntry->uSize = stEntry.uSize;
+	pEntry->uSizeOf = stEntry.uSizeOf;
+	pEntry->uFifoDepth = stEntry.uFifoDepth;
+	pEntry->uMode = stEntry.uMode;
+	pEntry->uWriter = stEntry.uWriter;
+	pEntry->uSegmentId = stEntry.uSegmentId;
+	pEntry->uSegmentSize = stEntry.uSegmentSize;
+	pEntry->uOffset = stEntry.uOffset;
+	memcpy(pEntry->sConnectId, stEntry.sConnectId, MANIFEST_CONNECTID_SIZE);
+	CAtomic::Store(&pEntry->uState, uReuse | (unsigned int)ME_READY);
+	return (int)uIndex;
+}
+
+bool isl::CManifest::Reuse(unsigned int & uIndex, unsigned int & uReuse)
+{
+	if (CAtomic::Load(&m_pHeader->uRemoved) == 0) {
+		return false;
+	}
+	// Started where the last one was found: a writer connecting again reuses its entries in order
+	unsigned int uCount = (unsigned int)GetCount();
+	for (unsigned int i = 0; i < uCount; i++) {
+		uIndex = (m_uNextReuse + i) % uCount;
+		unsigned int * pState = &m_pEntries[uIndex].uState;
+		unsigned int uState = CAtomic::Load(pState);
+		if ((uState & ME_KIND_MASK) != (unsigned int)ME_REMOVED) {
+			continue;
+		}
+		// Not readable while written again
+		uReuse = (uState & ~ME_KIND_MASK) + ME_REUSE_ONE;
+		if (CAtomic::CompareExchange(pState, uState, uReuse | (unsigned int)ME_EMPTY)) {
+			CAtomic::FetchAdd(&m_pHeader->uRemoved, (unsigned int)-1);
+			m_uNextReuse = uIndex + 1;
+			return true;
+		}
+	}
+	return false;
+}
+
+void isl::CManifest::Remove(int nIndex)
+{
+	if ((m_pHeader == NULL) || (nIndex < 0) || (nIndex >= GetCount())) {
+		return;
+	}
+	// Only the writer of the entry removes it
+	unsigned int * pState = &m_pEntries[nIndex].uState;
+	unsigned int uState = CAtomic::Load(pState);
+	if ((uState & ME_KIND_MASK) != (unsigned int)ME_READY) {
+		return;
+	}
+	CAtomic::Store(pState, (uState & ~ME_KIND_MASK) | (unsigned int)ME_REMOVED);
+	CAtomic::FetchAdd(&m_pHeader->uRemoved, 1u);
+}
+
+int isl::CManifest::GetCount()
+{
+	if (m_pHeader == NULL) {
+		return 0;
+	}
+	unsigned int uCount = CAtomic::Load(&m_pHeader->uCount);
+	if (uCount > m_pHeader->uCapacity) {
+		uCount = m_pHeader->uCapacity;
+	}
+	return (int)uCount;
+}
+
+bool isl::CManifest::GetEntry(int nIndex, tsManifestEntry & stEntry)
+{
+	if ((m_pHeader == NULL) || (nIndex < 0) || (nIndex >= GetCount())) {
+		return false;
+	}
+	tsManifestEntry * pEntry = &m_pEntries[nIndex];
+	for (int i = 0; i < ME_READ_RETRIES; i++) {
+		unsigned int uState = CAtomic::Load(&pEntry->uState);
+		if ((uState & ME_KIND_MASK) == (unsigned int)ME_EMPTY) {
+			return false;
+		}
+		memcpy(&stEntry, pEntry, sizeof(tsManifestEntry));
+		// The entry may have been reused during the copy: its reuse count has changed
+		CAtomic::FenceAcquire();
+		if ((CAtomic::Load(&pEntry->uState) & ~ME_KIND_MASK) == (uState & ~ME_KIND_MASK)) {
+			stEntry.uState = uState & ME_KIND_MASK;
+			stEntry.sConnectId[MANIFEST_CONNECTID_SIZE - 1] = '\0';
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,447 @@
+/*
+ *     Name: isl_notify.cpp
+ *
+ *     Description: ISL API inputs notification class.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+
+/*
+ *     Header files
+ */
+
+#ifndef WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif // WIN32
+
+#include <boost/format.hpp>
+#include <boost/filesystem.hpp>
+
+#include <isl_sem.h>
+#include <isl_futex.h>
+#include <isl_shm.h>
+#include <isl_atomic.h>
+#include <isl_thread.h>
+
+#include "isl_api.h"
+#include "isl_settings.h"
+#include "isl_shm_connect.h"
+#include "isl_keys.h"
+#include "isl_notify.h"
+
+
+/*
+ *     Macros and constants definition
+ */
+
+#define SEM_NTF_KEY_ID	"_isl_sem_ses%1%_ntf%2%"
+#define PIPE_NTF_KEY_ID	"_isl_pipe_ses%1%_ntf%2%"
+#define KEYS_NTF_ID		"_ntf%1%" // Entry of the session identifiers
+#define SHM_PUB_KEY_ID	"_isl_shm_ses%1%_pub"
+#define SEM_PUB_KEY_ID	"_isl_sem_ses%1%_pub"
+
+// Words of the publication shared memory
+#define PUB_GENERATION	0
+#define PUB_WAITERS		1
+#define PUB_WAKE		2 // Not used anymore: the waiters sleep on the generation
+#define PUB_SIZE		(4 * sizeof(unsigned int))
+
+
+/*
+ *     Class CNotify
+ */
+
+isl::CNotify::CNotify()
+{
+	m_cContainer = NULL;
+	m_cData = NULL;
+	m_cListen = NULL;
+	m_cWake = NULL;
+	m_uId = 0;
+	m_bTimeout = false;
+	m_nHandle = -1;
+	m_bOwner = false;
+}
+
+isl::CNotify::~CNotify()
+{
+	Close();
+}
+
+bool isl::CNotify::Open(CSHMConnect * cData, const std::string & sSessionId, unsigned int uId,
+	CSessionKeys * cKeys)
+{
+	Close();
+	if (cData == NULL) {
+		return false;
+	}
+	m_cData = cData;
+	m_uId = uId;
+	m_bOwner = true;
+	return OpenWake(sSessionId, uId, cKeys);
+}
+
+bool isl::CNotify::Attach(const std::string & sSessionId, unsigned int uId, CSessionKeys * cKeys)
+{
+	Close();
+	std::string sSHM(boost::str(boost::format(SHM_MODEL_KEY_ID) % sSessionId % uId));
+	bool bIsGlobalIPC = CAppSettings().IsGlobalIPC();
+	CSHM * cMem = 0;
+	if (CAppSettings().IsISLCompatible()) {
+		cMem = new CSHM(sSHM, "qipc_sharedmemory_", bIsGlobalIPC);
+	}
+	else {
+		cMem = new CSHM(sSHM, bIsGlobalIPC);
+		cMem->SetBackend(CSHM::GetBackendFromStr(CAppSettings().GetSHMBackend()));
+	}
+	if ((cMem->Attach(CSHM::READWRITE) == false) || (cMem->Data() == 0)) {
+		delete cMem;
+		return false;
+	}
+	m_cContainer = cMem;
+	m_cData = new CSHMConnect(cMem->Data(), NULL);
+	m_uId = uId;
+	return OpenWake(sSessionId, uId, cKeys);
+}
+
+bool isl::CNotify::OpenWake(const std::string & sSessionId, unsigned int uId, CSessionKeys * cKeys)
+{
+	boost::filesystem::path bpHandle(boost::filesystem::temp_directory_path());
+	bpHandle.append(boost::str(boost::format(PIPE_NTF_KEY_ID) % sSessionId % uId));
+	m_sHandle = bpHandle.string();
+	if (m_cData->IsNotifyFutex()) {
+		m_cWake = new CFutex(m_cData->GetNotifyWake());
+		return true;
+	}
+	// If the semaphore is already created, it will connect in open mode.
+	std::string sSem(boost::str(boost::format(SEM_NTF_KEY_ID) % sSessionId % uId));
+	bool bIsGlobalIPC = CAppSettings().IsGlobalIPC();
+	unsigned int uKey = (cKeys != 0 ?
+		cKeys->GetId(boost::str(boost::format(KEYS_NTF_ID) % uId), CSessionKeys::KEY_SEM_NOTIFY) : 0);
+	if (CAppSettings().IsISLCompatible()) {
+		m_cListen = new CSem(sSem, "qipc_systemsem_", 0, CSem::CREATE, bIsGlobalIPC);
+	}
+	else if (uKey != 0) {
+		m_cListen = new CSem(uKey, 0, CSem::CREATE, bIsGlobalIPC);
+	}
+	else {
+		m_cListen = new CSem(sSem, 0, CSem::CREATE, bIsGlobalIPC);
+	}
+	return true;
+}
+
+void isl::CNotify::Close()
+{
+	CloseHandle();
+	if (m_cListen != NULL) {
+		delete m_cListen;
+	}
+	m_cListen = NULL;
+	if (m_cWake != NULL) {
+		delete m_cWake;
+	}
+	m_cWake = NULL;
+	if (m_cContainer != NULL) {
+		delete m_cData;
+		m_cContainer->Detach();
+		delete m_cContainer;
+	}
+	m_cContainer = NULL;
+	m_cData = NULL;
+	m_uId = 0;
+	m_bOwner = false;
+}
+
+unsigned int isl::CNotify::GetId()
+{
+	return m_uId;
+}
+
+void isl::CNotify::Listen()
+{
+	if (m_cData != NULL) {
+		m_cData->AddNotifyListen();
+	}
+}
+
+void isl::CNotify::CancelListen()
+{
+	if (m_cData != NULL) {
+		m_cData->CancelNotifyListen();
+	}
+}
+
+bool isl::CNotify::Wait(int nTimeout)
+{
+	m_bTimeout = false;
+	bool bRet = false;
+	if (m_cWake != NULL) {
+		m_cWake->SetTimeout(nTimeout);
+		bRet = (nTimeout == 0 ? m_cWake->TryAcquire() : m_cWake->Acquire());
+		m_bTimeout = (m_cWake->GetStatus() == CFutex::TIMEOUTREACHED);
+	}
+	else if (m_cListen != NULL) {
+		m_cListen->SetTimeout(nTimeout);
+		bRet = (nTimeout == 0 ? m_cListen->TryAcquire() : m_cListen->Acquire());
+		m_bTimeout = (m_cListen->GetStatus() == CSem::TIMEOUTREACHED);
+	}
+	return bRet;
+}
+
+bool isl::CNotify::IsTimeout()
+{
+	return m_bTimeout;
+}
+
+int isl::CNotify::OpenHandle()
+{
+#ifdef WIN32
+	return -1;
+#else
+	if ((m_bOwner == false) || (m_cData == NULL)) {
+		return -1;
+	}
+	if (m_nHandle != -1) {
+		return m_nHandle;
+	}
+	if ((mkfifo(m_sHandle.c_str(), 0600) == -1) && (errno != EEXIST)) {
+		return -1;
+	}
+	m_nHandle = open(m_sHandle.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+	if (m_nHandle == -1) {
+		return -1;
+	}
+	m_cData->ResetNotifyPending();
+	m_cData->SetNotifyHandle(true);
+	return m_nHandle;
+#endif
+}
+
+void isl::CNotify::ResetHandle()
+{
+#ifndef WIN32
+	if (m_nHandle == -1) {
+		return;
+	}
+	// Reset first: a value published from now signals the handle again
+	m_cData->ResetNotifyPending();
+	char sBuffer[64];
+	while (read(m_nHandle, sBuffer, sizeof(sBuffer)) > 0) {
+	}
+#endif
+}
+
+void isl::CNotify::CloseHandle()
+{
+#ifndef WIN32
+	if (m_bOwner && (m_nHandle != -1)) {
+		if (m_cData != NULL) {
+			m_cData->SetNotifyHandle(false);
+		}
+		unlink(m_sHandle.c_str());
+	}
+	if (m_nHandle != -1) {
+		close(m_nHandle);
+	}
+#endif
+	m_nHandle = -1;
+}
+
+void isl::CNotify::Notify()
+{
+	if (m_cData == NULL) {
+		return;
+	}
+#ifndef WIN32
+	if (m_cData->IsNotifyHandle() && m_cData->SetNotifyPending()) {
+		if (m_nHandle == -1) {
+			// The connector may have opened the handle after the attachment
+			m_nHandle = open(m_sHandle.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+		}
+		char cByte = 1;
+		if ((m_nHandle == -1) || (write(m_nHandle, &cByte, 1) != 1)) {
+			// Not signaled: the next value tries again
+			m_cData->ResetNotifyPending();
+			if ((m_nHandle != -1) && (errno != EAGAIN)) {
+				close(m_nHandle);
+				m_nHandle = -1;
+			}
+		}
+	}
+#endif
+	int nListeners = m_cData->ResetNotifyListen();
+	if (nListeners > 0) {
+		if (m_cWake != NULL) {
+			m_cWake->Release(nListeners);
+		}
+		else if (m_cListen != NULL) {
+			m_cListen->Release(nListeners);
+		}
+	}
+}
+
+
+/*
+ *     Class CPublish
+ */
+
+isl::CPublish::CPublish()
+{
+	m_cContainer = NULL;
+	m_pData = NULL;
+	m_cListen = NULL;
+	m_cWake = NULL;
+}
+
+isl::CPublish::~CPublish()
+{
+	Close();
+}
+
+bool isl::CPublish::Open(const std::string & sSessionId)
+{
+	Close();
+	std::string sSHM(boost::str(boost::format(SHM_PUB_KEY_ID) % sSessionId));
+	bool bIsGlobalIPC = CAppSettings().IsGlobalIPC();
+	CSHM * cMem = 0;
+	if (CAppSettings().IsISLCompatible()) {
+		cMem = new CSHM(sSHM, "qipc_sharedmemory_", bIsGlobalIPC);
+	}
+	else {
+		cMem = new CSHM(sSHM, bIsGlobalIPC);
+		cMem->SetBackend(CSHM::GetBackendFromStr(CAppSettings().GetSHMBackend()));
+	}
+	// The memory is zeroed when created: generation 0, no waiter
+	bool bOk = cMem->Attach(CSHM::READWRITE);
+	if ((bOk == false) && (cMem->GetStatus() == CSHM::NOTFOUND)) {
+		bOk = cMem->Create((int)PUB_SIZE, CSHM::READWRITE);
+		if ((bOk == false) && (cMem->GetStatus() == CSHM::ALREADYEXISTS)) {
+			// Created by another process in the meantime
+			bOk = cMem->Attach(CSHM::READWRITE);
+		}
+	}
+	if ((bOk == false) || (cMem->Data() == NULL)) {
+		delete cMem;
+		return false;
+	}
+	m_cContainer = cMem;
+	m_pData = (unsigned int *)cMem->Data();
+	if (CFutex::IsAvailable()) {
+		m_cWake = new CFutex(&m_pData[PUB_GENERATION]);
+		return true;
+	}
+	// If the semaphore is already created, it will connect in open mode.
+	std::string sSem(boost::str(boost::format(SEM_PUB_KEY_ID) % sSessionId));
+	if (CAppSettings().IsISLCompatible()) {
+		m_cListen = new CSem(sSem, "qipc_systemsem_", 0, CSem::CREATE, bIsGlobalIPC);
+	}
+	else {
+		m_cListen = new CSem(sSem, 0, CSem::CREATE, bIsGlobalIPC);
+	}
+	return true;
+}
+
+void isl::CPublish::Close()
+{
+	if (m_cListen != NULL) {
+		delete m_cListen;
+	}
+	m_cListen = NULL;
+	if (m_cWake != NULL) {
+		delete m_cWake;
+	}
+	m_cWake = NULL;
+	if (m_cContainer != NULL) {
+		m_cContainer->Detach();
+		delete m_cContainer;
+	}
+	m_cContainer = NULL;
+	m_pData = NULL;
+}
+
+unsigned int isl::CPublish::GetGeneration()
+{
+	if (m_pData == NULL) {
+		return 0;
+	}
+	return CAtomic::LoadSeq(&m_pData[PUB_GENERATION]);
+}
+
+bool isl::CPublish::Wait(unsigned int uGeneration, int nTimeout)
+{
+	if (m_pData == NULL) {
+		CThread::Sleep(nTimeout);
+		return false;
+	}
+	if (m_cListen != NULL) {
+		// The releases left by the waiters gone or woken by a timeout are dropped,
+		// so that they do not make the next waits return at once
+		while (m_cListen->TryAcquire()) {
+		}
+	}
+	// Registered before checking the generation: a publication from now releases this waiter
+	CAtomic::FetchAdd(&m_pData[PUB_WAITERS], 1u);
+	bool bRet = (CAtomic::LoadSeq(&m_pData[PUB_GENERATION]) != uGeneration);
+	if (bRet == false) {
+		if (m_cWake != NULL) {
+			// No count: the sleep ends with the change of the generation itself
+			m_cWake->SetTimeout(nTimeout);
+			m_cWake->WaitWhile(uGeneration);
+		}
+		else if (m_cListen != NULL) {
+			m_cListen->SetTimeout(nTimeout);
+			m_cListen->Acquire();
+		}
+		bRet = (CAtomic::LoadSeq(&m_pData[PUB_GENERATION]) != uGeneration);
+	}
+	CAtomic::FetchAdd(&m_pData[PUB_WAITERS], (unsigned int)-1);
+	return bRet;
+}
+
+void isl::CPublish::Publish()
+{
+	if (m_pData == NULL) {
+		return;
+	}
+	CAtomic::FetchAdd(&m_pData[PUB_GENERATION], 1u);
+	int nWaiters = (int)CAtomic::LoadSeq(&m_pData[PUB_WAITERS]);
+	if (nWaiters > 0) {
+		if (m_cWake != NULL) {
+			m_cWake->WakeAll();
+		}
+		else if (m_cListen != NULL) {
+			m_cListen->Release(nWaiters);
+		}
+	}
+}
@@ -41,6 +41,7 @@
 #include <isl_log.h>
 #include <boost/lexical_cast.hpp>
 #include <boost/format.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include "isl_const.h"
 #include "isl_errorcodes.h"
@@ -53,43 +54,221 @@
 
 const std::string isl::CAppSettings::c_sFile = "isl_api.ini";
 
+// Names of the known groups and keys, in the order of their identifiers
+static const char * c_lGroupNames[] = {
+	"Common"
+};
+
+static const char * c_lKeyNames[] = {
+	"MaxSHMStringSize",
+	"MaxFIFODepth",
+	"MaxNbReaders",
+	"MaxNbSimulations",
+	"StepTolerance",
+	"ISLCompatible",
+	"IsGlobalIPC",
+	"LockFreeFIFO",
+	"Futex",
+	"WaitPolicy",
+	"SpinCount",
+	"SHMBackend",
+	"SHMHugePages",
+	"AsyncLog",
+	"AsyncLogSize",
+	"Trace",
+	"TraceSize",
+	"TracePath",
+	"ConnectThreads",
+	"SessionKeys"
+};
+
 
 /*
  *     Classes definition
  */
 
+namespace isl {
+	// Content of the file and values of the known parameters
+	class CSettingsSnapshot
+	{
+	public:
+		CSettingsSnapshot() {
+			m_cProperties = 0;
+			m_bLoaded = false;
+			m_uMaxSHMStringSize = DEFAULT_MAX_SHM_STRING_SIZE;
+			m_uMaxFIFODepth = DEFAULT_MAX_FIFO_DEPTH;
+			m_nMaxNbReaders = DEFAULT_MAX_NB_READERS;
+			m_nMaxNbRunSims = DEFAULT_MAX_NB_RUN_SIMS;
+			m_dStepTolerance = DEFAULT_STEP_TOLERANCE;
+			m_bISLCompatible = false;
+			m_bGlobalIPC = false;
+			m_bLockFreeFIFO = false;
+			m_bFutex = false;
+			m_sWaitPolicy = DEFAULT_WAIT_POLICY;
+			m_nSpinCount = DEFAULT_SPIN_COUNT;
+			m_sSHMBackend = DEFAULT_SHM_BACKEND;
+			m_bSHMHugePages = false;
+			m_bAsyncLog = false;
+			m_uAsyncLogSize = LOG_ASYNC_SIZE;
+			m_bTrace = false;
+			m_uTraceSize = DEFAULT_TRACE_SIZE;
+			m_uConnectThreads = DEFAULT_CONNECT_THREADS;
+			m_bSessionKeys = true;
+		}
+
+		~CSettingsSnapshot() {
+			if (m_cProperties != 0) {
+				delete m_cProperties;
+			}
+			m_cProperties = 0;
+		}
+
+		CINI * m_cProperties;
+		bool m_bLoaded;
+
+		unsigned int m_uMaxSHMStringSize;
+		unsigned int m_uMaxFIFODepth;
+		int m_nMaxNbReaders;
+		int m_nMaxNbRunSims;
+		double m_dStepTolerance;
+		bool m_bISLCompatible;
+		bool m_bGlobalIPC;
+		bool m_bLockFreeFIFO;
+		bool m_bFutex;
+		std::string m_sWaitPolicy;
+		int m_nSpinCount;
+		std::string m_sSHMBackend;
+		bool m_bSHMHugePages;
+		bool m_bAsyncLog;
+		unsigned int m_uAsyncLogSize;
+		bool m_bTrace;
+		unsigned int m_uTraceSize;
+		std::string m_sTracePath;
+		unsigned int m_uConnectThreads;
+		bool m_bSessionKeys;
+	};
+}
+
+// Never destroyed: the settings may be read by the destructors of static objects
+static boost::mutex & GetSnapshotLock()
+{
+	static boost::mutex * cLock = new boost::mutex();
+	return *cLock;
+}
+
+static boost::shared_ptr<const isl::CSettingsSnapshot> & GetSnapshot()
+{
+	static boost::shared_ptr<const isl::CSettingsSnapshot> * cSnapshot =
+		new boost::shared_ptr<const isl::CSettingsSnapshot>();
+	return *cSnapshot;
+}
+
+
 /*
  *     Class CAppSettings
  */
 
 isl::CAppSettings::CAppSettings()
 {
-	//
-	m_mGroupNames[AS_GRP_COMMON] = "Common";
-	//
-	m_mKeyNames[AS_CMN_MAXSHMSTRINGSIZE] = "MaxSHMStringSize";
-	m_mKeyNames[AS_CMN_MAXFIFODEPTH] = "MaxFIFODepth";
-	m_mKeyNames[AS_CMN_MAXNBREADERS] = "MaxNbReaders";
-	m_mKeyNames[AS_CMN_MAXNBRUNSIMS] = "MaxNbSimulations";
-	m_mKeyNames[AS_CMN_STEPTOLERANCE] = "StepTolerance";
-	m_mKeyNames[AS_CMN_ISLCOMPATIBLE] = "ISLCompatible";
-	m_mKeyNames[AS_CMN_ISGLOBALIPC] = "IsGlobalIPC";
-	//
-	m_cProperties = new CINI(c_sFile, true);
-	m_bLoaded = true;
-	if (m_cProperties->Load() == false) {
-		AppLogError(APPSETTINGS_INI_LOAD_FAILED, "Failed to load the file: %s, Status: %d",
-			m_cProperties->GetFile().c_str(), m_cProperties->GetStatus());
-		m_bLoaded = false;
+	boost::mutex::scoped_lock cLock(GetSnapshotLock());
+	if (GetSnapshot().get() == 0) {
+		GetSnapshot() = Load();
 	}
+	m_cSnapshot = GetSnapshot();
+}
+
+isl::CAppSettings::CAppSettings(const boost::shared_ptr<const CSettingsSnapshot> & cSnapshot)
+{
+	m_cSnapshot = cSnapshot;
 }
 
 isl::CAppSettings::~CAppSettings()
 {
-	if (m_cProperties != 0) {
-		delete m_cProperties;
+}
+
+bool isl::CAppSettings::Reload()
+{
+	boost::shared_ptr<const CSettingsSnapshot> cSnapshot = Load();
+	boost::mutex::scoped_lock cLock(GetSnapshotLock());
+	GetSnapshot() = cSnapshot;
+	return cSnapshot->m_bLoaded;
+}
+
+boost::shared_ptr<const isl::CSettingsSnapshot> isl::CAppSettings::Load()
+{
+	CSettingsSnapshot * cSnapshot = new CSettingsSnapshot();
+	boost::shared_ptr<const CSettingsSnapshot> cRet(cSnapshot);
+	cSnapshot->m_cProperties = new CINI(c_sFile, true);
+	cSnapshot->m_bLoaded = true;
+	if (cSnapshot->m_cProperties->Load() == false) {
+		AppLogError(APPSETTINGS_INI_LOAD_FAILED, "Failed to load the file: %s, Status: %d",
+			cSnapshot->m_cProperties->GetFile().c_str(), cSnapshot->m_cProperties->GetStatus());
+		cSnapshot->m_bLoaded = false;
+		return cRet;
+	}
+	// Values of the known parameters
+	CAppSettings cSettings(cRet);
+	cSnapshot->m_uMaxSHMStringSize = (unsigned int)cSettings.GetIntValue(AS_GRP_COMMON, AS_CMN_MAXSHMSTRINGSIZE,
+		DEFAULT_MAX_SHM_STRING_SIZE);
+	cSnapshot->m_uMaxFIFODepth = (unsigned int)cSettings.GetIntValue(AS_GRP_COMMON, AS_CMN_MAXFIFODEPTH,
+		DEFAULT_MAX_FIFO_DEPTH);
+	cSnapshot->m_nMaxNbReaders = cSettings.GetIntValue(AS_GRP_COMMON, AS_CMN_MAXNBREADERS, DEFAULT_MAX_NB_READERS);
+	cSnapshot->m_nMaxNbRunSims = cSettings.GetIntValue(AS_GRP_COMMON, AS_CMN_MAXNBRUNSIMS, DEFAULT_MAX_NB_RUN_SIMS);
+	cSnapshot->m_dStepTolerance = cSettings.GetDoubleValue(AS_GRP_COMMON, AS_CMN_STEPTOLERANCE,
+		DEFAULT_STEP_TOLERANCE);
+	cSnapshot->m_bISLCompatible = cSettings.GetBoolValue(AS_GRP_COMMON, AS_CMN_ISLCOMPATIBLE, false);
+	cSnapshot->m_bGlobalIPC = cSettings.GetBoolValue(AS_GRP_COMMON, AS_CMN_ISGLOBALIPC, false);
+	cSnapshot->m_bLockFreeFIFO = cSettings.GetBoolValue(AS_GRP_COMMON, AS_CMN_LOCKFREEFIFO, false);
+	cSnapshot->m_bFutex = cSettings.GetBoolValue(AS_GRP_COMMON, AS_CMN_FUTEX, false);
+	cSnapshot->m_sWaitPolicy = cSettings.GetStringValue(AS_GRP_COMMON, AS_CMN_WAITPOLICY, DEFAULT_WAIT_POLICY);
+	cSnapshot->m_nSpinCount = cSettings.GetIntValue(AS_GRP_COMMON, AS_CMN_SPINCOUNT, DEFAULT_SPIN_COUNT);
+	cSnapshot->m_sSHMBackend = cSettings.GetStringValue(AS_GRP_COMMON, AS_CMN_SHMBACKEND, DEFAULT_SHM_BACKEND);
+	cSnapshot->m_bSHMHugePages = cSettings.GetBoolValue(AS_GRP_COMMON, AS_CMN_SHMHUGEPAGES, false);
+	cSnapshot->m_bAsyncLog = cSettings.GetBoolValue(AS_GRP_COMMON, AS_CMN_ASYNCLOG, false);
+	cSnapshot->m_uAsyncLogSize = (unsigned int)cSettings.GetIntValue(AS_GRP_COMMON, AS_CMN_ASYNCLOGSIZE,
+		LOG_ASYNC_SIZE);
+	cSnapshot->m_bTrace = cSettings.GetBoolValue(AS_GRP_COMMON, AS_CMN_TRACE, false);
+	cSnapshot->m_uTraceSize = (unsigned int)cSettings.GetIntValue(AS_GRP_COMMON, AS_CMN_TRACESIZE,
+		DEFAULT_TRACE_SIZE);
+	cSnapshot->m_sTracePath = cSettings.GetStringValue(AS_GRP_COMMON, AS_CMN_TRACEPATH, "", true);
+	cSnapshot->m_uConnectThreads = (unsigned int)cSettings.GetIntValue(AS_GRP_COMMON, AS_CMN_CONNECTTHREADS,
+		DEFAULT_CONNECT_THREADS);
+	cSnapshot->m_bSessionKeys = cSettings.GetBoolValue(AS_GRP_COMMON, AS_CMN_SESSIONKEYS, true);
+	return cRet;
+}
+
+bool isl::CAppSettings::GetNames(tGroup eGroup, tKey eKey, std::string & sGroup, std::string & sKey)
+{
+	if ((eGroup < 0) || (eGroup >= AS_GRP_UNKNOWN)) {
+		AppLogError(APPSETTINGS_UNKNOWN_GROUP, "Unknown group id: %d.", eGroup);
+		return false;
+	}
+	if ((eKey < 0) || (eKey >= AS_KEY_UNKNOWN)) {
+		AppLogError(APPSETTINGS_UNKNOWN_KEY, "Unknown key id: %d.", eKey);
+		return false;
+	}
+	// The groups and keys added by the derived classes first
+	if (m_mGroupNames.count(eGroup) != 0) {
+		sGroup = m_mGroupNames[eGroup];
+	}
+	else if ((size_t)eGroup < sizeof(c_lGroupNames) / sizeof(c_lGroupNames[0])) {
+		sGroup = c_lGroupNames[eGroup];
+	}
+	else {
+		AppLogError(APPSETTINGS_UNKNOWN_GROUP, "Unknown group id: %d.", eGroup);
+		return false;
+	}
+	if (m_mKeyNames.count(eKey) != 0) {
+		sKey = m_mKeyNames[eKey];
+	}
+	else if ((size_t)eKey < sizeof(c_lKeyNames) / sizeof(c_lKeyNames[0])) {
+		sKey = c_lKeyNames[eKey];
+	}
+	else {
+		AppLogError(APPSETTINGS_UNKNOWN_KEY, "Unknown key id: %d.", eKey);
+		return false;
 	}
-	m_cProperties = 0;
+	return true;
 }
 
 bool isl::CAppSettings::GetBoolValue(tGroup eGroup, tKey eKey, bool bDefault)
@@ -132,21 +311,18 @@ double isl::CAppSettings::GetDoubleValue(tGroup eGroup, tKey eKey, double dDefau
 std::string isl::CAppSettings::GetStringValue(tGroup eGroup, tKey eKey,
 	const std::string & sDefault, bool bResolve)
 {
-	if (m_bLoaded == false) {
+	if (m_cSnapshot->m_bLoaded == false) {
 		AppLogError(APPSETTINGS_INI_NOT_LOADED, "The file %s has not been loaded.",
-			m_cProperties->GetFile().c_str());
+			m_cSnapshot->m_cProperties->GetFile().c_str());
 		return sDefault;
 	}
-	if ((eGroup < 0) || (eGroup >= AS_GRP_UNKNOWN) || (m_mGroupNames.count(eGroup) == 0)) {
-		AppLogError(APPSETTINGS_UNKNOWN_GROUP, "Unknown group id: %d.", eGroup);
-		return sDefault;
-	}
-	if ((eKey < 0) || (eKey >= AS_KEY_UNKNOWN) || (m_mKeyNames.count(eKey) == 0)) {
-		AppLogError(APPSETTINGS_UNKNOWN_KEY, "Unknown key id: %d.", eKey);
+	std::string sGroup;
+	std::string sKey;
+	if (GetNames(eGroup, eKey, sGroup, sKey) == false) {
 		return sDefault;
 	}
-	std::string sPath = boost::str(boost::format("%1%.%2%") % m_mGroupNames[eGroup] % m_mKeyNames[eKey]);
-	std::string sVal = m_cProperties->GetParameter(sPath, bResolve);
+	std::string sPath = boost::str(boost::format("%1%.%2%") % sGroup % sKey);
+	std::string sVal = m_cSnapshot->m_cProperties->GetParameter(sPath, bResolve);
 	if (sVal.empty()) {
 		sVal = sDefault;
 	}
@@ -155,35 +331,100 @@ std::string isl::CAppSettings::GetStringValue(tGroup eGroup, tKey eKey,
 
 unsigned int isl::CAppSettings::GetMaxSHMStringSize()
 {
-	return (unsigned int)GetIntValue(AS_GRP_COMMON, AS_CMN_MAXSHMSTRINGSIZE, DEFAULT_MAX_SHM_STRING_SIZE);
+	return m_cSnapshot->m_uMaxSHMStringSize;
 }
 
-unsigned short isl::CAppSettings::GetMaxFIFODepth()
+unsigned int isl::CAppSettings::GetMaxFIFODepth()
 {
-	return (unsigned short)GetIntValue(AS_GRP_COMMON, AS_CMN_MAXFIFODEPTH, DEFAULT_MAX_FIFO_DEPTH);
+	return m_cSnapshot->m_uMaxFIFODepth;
 }
 
 int isl::CAppSettings::GetMaxNbReaders()
 {
-	return GetIntValue(AS_GRP_COMMON, AS_CMN_MAXNBREADERS, DEFAULT_MAX_NB_READERS);
+	return m_cSnapshot->m_nMaxNbReaders;
 }
 
 int isl::CAppSettings::GetMaxNbRunSims()
 {
-	return GetIntValue(AS_GRP_COMMON, AS_CMN_MAXNBRUNSIMS, DEFAULT_MAX_NB_RUN_SIMS);
+	return m_cSnapshot->m_nMaxNbRunSims;
 }
 
 double isl::CAppSettings::GetStepTolerance()
 {
-	return GetDoubleValue(AS_GRP_COMMON, AS_CMN_STEPTOLERANCE, DEFAULT_STEP_TOLERANCE);
+	return m_cSnapshot->m_dStepTolerance;
 }
 
 bool isl::CAppSettings::IsISLCompatible()
 {
-	return GetBoolValue(AS_GRP_COMMON, AS_CMN_ISLCOMPATIBLE, false);
+	return m_cSnapshot->m_bISLCompatible;
 }
 
 bool isl::CAppSettings::IsGlobalIPC()
 {
-	return GetBoolValue(AS_GRP_COMMON, AS_CMN_ISGLOBALIPC, false);
+	return m_cSnapshot->m_bGlobalIPC;
+}
+
+bool isl::CAppSettings::IsLockFreeFIFO()
+{
+	return m_cSnapshot->m_bLockFreeFIFO;
+}
+
+bool isl::CAppSettings::IsFutex()
+{
+	return m_cSnapshot->m_bFutex;
+}
+
+std::string isl::CAppSettings::GetWaitPolicy()
+{
+	return m_cSnapshot->m_sWaitPolicy;
+}
+
+int isl::CAppSettings::GetSpinCount()
+{
+	return m_cSnapshot->m_nSpinCount;
+}
+
+std::string isl::CAppSettings::GetSHMBackend()
+{
+	return m_cSnapshot->m_sSHMBackend;
+}
+
+bool isl::CAppSettings::IsSHMHugePages()
+{
+	return m_cSnapshot->m_bSHMHugePages;
+}
+
+bool isl::CAppSettings::IsAsyncLog()
+{
+	return m_cSnapshot->m_bAsyncLog;
+}
+
+unsigned int isl::CAppSettings::GetAsyncLogSize()
+{
+	return m_cSnapshot->m_uAsyncLogSize;
+}
+
+bool isl::CAppSettings::IsTrace()
+{
+	return m_cSnapshot->m_bTrace;
+}
+
+unsigned int isl::CAppSettings::GetTraceSize()
+{
+	return m_cSnapshot->m_uTraceSize;
+}
+
+std::string isl::CAppSettings::GetTracePath()
+{
+	return m_cSnapshot->m_sTracePath;
+}
+
+unsigned int isl::CAppSettings::GetConnectThreads()
+{
+	return m_cSnapshot->m_uConnectThreads;
+}
+
+bool isl::CAppSettings::IsSessionKeys()
+{
+	return m_cSnapshot->m_bSessionKeys;
 }
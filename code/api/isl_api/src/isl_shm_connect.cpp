@@ -36,11 +36,22 @@
  *     Header files
  */
 
+#include <isl_atomic.h>
 #include "isl_api.h"
 #include "isl_settings.h"
 #include "isl_shm_connect.h"
 
 
+/*
+ *     Macros and constants definition
+ */
+
+#define SHM_ALIGN(n, a) (((n) + (a) - 1) & ~((a) - 1))
+
+// The notification words are updated by the writers of the inputs
+#define SHM_CACHE_LINE		64
+
+
 /*
  *     Classes definition
  */
@@ -67,7 +78,15 @@ int isl::CSHMConnect::GetSizeOf(CConnect * cConnect)
 	nSize += sizeof(char) * uMaxStrSize; // m_sFile
 	//
 	nSize += sizeof(int); // m_nNbData
-	return nSize;
+	//
+	nSize = SHM_ALIGN(nSize, SHM_CACHE_LINE);
+	nSize += sizeof(int); // m_nNotifyListen
+	nSize += sizeof(unsigned int); // m_uNotifyWake
+	nSize += sizeof(bool); // m_bNotifyFutex
+	nSize = SHM_ALIGN(nSize, sizeof(int));
+	nSize += sizeof(int); // m_nNotifyHandle
+	nSize += sizeof(unsigned int); // m_uNotifyPending
+	return SHM_ALIGN(nSize, SHM_CACHE_LINE);
 }
 
 isl::CSHMConnect::CSHMConnect(void * pData, CConnect * cConnect)
@@ -81,6 +100,11 @@ isl::CSHMConnect::CSHMConnect(void * pData, CConnect * cConnect)
 	m_nSizeFile = NULL;
 	m_sFile = NULL;
 	m_nNbData = NULL;
+	m_nNotifyListen = NULL;
+	m_uNotifyWake = NULL;
+	m_bNotifyFutex = NULL;
+	m_nNotifyHandle = NULL;
+	m_uNotifyPending = NULL;
 	unsigned int uMaxStrSize = CAppSettings().GetMaxSHMStringSize();
 	if (pData != NULL) {
 		m_uType = (unsigned int *)pData;
@@ -108,6 +132,19 @@ isl::CSHMConnect::CSHMConnect(void * pData, CConnect * cConnect)
 		pNext = pNext + (sizeof(char) * uMaxStrSize);
 		//
 		m_nNbData = (int *)pNext;
+		pNext = pNext + sizeof(int);
+		//
+		pNext = (char *)pData + SHM_ALIGN(pNext - (char *)pData, SHM_CACHE_LINE);
+		m_nNotifyListen = (int *)pNext;
+		pNext = pNext + sizeof(int);
+		m_uNotifyWake = (unsigned int *)pNext;
+		pNext = pNext + sizeof(unsigned int);
+		m_bNotifyFutex = (bool *)pNext;
+		pNext = pNext + sizeof(bool);
+		pNext = (char *)pData + SHM_ALIGN(pNext - (char *)pData, sizeof(int));
+		m_nNotifyHandle = (int *)pNext;
+		pNext = pNext + sizeof(int);
+		m_uNotifyPending = (unsigned int *)pNext;
 	}
 	m_cParent = cConnect;
 }
@@ -123,6 +160,11 @@ isl::CSHMConnect::~CSHMConnect()
 	m_nSizeFile = NULL;
 	m_sFile = NULL;
 	m_nNbData = NULL;
+	m_nNotifyListen = NULL;
+	m_uNotifyWake = NULL;
+	m_bNotifyFutex = NULL;
+	m_nNotifyHandle = NULL;
+	m_uNotifyPending = NULL;
 	m_cParent = NULL;
 }
 
@@ -170,6 +212,12 @@ bool isl::CSHMConnect::Initialize()
 	}
 	//
 	*m_nNbData = m_cParent->GetNbIOs();
+	//
+	*m_nNotifyListen = 0;
+	*m_uNotifyWake = 0;
+	*m_bNotifyFutex = m_cParent->IsFutex();
+	*m_nNotifyHandle = 0;
+	*m_uNotifyPending = 0;
 	return true;
 }
 
@@ -207,3 +255,59 @@ int isl::CSHMConnect::GetNbData()
 {
 	return *m_nNbData;
 }
+
+bool isl::CSHMConnect::IsNotifyFutex()
+{
+	return *m_bNotifyFutex;
+}
+
+unsigned int * isl::CSHMConnect::GetNotifyWake()
+{
+	return m_uNotifyWake;
+}
+
+void isl::CSHMConnect::AddNotifyListen()
+{
+	CAtomic::FetchAdd(m_nNotifyListen, 1);
+}
+
+void isl::CSHMConnect::CancelNotifyListen()
+{
+	// Unless a writer has already taken the registration
+	int nVal = CAtomic::Load(m_nNotifyListen);
+	while ((nVal > 0) && (CAtomic::CompareExchange(m_nNotifyListen, nVal, nVal - 1) == false)) {
+	}
+}
+
+int isl::CSHMConnect::ResetNotifyListen()
+{
+	// Most of the values are published while nobody waits: no write then
+	if (CAtomic::LoadSeq(m_nNotifyListen) <= 0) {
+		return 0;
+	}
+	return CAtomic::Exchange(m_nNotifyListen, 0);
+}
+
+bool isl::CSHMConnect::IsNotifyHandle()
+{
+	return CAtomic::LoadSeq(m_nNotifyHandle) != 0;
+}
+
+void isl::CSHMConnect::SetNotifyHandle(bool bVal)
+{
+	CAtomic::StoreSeq(m_nNotifyHandle, (bVal ? 1 : 0));
+}
+
+bool isl::CSHMConnect::SetNotifyPending()
+{
+	// Only the first writer signals the handle until the connector resets it
+	if (CAtomic::Load(m_uNotifyPending) != 0) {
+		return false;
+	}
+	return CAtomic::Exchange(m_uNotifyPending, 1u) == 0;
+}
+
+void isl::CSHMConnect::ResetNotifyPending()
+{
+	CAtomic::StoreSeq(m_uNotifyPending, 0u);
+}
@@ -36,8 +36,11 @@
  *     Header files
  */
 
+#include <float.h>
 #include <math.h>
+#include <isl_atomic.h>
 #include <isl_log.h>
+#include <isl_misc.h>
 #include "isl_api.h"
 #include "isl_errorcodes.h"
 #include "isl_settings.h"
@@ -51,7 +54,23 @@
  *     Macros and constants definition
  */
 
-#define MAX_FIFO_DEPTH USHRT_MAX
+
+// Words accessed atomically shall be aligned on their size
+#define SHM_ALIGN(n, a) (((n) + (a) - 1) & ~((a) - 1))
+
+// Fields updated by different processes are kept on separated cache lines
+#define SHM_CACHE_LINE		64
+
+// Segment layout identification ("ISLD")
+#define SHM_DATA_MAGIC		0x444C5349
+#define SHM_DATA_VERSION	6
+
+// Owner of a reader slot: free, being registered, or the process id of the reader
+#define SHM_READER_FREE		0u
+#define SHM_READER_CLAIMED	0xFFFFFFFFu
+
+// Time of a reserved slot: older than any value, never valid for the history searches
+#define SHM_TIME_RESERVED	(-DBL_MAX)
 
 
 /*
@@ -66,39 +85,25 @@ int isl::CSHMData::GetSizeOf(CData * cData)
 	if (cData->GetParent() == NULL) {
 		return 0;
 	}
-	int nSize = sizeof(unsigned int); // m_uId
-	//
-	nSize += sizeof(int); // m_nSizeName
-	nSize += sizeof(char) * CAppSettings().GetMaxSHMStringSize(); // m_sName
-	//
-	nSize += sizeof(CDataType::tType); // m_eType
-	nSize += sizeof(int); // m_nSizeType
-	nSize += sizeof(int); // m_nSize
-	//
-	nSize += sizeof(unsigned short); // m_usIndWrite
-	nSize += sizeof(int); // m_nReaders
-	nSize += sizeof(unsigned short) * cData->GetMaxReaders(); // m_usIndReads
-	//
-	nSize += sizeof(int); // m_nReaderListen
-	nSize += sizeof(int); // m_nWriterListen
-	//
-	nSize += sizeof(bool); // m_bIsTerminated
-	//
-	nSize += sizeof(unsigned short); // m_usFifoDepth
-	nSize += sizeof(double) * (int )(cData->GetMaxFifoDepth()); // m_dTimes
-	nSize += sizeof(double) * (int)(cData->GetMaxFifoDepth()); // m_dSteps
-	//
-	int nSizeVar = cData->GetType()->GetSizeInBytes();
-	if (nSizeVar <= 0) {
-		return 0;
+	CSHMData cLayout(NULL, cData);
+	return cLayout.Map(cData, NULL);
+}
+
+unsigned int isl::CSHMData::GetCapacity(unsigned int uDepth)
+{
+	// The slots are addressed by masking the indexes
+	unsigned int uCapacity = 1;
+	while (uCapacity < uDepth) {
+		uCapacity <<= 1;
 	}
-	nSize += nSizeVar * (int )(cData->GetMaxFifoDepth()); // m_pData
-	//
-	return nSize;
+	return uCapacity;
 }
 
 isl::CSHMData::CSHMData(void * pData, CData * cData)
 {
+	m_uMagic = NULL;
+	m_uVersion = NULL;
+	m_nLayoutSize = NULL;
 	m_uId = NULL;
 	m_nSizeName = NULL;
 	m_sName = NULL;
@@ -106,63 +111,46 @@ isl::CSHMData::CSHMData(void * pData, CData * cData)
 	m_eType = NULL;
 	m_nSizeType = NULL;
 	m_nSize = NULL;
-	m_usIndWrite = NULL;
+	m_uWriteSeq = NULL;
+	m_uIndWrite = NULL;
 	m_nReaders = NULL;
-	m_usIndReads = NULL;
+	m_uIndReads = NULL;
 	m_nReaderListen = NULL;
 	m_nWriterListen = NULL;
+	m_uReaderWake = NULL;
+	m_uWriterWake = NULL;
 	m_bIsTerminated = NULL;
-	m_usFifoDepth = NULL;
+	m_bLockFree = NULL;
+	m_bFutex = NULL;
+	m_bLatest = NULL;
+	m_nBackPressure = NULL;
+	m_uDropped = NULL;
+	m_uFifoDepth = NULL;
+	m_uFifoMask = NULL;
 	m_dTimes = NULL;
 	m_dSteps = NULL;
 	m_pData = NULL;
 	if ((pData != NULL) && (cData != NULL)) {
-		m_uId = (unsigned int *)pData;
-		char * pNext = (char *)pData + sizeof(unsigned int);
-		//
-		m_nSizeName = (int *)pNext;
-		pNext = pNext + sizeof(int);
-		m_sName = (char *)pNext;
-		pNext = pNext + (sizeof(char) * CAppSettings().GetMaxSHMStringSize());
-		//
-		m_eType = (CDataType::tType *)pNext;
-		pNext = pNext + sizeof(CDataType::tType);
-		m_nSizeType = (int *)pNext;
-		pNext = pNext + sizeof(int);
-		m_nSize = (int *)pNext;
-		pNext = pNext + sizeof(int);
-		//
-		m_usIndWrite = (unsigned short *)pNext;
-		pNext = pNext + sizeof(unsigned short);
-		m_nReaders = (int *)pNext;
-		pNext = pNext + sizeof(int);
-		m_usIndReads = (unsigned short *)pNext;
-		pNext = pNext + (sizeof(unsigned short) * cData->GetMaxReaders());
-		//
-		m_nReaderListen = (int *)pNext;
-		pNext = pNext + sizeof(int);
-		m_nWriterListen = (int *)pNext;
-		pNext = pNext + sizeof(int);
-		//
-		m_bIsTerminated = (bool *)pNext;
-		pNext = pNext + sizeof(bool);
-		//
-		m_usFifoDepth = (unsigned short *)pNext;
-		pNext = pNext + sizeof(unsigned short);
-		m_dTimes = (double *)pNext;
-		pNext = pNext + (sizeof(double) * (int )(cData->GetMaxFifoDepth()));
-		m_dSteps = (double *)pNext;
-		pNext = pNext + (sizeof(double) * (int)(cData->GetMaxFifoDepth()));
-		m_pData = (void *)pNext;
+		Map(cData, (char *)pData);
 	}
 	m_cParent = cData;
 	m_nReaderInd = -1;
+	m_uGeneration = 0;
+	m_uOverrunBase = 0;
+	m_bDeferred = false;
+	m_uPending = 0;
+	m_bReserved = false;
+	m_bAcquired = false;
+	m_bTimeWarned = false;
 	m_dStepTolerance = m_cParent->GetStepTolerance();
 	m_dOriginalStep = m_cParent->GetOriginalStep();
 }
 
 isl::CSHMData::~CSHMData()
 {
+	m_uMagic = NULL;
+	m_uVersion = NULL;
+	m_nLayoutSize = NULL;
 	m_uId = NULL;
 	m_nSizeName = NULL;
 	m_sName = NULL;
@@ -170,19 +158,116 @@ isl::CSHMData::~CSHMData()
 	m_eType = NULL;
 	m_nSizeType = NULL;
 	m_nSize = NULL;
-	m_usIndWrite = NULL;
+	m_uWriteSeq = NULL;
+	m_uIndWrite = NULL;
 	m_nReaders = NULL;
-	m_usIndReads = NULL;
+	m_uIndReads = NULL;
 	m_nReaderListen = NULL;
 	m_nWriterListen = NULL;
+	m_uReaderWake = NULL;
+	m_uWriterWake = NULL;
 	m_bIsTerminated = NULL;
-	m_usFifoDepth = NULL;
+	m_bLockFree = NULL;
+	m_bFutex = NULL;
+	m_bLatest = NULL;
+	m_nBackPressure = NULL;
+	m_uDropped = NULL;
+	m_uFifoDepth = NULL;
+	m_uFifoMask = NULL;
 	m_dTimes = NULL;
 	m_dSteps = NULL;
 	m_pData = NULL;
 	m_cParent = NULL;
 }
 
+int isl::CSHMData::Map(CData * cData, char * pBase)
+{
+	int nSizeVar = cData->GetType()->GetSizeInBytes();
+	if (nSizeVar <= 0) {
+		return 0;
+	}
+	// At least 2 slots: in latest mode the newest value is read while the next one is written
+	int nMaxDepth = (int )GetCapacity(cData->GetMaxFifoDepth() < 2 ? 2 : cData->GetMaxFifoDepth());
+	int nOffset = 0;
+	// Reserve nSize bytes aligned on nAlign. Only the size is computed if there is no base address.
+	auto Place = [&nOffset, pBase](int nSize, int nAlign) -> char * {
+		nOffset = SHM_ALIGN(nOffset, nAlign);
+		char * pField = (pBase == NULL ? NULL : pBase + nOffset);
+		nOffset += nSize;
+		return pField;
+	};
+	// Header: written once by the writer, the magic number is set last
+	m_uMagic = (unsigned int *)Place(sizeof(unsigned int), SHM_CACHE_LINE);
+	m_uVersion = (unsigned int *)Place(sizeof(unsigned int), sizeof(unsigned int));
+	m_nLayoutSize = (int *)Place(sizeof(int), sizeof(int));
+	m_uId = (unsigned int *)Place(sizeof(unsigned int), sizeof(unsigned int));
+	m_eType = (CDataType::tType *)Place(sizeof(CDataType::tType), sizeof(int));
+	m_nSizeType = (int *)Place(sizeof(int), sizeof(int));
+	m_nSize = (int *)Place(sizeof(int), sizeof(int));
+	m_uFifoDepth = (unsigned int *)Place(sizeof(unsigned int), sizeof(unsigned int));
+	m_uFifoMask = (unsigned int *)Place(sizeof(unsigned int), sizeof(unsigned int));
+	m_bLockFree = (bool *)Place(sizeof(bool), sizeof(bool));
+	m_bFutex = (bool *)Place(sizeof(bool), sizeof(bool));
+	m_bLatest = (bool *)Place(sizeof(bool), sizeof(bool));
+	m_nBackPressure = (int *)Place(sizeof(int), sizeof(int));
+	m_nSizeName = (int *)Place(sizeof(int), sizeof(int));
+	m_sName = Place(sizeof(char) * CAppSettings().GetMaxSHMStringSize(), sizeof(char));
+	// Writer line
+	m_uWriteSeq = (unsigned int *)Place(sizeof(unsigned int), SHM_CACHE_LINE);
+	m_uIndWrite = (unsigned int *)Place(sizeof(unsigned int), sizeof(unsigned int));
+	m_uDropped = (unsigned int *)Place(sizeof(unsigned int), sizeof(unsigned int));
+	// Readers registration and end of the simulation
+	m_nReaders = (int *)Place(sizeof(int), SHM_CACHE_LINE);
+	m_bIsTerminated = (bool *)Place(sizeof(bool), sizeof(bool));
+	// Waiters: the readers and the writer sleep on separated lines
+	m_nReaderListen = (int *)Place(sizeof(int), SHM_CACHE_LINE);
+	m_uReaderWake = (unsigned int *)Place(sizeof(unsigned int), sizeof(unsigned int));
+	m_nWriterListen = (int *)Place(sizeof(int), SHM_CACHE_LINE);
+	m_uWriterWake = (unsigned int *)Place(sizeof(unsigned int), sizeof(unsigned int));
+	// One line per reader: index, overruns, owner, generation and connector notified
+	m_uIndReads = (unsigned int *)Place(SHM_CACHE_LINE * cData->GetMaxReaders(), SHM_CACHE_LINE);
+	// FIFO slots
+	m_dTimes = (double *)Place(sizeof(double) * nMaxDepth, SHM_CACHE_LINE);
+	m_dSteps = (double *)Place(sizeof(double) * nMaxDepth, SHM_CACHE_LINE);
+	m_pData = (void *)Place(nSizeVar * nMaxDepth, SHM_CACHE_LINE);
+	return SHM_ALIGN(nOffset, SHM_CACHE_LINE);
+}
+
+unsigned int * isl::CSHMData::IndRead(int i)
+{
+	return (unsigned int *)((char *)m_uIndReads + i * SHM_CACHE_LINE);
+}
+
+unsigned int * isl::CSHMData::Overruns(int i)
+{
+	return IndRead(i) + 1;
+}
+
+unsigned int * isl::CSHMData::Owner(int i)
+{
+	return IndRead(i) + 2;
+}
+
+unsigned int * isl::CSHMData::Generation(int i)
+{
+	return IndRead(i) + 3;
+}
+
+unsigned int * isl::CSHMData::Notify(int i)
+{
+	return IndRead(i) + 4;
+}
+
+bool isl::CSHMData::IsActiveReader(int i, int nReaders)
+{
+	if (nReaders == 0) {
+		// No reader yet connected, the first slot is used until then
+		return true;
+	}
+	unsigned int uOwner = CAtomic::LoadSeq(Owner(i));
+	return (uOwner != SHM_READER_FREE) && (uOwner != SHM_READER_CLAIMED);
+}
+
 bool isl::CSHMData::Initialize()
 {
 	if (m_cParent == NULL) {
@@ -194,6 +279,7 @@ bool isl::CSHMData::Initialize()
 			m_cParent->GetId().c_str());
 		return false;
 	}
+	CAtomic::Store(m_uMagic, 0u); // Not valid until fully initialized
 	*m_uId = 0; // Unused for now, but is a reference number in ISL
 	//
 	int nSize = (int )(m_cParent->GetId().size());
@@ -211,24 +297,44 @@ bool isl::CSHMData::Initialize()
 		nSizeVar = 1;
 	}
 	*m_nSize = nSizeVar;
-	*m_usIndWrite = 0;
+	*m_uWriteSeq = 0;
+	*m_uIndWrite = 0;
+	*m_uDropped = 0;
 	*m_nReaders = 0;
 	int nMaxReaders = m_cParent->GetMaxReaders();
 	for (int i = 0; i < nMaxReaders; i++) {
-		m_usIndReads[i] = 0;
+		*IndRead(i) = 0;
+		*Overruns(i) = 0;
+		*Owner(i) = SHM_READER_FREE;
+		*Generation(i) = 0;
+		*Notify(i) = 0;
 	}
 	*m_nReaderListen = 0;
 	*m_nWriterListen = 0;
+	*m_uReaderWake = 0;
+	*m_uWriterWake = 0;
 	*m_bIsTerminated = false;
-	unsigned short usDepth = m_cParent->GetFifoDepth();
+	*m_bLockFree = m_cParent->IsLockFree();
+	*m_bFutex = m_cParent->IsFutex();
+	*m_bLatest = (m_cParent->GetMode() == CVariable::MD_LATEST);
+	*m_nBackPressure = (int )m_cParent->GetBackPressure();
+	unsigned int uDepth = m_cParent->GetFifoDepth();
 #ifdef ISL_DEBUG
-	AppLogDebug(2, ISLSHMDATA_DEBUG, "FIFO depth initialized from parent: %u", usDepth);
+	AppLogDebug(2, ISLSHMDATA_DEBUG, "FIFO depth initialized from parent: %u", uDepth);
 #endif
-	*m_usFifoDepth = usDepth;
-	for (int i = 0; i < (int )usDepth; i++) {
+	*m_uFifoDepth = uDepth;
+	unsigned int uCapacity = GetCapacity(uDepth);
+	if (*m_bLatest && (uCapacity < 2)) {
+		uCapacity = 2;
+	}
+	*m_uFifoMask = uCapacity - 1;
+	for (unsigned int i = 0; i < uCapacity; i++) {
 		m_dTimes[i] = 0.0;
 		m_dSteps[i] = m_dOriginalStep;
 	}
+	*m_uVersion = SHM_DATA_VERSION;
+	*m_nLayoutSize = GetSizeOf(m_cParent);
+	CAtomic::Store(m_uMagic, (unsigned int)SHM_DATA_MAGIC);
 	return true;
 }
 
@@ -244,15 +350,17 @@ bool isl::CSHMData::InitializeData(double dTime)
 			m_cParent->GetId().c_str());
 		return false;
 	}
-	unsigned short usDepth = *m_usFifoDepth;
+	unsigned int uCapacity = *m_uFifoMask + 1;
 	int nSize = *m_nSize;
 	int nSizeType = *m_nSizeType;
 	int nDataSize = nSizeType * nSize;
-	for (int i = 0; i < (int )usDepth; i++) {
+	BeginWrite();
+	for (unsigned int i = 0; i < uCapacity; i++) {
 		m_dTimes[i] = dTime;
 		void * pData = (char *)m_pData + i*nDataSize;
 		MemCopy(pData, pValue, nDataSize, true);
 	}
+	EndWrite();
 	return true;
 }
 
@@ -281,27 +389,114 @@ int isl::CSHMData::GetSize()
 	return *m_nSize;
 }
 
-unsigned short isl::CSHMData::GetFifoDepth()
+unsigned int isl::CSHMData::GetFifoDepth()
+{
+	return *m_uFifoDepth;
+}
+
+unsigned int isl::CSHMData::GetIndWriter()
 {
-	return *m_usFifoDepth;
+	return CAtomic::Load(m_uIndWrite) & *m_uFifoMask;
 }
 
-unsigned short isl::CSHMData::GetIndWriter()
+unsigned int isl::CSHMData::GetIndReader(int i)
 {
-	return *m_usIndWrite;
+	return CAtomic::Load(IndRead(i)) & *m_uFifoMask;
 }
 
-unsigned short isl::CSHMData::GetIndReader(int i)
+bool isl::CSHMData::SetReader(unsigned int uNotify)
 {
-	return m_usIndReads[i];
+	if (m_nReaderInd != -1) {
+		return true;
+	}
+	unsigned int uPID = (unsigned int)CApplication::GetProcessId();
+	int nMaxReaders = m_cParent->GetMaxReaders();
+	for (int i = 0; i < nMaxReaders; i++) {
+		unsigned int uOwner = SHM_READER_FREE;
+		if (CAtomic::CompareExchange(Owner(i), uOwner, SHM_READER_CLAIMED) == false) {
+			continue;
+		}
+		// A slot never used keeps its index: the values written before the connection are read.
+		// A slot released by a previous reader starts at the values not yet published.
+		unsigned int uGeneration = CAtomic::Load(Generation(i));
+		unsigned int uRead = CAtomic::LoadSeq(m_uIndWrite);
+		if (uGeneration != 0) {
+			// In latest mode, the newest value is still to be read
+			if (*m_bLatest && (uRead != 0)) {
+				uRead--;
+			}
+			CAtomic::StoreSeq(IndRead(i), uRead);
+		}
+		m_uGeneration = uGeneration + 1;
+		CAtomic::Store(Generation(i), m_uGeneration);
+		CAtomic::Store(Notify(i), uNotify);
+		CAtomic::StoreSeq(Owner(i), uPID);
+		if ((uGeneration != 0) && (*m_bLatest == false)) {
+			// The writer ignored the slot until now: it may have gone past the index meanwhile
+			unsigned int uWrite = CAtomic::LoadSeq(m_uIndWrite);
+			if (uWrite != uRead) {
+				CAtomic::CompareExchange(IndRead(i), uRead, uWrite);
+			}
+		}
+		int nReaders = CAtomic::Load(m_nReaders);
+		while ((nReaders <= i) && (CAtomic::CompareExchange(m_nReaders, nReaders, i + 1) == false)) {
+		}
+		m_nReaderInd = i;
+		// The values dropped before the connection are not counted
+		m_uOverrunBase = CAtomic::Load(Overruns(i));
+		return true;
+	}
+	return false;
 }
 
-void isl::CSHMData::SetReader()
+void isl::CSHMData::ReleaseReader()
 {
 	if (m_nReaderInd == -1) {
-		m_nReaderInd = *m_nReaders;
-		*m_nReaders = m_nReaderInd + 1;
+		return;
+	}
+	// The slot may have been reclaimed then given to another reader
+	if (CAtomic::Load(Generation(m_nReaderInd)) == m_uGeneration) {
+		unsigned int uOwner = (unsigned int)CApplication::GetProcessId();
+		CAtomic::CompareExchange(Owner(m_nReaderInd), uOwner, SHM_READER_FREE);
+	}
+	m_nReaderInd = -1;
+}
+
+int isl::CSHMData::GetReaderSlots()
+{
+	return CAtomic::Load(m_nReaders);
+}
+
+unsigned int isl::CSHMData::GetReaderNotify(int i, unsigned int * uGeneration)
+{
+	unsigned int uOwner = CAtomic::LoadSeq(Owner(i));
+	if ((uOwner == SHM_READER_FREE) || (uOwner == SHM_READER_CLAIMED)) {
+		return 0;
 	}
+	*uGeneration = CAtomic::Load(Generation(i));
+	return CAtomic::Load(Notify(i));
+}
+
+int isl::CSHMData::ReclaimReaders()
+{
+	int nReclaimed = 0;
+	int nReaders = CAtomic::LoadSeq(m_nReaders);
+	for (int i = 0; i < nReaders; i++) {
+		unsigned int uOwner = CAtomic::LoadSeq(Owner(i));
+		if ((uOwner == SHM_READER_FREE) || (uOwner == SHM_READER_CLAIMED)) {
+			continue;
+		}
+		if (CApplication::IsProcessAlive(uOwner)) {
+			continue;
+		}
+		if (CAtomic::CompareExchange(Owner(i), uOwner, SHM_READER_FREE)) {
+			AppLogWarning(ISLSHMDATA_READER_RECLAIMED,
+				"[%s] The process %u of reader %d ended without disconnecting: its slot is released.",
+				(m_sName == NULL ? "unknown" : m_sName), uOwner, i);
+			nReclaimed++;
+		}
+	}
+	return nReclaimed;
 }
 
 bool isl::CSHMData::IsReader()
@@ -311,50 +506,131 @@ bool isl::CSHMData::IsReader()
 
 int isl::CSHMData::GetReaderListen()
 {
-	return *m_nReaderListen;
+	return CAtomic::Load(m_nReaderListen);
 }
 
 int isl::CSHMData::GetReaders()
 {
-	return *m_nReaders;
+	int nReaders = CAtomic::Load(m_nReaders);
+	int nActive = 0;
+	for (int i = 0; i < nReaders; i++) {
+		if (IsActiveReader(i, nReaders)) {
+			nActive++;
+		}
+	}
+	return nActive;
 }
 
 void isl::CSHMData::SetReaderListen(int nVal)
 {
-	*m_nReaderListen = nVal;
+	CAtomic::Store(m_nReaderListen, nVal);
 }
 
 int isl::CSHMData::GetWriterListen()
 {
-	return *m_nWriterListen;
+	return CAtomic::Load(m_nWriterListen);
 }
 
 void isl::CSHMData::SetWriterListen(int nVal)
 {
-	*m_nWriterListen = nVal;
+	CAtomic::Store(m_nWriterListen, nVal);
+}
+
+int isl::CSHMData::ResetReaderListen()
+{
+	// Read first: the line is only taken exclusive when someone listens
+	CAtomic::FenceSeq();
+	if (CAtomic::Load(m_nReaderListen) <= 0) {
+		return 0;
+	}
+	return CAtomic::Exchange(m_nReaderListen, 0);
+}
+
+int isl::CSHMData::ResetWriterListen()
+{
+	// Read first: the line is only taken exclusive when someone listens
+	CAtomic::FenceSeq();
+	if (CAtomic::Load(m_nWriterListen) <= 0) {
+		return 0;
+	}
+	return CAtomic::Exchange(m_nWriterListen, 0);
 }
 
 void isl::CSHMData::SetTerminated()
 {
-	*m_bIsTerminated = true;
+	CAtomic::StoreSeq(m_bIsTerminated, true);
 }
 
 bool isl::CSHMData::IsTerminated()
 {
-	return *m_bIsTerminated;
+	return CAtomic::Load(m_bIsTerminated);
+}
+
+bool isl::CSHMData::IsInitialized()
+{
+	return (CAtomic::Load(m_uMagic) == SHM_DATA_MAGIC);
+}
+
+bool isl::CSHMData::IsCompatible()
+{
+	// Same layout version and same settings (string size, FIFO depth, readers) as the writer
+	return (*m_uVersion == SHM_DATA_VERSION) && (*m_nLayoutSize == GetSizeOf(m_cParent));
+}
+
+bool isl::CSHMData::IsLockFree()
+{
+	return *m_bLockFree;
+}
+
+bool isl::CSHMData::IsFutex()
+{
+	return *m_bFutex;
+}
+
+bool isl::CSHMData::IsLatest()
+{
+	return *m_bLatest;
+}
+
+isl::CVariable::tBackPressure isl::CSHMData::GetBackPressure()
+{
+	return (CVariable::tBackPressure )*m_nBackPressure;
+}
+
+unsigned int isl::CSHMData::GetOverruns()
+{
+	if (m_nReaderInd == -1) {
+		return 0;
+	}
+	return CAtomic::Load(Overruns(m_nReaderInd)) - m_uOverrunBase;
+}
+
+unsigned int isl::CSHMData::GetDropped()
+{
+	return CAtomic::Load(m_uDropped);
+}
+
+unsigned int * isl::CSHMData::GetWriterWake()
+{
+	return m_uWriterWake;
+}
+
+unsigned int * isl::CSHMData::GetReaderWake()
+{
+	return m_uReaderWake;
 }
 
 bool isl::CSHMData::IsFifoFullForReader()
 {
-	unsigned short usWrite = *m_usIndWrite;
-	unsigned short usDepth = *m_usFifoDepth;
-	unsigned short usRead = m_usIndReads[m_nReaderInd];
+	unsigned int uWrite = CAtomic::Load(m_uIndWrite);
+	unsigned int uDepth = *m_uFifoDepth;
+	unsigned int uRead = *IndRead(m_nReaderInd);
 #ifdef ISL_DEBUG
-	AppLogDebug(2, ISLSHMDATA_DEBUG, "IsFifoFullForReader[%d]? W:%d - R:%d ? %d",
-		m_nReaderInd, usWrite, usRead, usDepth);
+	AppLogDebug(2, ISLSHMDATA_DEBUG, "IsFifoFullForReader[%d]? W:%u - R:%u ? %u",
+		m_nReaderInd, uWrite, uRead, uDepth);
 #endif
-	int nNbElts = (int)usWrite - (int)usRead;
-	if ((nNbElts == (int)usDepth - 1) || (nNbElts == -1)) {
+	// The counters may wrap: the difference is still the number of elements
+	if (uWrite - uRead >= uDepth - 1) {
 		// The FIFO is full
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLSHMDATA_DEBUG, "YES");
@@ -373,24 +649,28 @@ bool isl::CSHMData::IsFifoFullForReader()
 
 bool isl::CSHMData::IsFifoFull()
 {
-	unsigned short usWrite = *m_usIndWrite;
-	unsigned short usDepth = *m_usFifoDepth;
-	int nReaders = *m_nReaders;
-	if (nReaders == 0) {
-		// No reader yet connected, we still need to wait then
-		// use the first one which should be set to 0
-		nReaders = 1;
+	if (*m_bLatest) {
+		// The writer never waits: the oldest slots are overwritten
+		return false;
 	}
-	for (int i = 0; i < nReaders; i++) {
+	unsigned int uWrite = GetWriteInd();
+	unsigned int uDepth = *m_uFifoDepth;
+	int nReaders = CAtomic::LoadSeq(m_nReaders);
+	// No reader yet connected, we still need to wait then
+	// use the first one which should be set to 0
+	int nSlots = (nReaders == 0 ? 1 : nReaders);
+	for (int i = 0; i < nSlots; i++) {
+		if (IsActiveReader(i, nReaders) == false) {
+			continue;
+		}
 		// If only one reader verify the condition
 		// then the FIFO is considered as full
-		unsigned short usRead = m_usIndReads[i];
+		unsigned int uRead = CAtomic::LoadSeq(IndRead(i));
 #ifdef ISL_DEBUG
-		AppLogDebug(2, ISLSHMDATA_DEBUG, "FIFO full for reader[%d]? W:%d - R:%d ? %d",
-			i, usWrite, usRead, usDepth);
+		AppLogDebug(2, ISLSHMDATA_DEBUG, "FIFO full for reader[%d]? W:%u - R:%u ? %u",
+			i, uWrite, uRead, uDepth);
 #endif
-		int nNbElts = (int)usWrite - (int)usRead;
-		if ((nNbElts == (int)usDepth - 1) || (nNbElts == -1)) {
+		if (uWrite - uRead >= uDepth - 1) {
 			// The FIFO is full
 #ifdef ISL_DEBUG
 			AppLogDebug(2, ISLSHMDATA_DEBUG, "YES");
@@ -408,17 +688,205 @@ bool isl::CSHMData::IsFifoFull()
 	return false;
 }
 
+unsigned int isl::CSHMData::GetFreeSlots()
+{
+	unsigned int uWrite = GetWriteInd();
+	unsigned int uMax = *m_uFifoDepth - 1;
+	unsigned int uFree = uMax;
+	if (*m_bLatest) {
+		// The slots written but not yet published shall not wrap around the newest value
+		return *m_uFifoMask - m_uPending;
+	}
+	int nReaders = CAtomic::LoadSeq(m_nReaders);
+	// As in IsFifoFull, the first reader is used
+	int nSlots = (nReaders == 0 ? 1 : nReaders);
+	for (int i = 0; i < nSlots; i++) {
+		if (IsActiveReader(i, nReaders) == false) {
+			continue;
+		}
+		// The slowest reader gives the free space
+		unsigned int uUsed = uWrite - CAtomic::LoadSeq(IndRead(i));
+		if (uUsed >= uMax) {
+			return 0;
+		}
+		if (uMax - uUsed < uFree) {
+			uFree = uMax - uUsed;
+		}
+	}
+	return uFree;
+}
+
+bool isl::CSHMData::AcquireRoom(bool * bListen, bool * bDropped)
+{
+	*bDropped = false;
+	if (IsFifoFull() == false) {
+		return true;
+	}
+	switch (*m_nBackPressure) {
+		case CVariable::BP_DROPOLDEST:
+			DropOldest(1);
+			return true;
+		case CVariable::BP_DROPNEWEST:
+			CAtomic::Store(m_uDropped, *m_uDropped + 1);
+			*bDropped = true;
+			return false;
+		default:
+			break;
+	}
+	if (bListen == NULL) {
+		// Not waiting: the caller retries, a reader which process ended shall not block it forever
+		return (ReclaimReaders() > 0) && (IsFifoFull() == false);
+	}
+	// Shall wait to write the value
+	CAtomic::FetchAdd(m_nWriterListen, 1);
+	// In lock-free mode a reader may have released a slot
+	// just before the registration, then check it again
+	bool bIsFull = (IsLockFree() == false) || IsFifoFull();
+	*bListen = bIsFull;
+	return (bIsFull == false);
+}
+
+void isl::CSHMData::DropOldest(unsigned int uCount)
+{
+	unsigned int uWrite = GetWriteInd();
+	unsigned int uMax = *m_uFifoDepth - 1;
+	if ((int)(uWrite + uCount - uMax - *m_uIndWrite) > 0) {
+		// A reader cannot skip values not yet published: the frame is published now
+		Commit();
+	}
+	int nReaders = CAtomic::LoadSeq(m_nReaders);
+	// As in IsFifoFull, the first reader is used
+	int nSlots = (nReaders == 0 ? 1 : nReaders);
+	for (int i = 0; i < nSlots; i++) {
+		if (IsActiveReader(i, nReaders) == false) {
+			continue;
+		}
+		unsigned int uRead = CAtomic::LoadSeq(IndRead(i));
+		// The reader moves its index with the same compare and exchange: only one of us succeeds
+		while (uWrite + uCount - uRead > uMax) {
+			unsigned int uNewRead = uWrite + uCount - uMax;
+			if (CAtomic::CompareExchange(IndRead(i), uRead, uNewRead)) {
+				CAtomic::FetchAdd(Overruns(i), uNewRead - uRead);
+#ifdef ISL_DEBUG
+				AppLogDebug(2, ISLSHMDATA_DEBUG, "[%s] Reader %d overrun by %u value(s)",
+					(m_sName == NULL ? "unknown" : m_sName), i, uNewRead - uRead);
+#endif
+				break;
+			}
+		}
+	}
+}
+
+bool isl::CSHMData::MoveReadInd(unsigned int uRead, unsigned int uNewRead)
+{
+	if (*m_nBackPressure != CVariable::BP_DROPOLDEST) {
+		CAtomic::StoreSeq(IndRead(m_nReaderInd), uNewRead);
+		return true;
+	}
+	// Fails if the writer skipped the values meanwhile: they may have been overwritten
+	return CAtomic::CompareExchange(IndRead(m_nReaderInd), uRead, uNewRead);
+}
+
+unsigned int isl::CSHMData::GetWriteInd()
+{
+	// The values not yet published are already in the FIFO
+	return *m_uIndWrite + m_uPending;
+}
+
+void isl::CSHMData::Publish(unsigned int uWrite)
+{
+	// In latest mode the values are published before the ring wraps around the newest one
+	if (m_bDeferred && ((*m_bLatest == false) || (uWrite - *m_uIndWrite < *m_uFifoMask))) {
+		m_uPending = uWrite - *m_uIndWrite;
+		return;
+	}
+	CAtomic::StoreSeq(m_uIndWrite, uWrite);
+	m_uPending = 0;
+}
+
+void isl::CSHMData::SetDeferred(bool bVal)
+{
+	m_bDeferred = bVal;
+}
+
+bool isl::CSHMData::IsDeferred()
+{
+	return m_bDeferred;
+}
+
+bool isl::CSHMData::Commit()
+{
+	if (m_uPending == 0) {
+		return false;
+	}
+#ifdef ISL_DEBUG
+	AppLogDebug(2, ISLSHMDATA_DEBUG, "[%s] Commit %u value(s)",
+		(m_sName == NULL ? "unknown" : m_sName), m_uPending);
+#endif
+	CAtomic::StoreSeq(m_uIndWrite, *m_uIndWrite + m_uPending);
+	m_uPending = 0;
+	return true;
+}
+
 bool isl::CSHMData::IsFifoEmpty()
 {
 	if (m_nReaderInd == -1) {
 		return false;
 	}
-	unsigned short usWrite = *m_usIndWrite;
-	unsigned short usRead = m_usIndReads[m_nReaderInd];
+	return IsFifoEmpty(*IndRead(m_nReaderInd));
+}
+
+bool isl::CSHMData::IsDataReady(double dInTime)
+{
+	if (IsReader() == false) {
+		return false;
+	}
+	unsigned int uMask = *m_uFifoMask;
+	while (true) {
+		// Same conditions as FindData and GetLatest, without reading the value
+		unsigned int uSeq = BeginRead();
+		unsigned int uWrite = CAtomic::LoadSeq(m_uIndWrite);
+		unsigned int uRead = CAtomic::Load(IndRead(m_nReaderInd));
+		bool bReady = false;
+		if (*m_bLatest) {
+			// The newest value, unless the writer has not reached the requested time yet
+			bReady = (uWrite != 0) && ((round(m_dTimes[(uWrite - 1) & uMask]) == EVENT_DEF_TIME_VAL)
+				|| (IsSuperseded(uWrite - 1, dInTime) == false));
+		}
+		else if (round(m_dTimes[uRead & uMask]) == EVENT_DEF_TIME_VAL) {
+			bReady = (uWrite != uRead);
+		}
+		else if (uWrite != uRead) {
+			// The superseded values are skipped: the newest one decides
+			bReady = (IsSuperseded(uWrite - 1, dInTime) == false);
+		}
+		else {
+			int nInd = (int)(uRead & uMask);
+			double dStep = m_dSteps[nInd];
+			double dTolerance = m_dStepTolerance * (dStep < 0.0 ? 0.0 : dStep);
+			if (dInTime < m_dTimes[nInd] - dTolerance) {
+				// Searched in the history
+				bReady = true;
+			}
+			else {
+				// The most recent value, if it is valid until further notice
+				int nPosOk = SearchHistory(uRead, uMask, dInTime + dTolerance);
+				bReady = (nPosOk != -1) && (m_dSteps[nPosOk] < 0.0) && (m_dTimes[nPosOk] > -1.0);
+			}
+		}
+		if (EndRead(uSeq)) {
+			return bReady;
+		}
+	}
+}
+
+bool isl::CSHMData::IsFifoEmpty(unsigned int uRead)
+{
+	unsigned int uWrite = CAtomic::LoadSeq(m_uIndWrite);
 #ifdef ISL_DEBUG
-	AppLogDebug(2, ISLSHMDATA_DEBUG, "FIFO empty? W:%d ? R:%d", usWrite, usRead);
+	AppLogDebug(2, ISLSHMDATA_DEBUG, "FIFO empty? W:%u ? R:%u", uWrite, uRead);
 #endif
-	if (usWrite == usRead) {
+	if (uWrite == uRead) {
 		// The FIFO is empty
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLSHMDATA_DEBUG, "YES");
@@ -437,15 +905,14 @@ bool isl::CSHMData::IsFifoEmpty()
 
 bool isl::CSHMData::SetData(void * pData, double dTime, bool * bListen)
 {
-	if (IsReader()) {
+	if (IsReader() || (IsTimeOrdered(dTime) == false)) {
 		return false;
 	}
-	if (IsFifoFull()) {
-		// Shall wait to write the value
-		if (bListen != NULL) {
-			int nVal = *m_nWriterListen;
-			*m_nWriterListen = nVal + 1;
-			*bListen = true;
+	bool bDropped = false;
+	if (AcquireRoom(bListen, &bDropped) == false) {
+		if (bDropped) {
+			// Drop-newest policy: the value is discarded
+			return true;
 		}
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLSHMDATA_DEBUG,
@@ -453,9 +920,8 @@ bool isl::CSHMData::SetData(void * pData, double dTime, bool * bListen)
 #endif
 		return false;
 	}
-	unsigned short usInd = *m_usIndWrite;
-	unsigned short usDepth = *m_usFifoDepth;
-	int nInd = (int )usInd;
+	unsigned int uWrite = GetWriteInd();
+	int nInd = (int )(uWrite & *m_uFifoMask);
 	int nSize = (*m_nSizeType)*(*m_nSize);
 	//
 #ifdef ISL_DEBUG
@@ -466,18 +932,16 @@ bool isl::CSHMData::SetData(void * pData, double dTime, bool * bListen)
 	AppLogDebug(2, ISLSHMDATA_DEBUG, "[%s] Set Data(data, time:%g, listen:%d)",
 		(m_sName == NULL ? "unknown" : m_sName), dTime, (bListen == NULL ? -1 : *bListen));
 #endif
+	BeginWrite();
 	void * pElement = (char *)m_pData + nInd * nSize;
 	//memcpy(pElement, pData, nSize);
 	MemCopy(pElement, pData, nSize, true);
 	m_dTimes[nInd] = dTime;
 	m_dSteps[nInd] = m_dOriginalStep;
 	//
-	if (usInd == usDepth - 1) {
-		*m_usIndWrite = 0;
-	}
-	else {
-		*m_usIndWrite = usInd + 1;
-	}
+	// Publish the new value
+	Publish(uWrite + 1);
+	EndWrite();
 	//
 	if (bListen != NULL) {
 		*bListen = false;
@@ -487,15 +951,14 @@ bool isl::CSHMData::SetData(void * pData, double dTime, bool * bListen)
 
 bool isl::CSHMData::SetData(void * pData, double dTime, double dStep, bool * bListen)
 {
-	if (IsReader()) {
+	if (IsReader() || (IsTimeOrdered(dTime) == false)) {
 		return false;
 	}
-	if (IsFifoFull()) {
-		// Shall wait to write the value
-		if (bListen != NULL) {
-			int nVal = *m_nWriterListen;
-			*m_nWriterListen = nVal + 1;
-			*bListen = true;
+	bool bDropped = false;
+	if (AcquireRoom(bListen, &bDropped) == false) {
+		if (bDropped) {
+			// Drop-newest policy: the value is discarded
+			return true;
 		}
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLSHMDATA_DEBUG,
@@ -503,9 +966,8 @@ bool isl::CSHMData::SetData(void * pData, double dTime, double dStep, bool * bLi
 #endif
 		return false;
 	}
-	unsigned short usInd = *m_usIndWrite;
-	unsigned short usDepth = *m_usFifoDepth;
-	int nInd = (int)usInd;
+	unsigned int uWrite = GetWriteInd();
+	int nInd = (int)(uWrite & *m_uFifoMask);
 	int nSize = (*m_nSizeType)*(*m_nSize);
 	//
 #ifdef ISL_DEBUG
@@ -515,18 +977,16 @@ bool isl::CSHMData::SetData(void * pData, double dTime, double dStep, bool * bLi
 	AppLogDebug(2, ISLSHMDATA_DEBUG, "[%s] Set Data(data, time:%g, step:%g, listen:%d)",
 		(m_sName == NULL ? "unknown" : m_sName), dTime, dStep, (bListen == NULL ? -1 : *bListen));
 #endif
+	BeginWrite();
 	void * pElement = (char *)m_pData + nInd * nSize;
 	//memcpy(pElement, pData, nSize);
 	MemCopy(pElement, pData, nSize, true);
 	m_dTimes[nInd] = dTime;
 	m_dSteps[nInd] = dStep;
 	//
-	if (usInd == usDepth - 1) {
-		*m_usIndWrite = 0;
-	}
-	else {
-		*m_usIndWrite = usInd + 1;
-	}
+	// Publish the new value
+	Publish(uWrite + 1);
+	EndWrite();
 	//
 	if (bListen != NULL) {
 		*bListen = false;
@@ -536,15 +996,14 @@ bool isl::CSHMData::SetData(void * pData, double dTime, double dStep, bool * bLi
 
 bool isl::CSHMData::SetLastData(double dTime, double dStep, bool * bListen)
 {
-	if (IsReader()) {
+	if (IsReader() || (IsTimeOrdered(dTime) == false)) {
 		return false;
 	}
-	if (IsFifoFull()) {
-		// Shall wait to write the value
-		if (bListen != NULL) {
-			int nVal = *m_nWriterListen;
-			*m_nWriterListen = nVal + 1;
-			*bListen = true;
+	bool bDropped = false;
+	if (AcquireRoom(bListen, &bDropped) == false) {
+		if (bDropped) {
+			// Drop-newest policy: the value is discarded
+			return true;
 		}
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLSHMDATA_DEBUG,
@@ -552,56 +1011,183 @@ bool isl::CSHMData::SetLastData(double dTime, double dStep, bool * bListen)
 #endif
 		return false;
 	}
-	unsigned short usInd = *m_usIndWrite;
-	unsigned short usIndm1 = usInd - 1;
-	unsigned short usDepth = *m_usFifoDepth;
-	if (usInd == 0) {
-		usIndm1 = usDepth - 1;
-	}
-	int nInd = (int)usInd;
-	int nIndm1 = (int)usIndm1;
+	unsigned int uWrite = GetWriteInd();
+	int nInd = (int)(uWrite & *m_uFifoMask);
+	int nIndm1 = (int)((uWrite - 1) & *m_uFifoMask);
 	int nSize = (*m_nSizeType)*(*m_nSize);
 	//
 #ifdef ISL_DEBUG
 	AppLogDebug(2, ISLSHMDATA_DEBUG,
 		"[SL2] Set data in pos:%d for time: %gs.", nInd, dTime);
 #endif
+	BeginWrite();
 	void * pData = (char *)m_pData + nIndm1 * nSize;
 	void * pElement = (char *)m_pData + nInd * nSize;
 	memcpy(pElement, pData, nSize);
 	m_dTimes[nInd] = dTime;
 	m_dSteps[nInd] = dStep;
 	//
-	if (usInd == usDepth - 1) {
-		*m_usIndWrite = 0;
+	// Publish the new value
+	Publish(uWrite + 1);
+	EndWrite();
+	//
+	if (bListen != NULL) {
+		*bListen = false;
 	}
-	else {
-		*m_usIndWrite = usInd + 1;
+	return true;
+}
+
+void * isl::CSHMData::ReserveSlot(bool * bListen)
+{
+	if (IsReader()) {
+		return NULL;
 	}
-	//
+	unsigned int uWrite = GetWriteInd();
+	int nSize = (*m_nSizeType)*(*m_nSize);
+	if (m_bReserved) {
+		return (char *)m_pData + (uWrite & *m_uFifoMask) * nSize;
+	}
+	bool bDropped = false;
+	if (AcquireRoom(bListen, &bDropped) == false) {
+		// With the drop-newest policy, no slot is given and the value is counted as dropped
+		return NULL;
+	}
+	// The slot may still be searched as the oldest past value (within a frame):
+	// it is invalidated, then filled by the caller outside of the sequence
+	int nInd = (int)(uWrite & *m_uFifoMask);
+	BeginWrite();
+	m_dTimes[nInd] = SHM_TIME_RESERVED;
+	EndWrite();
+	m_bReserved = true;
 	if (bListen != NULL) {
 		*bListen = false;
 	}
+	return (char *)m_pData + nInd * nSize;
+}
+
+bool isl::CSHMData::CommitSlot(double dTime, double dStep)
+{
+	if (m_bReserved == false) {
+		return false;
+	}
+	if (IsTimeOrdered(dTime) == false) {
+		// The slot is given back invalid, nothing was published
+		m_bReserved = false;
+		return false;
+	}
+	unsigned int uWrite = GetWriteInd();
+	int nInd = (int)(uWrite & *m_uFifoMask);
+#ifdef ISL_DEBUG
+	AppLogDebug(2, ISLSHMDATA_DEBUG, "[SC] Commit slot in pos:%d for time: %gs.", nInd, dTime);
+#endif
+	BeginWrite();
+	m_dTimes[nInd] = dTime;
+	m_dSteps[nInd] = dStep;
+	//
+	// Publish the new value
+	Publish(uWrite + 1);
+	EndWrite();
+	m_bReserved = false;
 	return true;
 }
 
+int isl::CSHMData::SetDataBatch(void * pData, double * dTimes, double * dSteps, int nCount, bool * bListen)
+{
+	if (IsReader() || (nCount <= 0)) {
+		return 0;
+	}
+	// Only the values which times do not decrease are written
+	int nOrdered = 0;
+	while ((nOrdered < nCount) && IsTimeOrdered(dTimes[nOrdered], (nOrdered == 0 ? NULL : dTimes + nOrdered - 1))) {
+		nOrdered++;
+	}
+	nCount = nOrdered;
+	if (nCount == 0) {
+		return 0;
+	}
+	unsigned int uFree = GetFreeSlots();
+	if ((uFree < (unsigned int)nCount) && (*m_nBackPressure == CVariable::BP_DROPOLDEST)) {
+		// Room is made for the whole batch, up to the FIFO depth
+		unsigned int uMax = *m_uFifoDepth - 1;
+		DropOldest((unsigned int)nCount < uMax ? (unsigned int)nCount : uMax);
+		uFree = GetFreeSlots();
+	}
+	if (uFree == 0) {
+		if (*m_nBackPressure == CVariable::BP_DROPNEWEST) {
+			// The values are discarded
+			CAtomic::Store(m_uDropped, *m_uDropped + (unsigned int)nCount);
+			return nCount;
+		}
+		// Shall wait to write the values
+		if (bListen != NULL) {
+			CAtomic::FetchAdd(m_nWriterListen, 1);
+			// In lock-free mode a reader may have released a slot
+			// just before the registration, then check it again
+			uFree = (IsLockFree() ? GetFreeSlots() : 0);
+			*bListen = (uFree == 0);
+		}
+		else if (ReclaimReaders() > 0) {
+			// Not waiting: a reader which process ended shall not block the writer forever
+			uFree = GetFreeSlots();
+		}
+		if (uFree == 0) {
+#ifdef ISL_DEBUG
+			AppLogDebug(2, ISLSHMDATA_DEBUG,
+				"[SB1] Set data batch for time: %gs. Wait for available space", dTimes[0]);
+#endif
+			return 0;
+		}
+	}
+	unsigned int uCount = ((unsigned int)nCount < uFree ? (unsigned int)nCount : uFree);
+	unsigned int uWrite = GetWriteInd();
+	unsigned int uMask = *m_uFifoMask;
+	int nSize = (*m_nSizeType)*(*m_nSize);
+#ifdef ISL_DEBUG
+	AppLogDebug(2, ISLSHMDATA_DEBUG, "[SB2] Set %u data from pos:%u for time: %gs.",
+		uCount, uWrite & uMask, dTimes[0]);
+#endif
+	BeginWrite();
+	for (unsigned int i = 0; i < uCount; i++) {
+		int nInd = (int)((uWrite + i) & uMask);
+		MemCopy((char *)m_pData + nInd * nSize, (char *)pData + i * nSize, nSize, true);
+		m_dTimes[nInd] = dTimes[i];
+		m_dSteps[nInd] = (dSteps == NULL ? m_dOriginalStep : dSteps[i]);
+	}
+	//
+	// Publish all the new values at once
+	Publish(uWrite + uCount);
+	EndWrite();
+	//
+	if (bListen != NULL) {
+		*bListen = false;
+	}
+	return (int)uCount;
+}
+
 bool isl::CSHMData::GetData(void * pData, double * dTime, double * dStep, bool * bListen)
 {
 	if (IsReader() == false) {
 		return false;
 	}
+	if (*m_bLatest) {
+		return GetLatest(pData, dTime, dStep, bListen);
+	}
 	if (IsFifoEmpty()) {
 		// Shall wait to write the value
+		bool bIsEmpty = true;
 		if (bListen != NULL) {
-			int nVal = *m_nReaderListen;
-			*m_nReaderListen = nVal + 1;
-			*bListen = true;
+			CAtomic::FetchAdd(m_nReaderListen, 1);
+			// In lock-free mode the writer may have published a value
+			// just before the registration, then check it again
+			bIsEmpty = (IsLockFree() == false) || IsFifoEmpty();
+			*bListen = bIsEmpty;
+		}
+		if (bIsEmpty) {
+			return false;
 		}
-		return false;
 	}
-	unsigned short usInd = m_usIndReads[m_nReaderInd];
-	unsigned short usDepth = *m_usFifoDepth;
-	int nInd = (int)usInd;
+	unsigned int uRead = CAtomic::Load(IndRead(m_nReaderInd));
+	int nInd = (int)(uRead & *m_uFifoMask);
 	int nSize = (*m_nSizeType)*(*m_nSize);
 #ifdef ISL_DEBUG
 	AppLogDebug(2, ISLSHMDATA_DEBUG, "[%s] Get Data(data, outtime, outstep, listen:%d)",
@@ -613,85 +1199,319 @@ bool isl::CSHMData::GetData(void * pData, double * dTime, double * dStep, bool *
 	MemCopy(pData, pElement, nSize, false);
 	*dTime = m_dTimes[nInd];
 	//
+	// Release the slot
+	if (MoveReadInd(uRead, uRead + 1) == false) {
+		// Overrun by the writer: read the oldest value kept
+		return GetData(pData, dTime, dStep, bListen);
+	}
 	if (bListen != NULL) {
 		*bListen = false;
 	}
-	if (usInd == usDepth - 1) {
-		m_usIndReads[m_nReaderInd] = 0;
+	//
+	return true;
+}
+
+void * isl::CSHMData::AcquireReadSlot(double * dTime, double * dStep, bool * bListen)
+{
+	if ((IsReader() == false) || *m_bLatest || (*m_nBackPressure == CVariable::BP_DROPOLDEST)) {
+		// The slot could be overwritten while it is used
+		return NULL;
 	}
-	else {
-		m_usIndReads[m_nReaderInd] = usInd + 1;
+	unsigned int uRead = *IndRead(m_nReaderInd);
+	int nSize = (*m_nSizeType)*(*m_nSize);
+	if ((m_bAcquired == false) && IsFifoEmpty()) {
+		// Shall wait to get a value
+		bool bIsEmpty = true;
+		if (bListen != NULL) {
+			CAtomic::FetchAdd(m_nReaderListen, 1);
+			// In lock-free mode the writer may have published a value
+			// just before the registration, then check it again
+			bIsEmpty = (IsLockFree() == false) || IsFifoEmpty();
+			*bListen = bIsEmpty;
+		}
+		if (bIsEmpty) {
+			return NULL;
+		}
 	}
-	//
+	// The slot cannot be overwritten until it is released
+	int nInd = (int)(uRead & *m_uFifoMask);
+	*dTime = m_dTimes[nInd];
+	*dStep = m_dSteps[nInd];
+	m_bAcquired = true;
+	if (bListen != NULL) {
+		*bListen = false;
+	}
+	return (char *)m_pData + nInd * nSize;
+}
+
+bool isl::CSHMData::ReleaseReadSlot()
+{
+	if (m_bAcquired == false) {
+		return false;
+	}
+	m_bAcquired = false;
+	CAtomic::StoreSeq(IndRead(m_nReaderInd), *IndRead(m_nReaderInd) + 1);
 	return true;
 }
 
-// TODO : Create a function that will get the closest value even if already read
-// in the condition that the FIFO already contain read data.
+int isl::CSHMData::GetDataBatch(void * pData, double * dTimes, double * dSteps, int nCount, bool * bListen)
+{
+	if ((IsReader() == false) || (nCount <= 0)) {
+		return 0;
+	}
+	if (*m_bLatest) {
+		// Only the newest value is available
+		double dTime = 0.0;
+		double dStep = 0.0;
+		if (GetLatest(pData, &dTime, &dStep, bListen) == false) {
+			return 0;
+		}
+		if (dTimes != NULL) {
+			dTimes[0] = dTime;
+		}
+		if (dSteps != NULL) {
+			dSteps[0] = dStep;
+		}
+		return 1;
+	}
+	unsigned int uRead = CAtomic::Load(IndRead(m_nReaderInd));
+	unsigned int uAvail = CAtomic::LoadSeq(m_uIndWrite) - uRead;
+	if (uAvail == 0) {
+		// Shall wait to get a value
+		if (bListen != NULL) {
+			CAtomic::FetchAdd(m_nReaderListen, 1);
+			// In lock-free mode the writer may have published a value
+			// just before the registration, then check it again
+			uAvail = (IsLockFree() ? CAtomic::LoadSeq(m_uIndWrite) - uRead : 0);
+			*bListen = (uAvail == 0);
+		}
+		if (uAvail == 0) {
+			return 0;
+		}
+	}
+	unsigned int uCount = ((unsigned int)nCount < uAvail ? (unsigned int)nCount : uAvail);
+	unsigned int uMask = *m_uFifoMask;
+	int nSize = (*m_nSizeType)*(*m_nSize);
+#ifdef ISL_DEBUG
+	AppLogDebug(2, ISLSHMDATA_DEBUG, "[%s] Get Data Batch(%u from pos:%u)",
+		(m_sName == NULL ? "unknown" : m_sName), uCount, uRead & uMask);
+#endif
+	for (unsigned int i = 0; i < uCount; i++) {
+		int nInd = (int)((uRead + i) & uMask);
+		MemCopy((char *)pData + i * nSize, (char *)m_pData + nInd * nSize, nSize, false);
+		if (dTimes != NULL) {
+			dTimes[i] = m_dTimes[nInd];
+		}
+		if (dSteps != NULL) {
+			dSteps[i] = m_dSteps[nInd];
+		}
+	}
+	// Release all the slots at once
+	if (MoveReadInd(uRead, uRead + uCount) == false) {
+		// Overrun by the writer: read the oldest values kept
+		return GetDataBatch(pData, dTimes, dSteps, nCount, bListen);
+	}
+	if (bListen != NULL) {
+		*bListen = false;
+	}
+	//
+	return (int)uCount;
+}
+
 bool isl::CSHMData::GetData(void * pData, double * dOutTime, double * dOutStep, double dInTime, bool * bListen)
 {
 	if (IsReader() == false) {
 		return false;
 	}
+	if (*m_bLatest) {
+		return GetLatest(pData, dOutTime, dOutStep, dInTime, bListen);
+	}
+	unsigned int uRead = CAtomic::Load(IndRead(m_nReaderInd));
+	while (true) {
+		// In lock-free mode, the writer can update the slots already read
+		// during the search. The search is done again if it happens.
+		unsigned int uSeq = BeginRead();
+		unsigned int uWrite = CAtomic::LoadSeq(m_uIndWrite);
+		unsigned int uNewRead = uRead;
+		bool bWait = false;
+		bool bRet = FindData(pData, dOutTime, dOutStep, dInTime, &bWait, &uNewRead);
+		if (EndRead(uSeq) == false) {
+			continue;
+		}
+		if (uNewRead != uRead) {
+			// Release the slots
+			if (MoveReadInd(uRead, uNewRead) == false) {
+				// Overrun by the writer: search again from the oldest value kept
+				uRead = CAtomic::Load(IndRead(m_nReaderInd));
+				continue;
+			}
+			uRead = uNewRead;
+		}
+		if (bWait && (bListen != NULL)) {
+			CAtomic::FetchAdd(m_nReaderListen, 1);
+			// In lock-free mode the writer may have published a value
+			// just before the registration, then search again
+			if (IsLockFree() && (CAtomic::LoadSeq(m_uIndWrite) != uWrite)) {
+				continue;
+			}
+			*bListen = true;
+			return false;
+		}
+		if (bListen != NULL) {
+			*bListen = false;
+		}
+		return bRet;
+	}
+}
+
+bool isl::CSHMData::GetLatest(void * pData, double * dTime, double * dStep, bool * bListen)
+{
+	// Only a value newer than the last one read is returned
+	unsigned int uLast = *IndRead(m_nReaderInd);
+	unsigned int uWrite = 0;
+	if (ReadLatest(pData, dTime, dStep, &uWrite) && (uWrite != uLast)) {
+		CAtomic::Store(IndRead(m_nReaderInd), uWrite);
+		if (bListen != NULL) {
+			*bListen = false;
+		}
+		return true;
+	}
+	if (bListen != NULL) {
+		CAtomic::FetchAdd(m_nReaderListen, 1);
+		// The writer may have published a value just before the registration
+		if (CAtomic::LoadSeq(m_uIndWrite) != uLast) {
+			CancelReaderListen();
+			ReadLatest(pData, dTime, dStep, &uWrite);
+			CAtomic::Store(IndRead(m_nReaderInd), uWrite);
+			*bListen = false;
+			return true;
+		}
+		*bListen = true;
+	}
+	return false;
+}
+
+bool isl::CSHMData::GetLatest(void * pData, double * dOutTime, double * dOutStep, double dInTime, bool * bListen)
+{
+	// The newest value is returned unless the writer has not reached the requested time yet
+	unsigned int uWrite = 0;
+	while (true) {
+		unsigned int uLast = CAtomic::LoadSeq(m_uIndWrite);
+		bool bRet = ReadLatest(pData, dOutTime, dOutStep, &uWrite);
+		if (bRet) {
+			double dTolerance = m_dStepTolerance * (*dOutStep < 0.0 ? 0.0 : *dOutStep);
+			bool bIsEvent = (round(*dOutTime) == EVENT_DEF_TIME_VAL);
+			bool bIsSuperseded = (dInTime > *dOutTime + dTolerance) && (*dOutStep >= 0.0)
+				&& (dInTime >= *dOutTime + *dOutStep - dTolerance);
+			if (bIsEvent || (bIsSuperseded == false) || (bListen == NULL)) {
+				CAtomic::Store(IndRead(m_nReaderInd), uWrite);
+				if (bListen != NULL) {
+					*bListen = false;
+				}
+				return true;
+			}
+		}
+		if (bListen == NULL) {
+			return false;
+		}
+		CAtomic::FetchAdd(m_nReaderListen, 1);
+		// The writer may have published a value just before the registration
+		if (CAtomic::LoadSeq(m_uIndWrite) != uLast) {
+			CancelReaderListen();
+			continue;
+		}
+		*bListen = true;
+		return false;
+	}
+}
+
+bool isl::CSHMData::ReadLatest(void * pData, double * dTime, double * dStep, unsigned int * uWrite)
+{
+	int nSize = (*m_nSizeType)*(*m_nSize);
+	unsigned int uMask = *m_uFifoMask;
+	while (true) {
+		unsigned int uInd = CAtomic::Load(m_uIndWrite);
+		if (uInd == 0) {
+			// Nothing published yet
+			*uWrite = 0;
+			return false;
+		}
+		int nInd = (int)((uInd - 1) & uMask);
+		MemCopy(pData, (char *)m_pData + nInd * nSize, nSize, false);
+		*dTime = m_dTimes[nInd];
+		*dStep = m_dSteps[nInd];
+		// The slot is valid as long as the writer did not wrap around it
+		CAtomic::FenceAcquire();
+		if (CAtomic::Load(m_uIndWrite) - uInd < uMask) {
+			*uWrite = uInd;
+			return true;
+		}
+		CAtomic::Pause();
+	}
+}
+
+void isl::CSHMData::CancelReaderListen()
+{
+	// The registration is withdrawn unless the writer has already reset the listeners:
+	// otherwise the semaphore would keep a release for each value found without waiting
+	int nListen = CAtomic::Load(m_nReaderListen);
+	while ((nListen > 0) && (CAtomic::CompareExchange(m_nReaderListen, nListen, nListen - 1) == false)) {
+	}
+}
+
+// TODO : Create a function that will get the closest value even if already read
+// in the condition that the FIFO already contain read data.
+// The values are located by galloping searches over the FIFO indexes.
+bool isl::CSHMData::FindData(void * pData, double * dOutTime, double * dOutStep, double dInTime,
+	bool * bWait, unsigned int * uRead)
+{
 	int nSize = (*m_nSizeType)*(*m_nSize);
-	unsigned short usDepth = *m_usFifoDepth;
+	unsigned int uMask = *m_uFifoMask;
 #ifdef ISL_DEBUG
-	AppLogDebug(2, ISLSHMDATA_DEBUG, "[G0] InTime: %gs - FIFO Depth=%u.", dInTime, usDepth);
+	AppLogDebug(2, ISLSHMDATA_DEBUG, "[G0] InTime: %gs - FIFO Depth=%u.", dInTime, *m_uFifoDepth);
 #endif
 	//
-	unsigned short usInd = m_usIndReads[m_nReaderInd];
-	int nInd = (int)usInd;
+	unsigned int uInd = *uRead;
+	int nInd = (int)(uInd & uMask);
 	double dTime = m_dTimes[nInd];
 	// In case of event data, we cannot compare times
 	if (round(dTime) == EVENT_DEF_TIME_VAL) {
-		return GetData(pData, dOutTime, dOutStep, bListen);
+		if (IsFifoEmpty(*uRead)) {
+			*bWait = true;
+			return false;
+		}
+		void * pElement = (char *)m_pData + nInd * nSize;
+		MemCopy(pData, pElement, nSize, false);
+		*dOutTime = dTime;
+		*bWait = false;
+		*uRead = uInd + 1;
+		return true;
 	}
 	double dStep = m_dSteps[nInd];
 	double dTolerance = m_dStepTolerance * (dStep < 0.0 ? 0.0 : dStep);
 	double dNextTime = dTime + dStep;
-	bool bIsFifoEmpty = IsFifoEmpty();
+	bool bIsFifoEmpty = IsFifoEmpty(*uRead);
 #ifdef ISL_DEBUG
 	AppLogDebug(2, ISLSHMDATA_DEBUG, "[G15] Step=%gs Time=%gs (InTime is %s than Time) - IsFifoEmpty? %d",
 		dStep, dTime, (dInTime < dTime - dTolerance ? "Less" : "Greater"), bIsFifoEmpty);
 #endif
 #ifdef ISL_DEBUG
 	AppLogDebug(2, ISLSHMDATA_DEBUG, "[%s] Get Data(data, outtime, outstep, intime:%g, listen:%d)",
-		(m_sName == NULL ? "unknown" : m_sName), dInTime, (bListen == NULL ? -1 : *bListen));
+		(m_sName == NULL ? "unknown" : m_sName), dInTime, *bWait);
 #endif
 	if (bIsFifoEmpty && (dInTime < dTime - dTolerance)) {
-		int nPosOk = -1;
-		double dTimeOk = 0.0;
-		// We read from our current position down to 0
-		unsigned short usCur = usInd;
-		for (unsigned short i = 1; i < usDepth; i++) {
-			usCur -= 1;
-			if (usCur == MAX_FIFO_DEPTH) {
-				usCur = usDepth - 1;
-			}
-			int j = (int)usCur;
+		// We search the value in the history, from our current position
+		int nPosOk = SearchHistory(uInd, uMask, dInTime + dTolerance);
 #ifdef ISL_DEBUG
+		if (nPosOk != -1) {
 			AppLogDebug(2, ISLSHMDATA_DEBUG,
-				"[G11] Try to get on ind=%d (%d/%d), time=%gs.", j, usCur, usInd, m_dTimes[j]);
-#endif
-			if (m_dTimes[j] <= dInTime + dTolerance) {
-				if ((m_dSteps[j] <= 0.0) && (m_dTimes[j] > dTimeOk)) {
-#ifdef ISL_DEBUG
-					AppLogDebug(2, ISLSHMDATA_DEBUG, "[G12] We have one at %gs.", m_dTimes[j]);
-#endif
-					dTimeOk = m_dTimes[j];
-					nPosOk = j;
-				}
-				else if (m_dTimes[j] + m_dSteps[j] > dInTime + dTolerance) {
-#ifdef ISL_DEBUG
-					AppLogDebug(2, ISLSHMDATA_DEBUG, "[G20] We have one at %gs.", m_dTimes[j]);
-#endif
-					nPosOk = j;
-				}
-			}
+				"[G11] Try to get on ind=%d (%u), time=%gs.", nPosOk, uInd, m_dTimes[nPosOk]);
 		}
-		if (bListen != NULL) {
-			*bListen = false;
+#endif
+		if ((nPosOk != -1) && (IsValidAt(nPosOk, dInTime + dTolerance) == false)) {
+			nPosOk = -1;
 		}
+		*bWait = false;
 		if (nPosOk == -1) {
 			// No value found
 #ifdef ISL_DEBUG
@@ -713,8 +1533,8 @@ bool isl::CSHMData::GetData(void * pData, double * dOutTime, double * dOutStep,
 	else {
 		//
 		while (bIsFifoEmpty == false) {
-			usInd = m_usIndReads[m_nReaderInd];
-			nInd = (int)usInd;
+			uInd = *uRead;
+			nInd = (int)(uInd & uMask);
 			dTime = m_dTimes[nInd];
 			dStep = m_dSteps[nInd];
 			dTolerance = m_dStepTolerance * (dStep < 0.0 ? 0.0 : dStep);
@@ -730,12 +1550,13 @@ bool isl::CSHMData::GetData(void * pData, double * dOutTime, double * dOutStep,
 					AppLogDebug(2, ISLSHMDATA_DEBUG,
 						"[G1] Get data in pos:%d for time: %gs. Try to get a new one", nInd, dTime);
 #endif
-					if (usInd == usDepth - 1) {
-						m_usIndReads[m_nReaderInd] = 0;
-					}
-					else {
-						m_usIndReads[m_nReaderInd] = usInd + 1;
-					}
+					// Skip all the values already superseded at dInTime
+					uInd = SkipData(uInd, dInTime);
+					nInd = (int)(uInd & uMask);
+					dTime = m_dTimes[nInd];
+					dStep = m_dSteps[nInd];
+					dTolerance = m_dStepTolerance * (dStep < 0.0 ? 0.0 : dStep);
+					*uRead = uInd + 1;
 					// We continue to read
 				}
 				else {
@@ -745,19 +1566,12 @@ bool isl::CSHMData::GetData(void * pData, double * dOutTime, double * dOutStep,
 					void * pElement = (char *)m_pData + nInd * nSize;
 					//memcpy(pData, pElement, nSize);
 					MemCopy(pData, pElement, nSize, false);
-					if (bListen != NULL) {
-						*bListen = false; // We found it
-					}
+					*bWait = false; // We found it
 #ifdef ISL_DEBUG
 					AppLogDebug(2, ISLSHMDATA_DEBUG,
 						"[G2] Get data in pos:%d for time: %gs.", nInd, dTime);
 #endif
-					if (usInd == usDepth - 1) {
-						m_usIndReads[m_nReaderInd] = 0;
-					}
-					else {
-						m_usIndReads[m_nReaderInd] = usInd + 1;
-					}
+					*uRead = uInd + 1;
 					return true;
 				}
 			}
@@ -768,57 +1582,31 @@ bool isl::CSHMData::GetData(void * pData, double * dOutTime, double * dOutStep,
 				void * pElement = (char *)m_pData + nInd * nSize;
 				//memcpy(pData, pElement, nSize);
 				MemCopy(pData, pElement, nSize, false);
-				if (bListen != NULL) {
-					*bListen = false; // We found it
-				}
+				*bWait = false; // We found it
 #ifdef ISL_DEBUG
 				AppLogDebug(2, ISLSHMDATA_DEBUG,
 					"[G3] Get data in pos:%d for time: %gs.", nInd, dTime);
 #endif
-				if (usInd == usDepth - 1) {
-					m_usIndReads[m_nReaderInd] = 0;
-				}
-				else {
-					m_usIndReads[m_nReaderInd] = usInd + 1;
-				}
+				*uRead = uInd + 1;
 				return true;
 			}
 			else { // dInTime < dTime - dTolerance
-				int nPosOk = -1;
-				double dTimeOk = 0.0;
-				// We read from our current position down to 0
-				unsigned short usCur = usInd;
-				for (unsigned short i = 1; i < usDepth; i++) {
-					usCur -= 1;
-					if (usCur == MAX_FIFO_DEPTH) {
-						usCur = usDepth - 1;
-					}
-					int j = (int)usCur;
+				// We search the value in the history, from our current position.
+				// The unread values are more recent than the current one and the
+				// oldest slot is the next one to be written (see ReserveSlot).
+				unsigned int uCount = uMask - (CAtomic::LoadSeq(m_uIndWrite) - uInd);
+				int nPosOk = SearchHistory(uInd, uCount, dInTime + dTolerance);
 #ifdef ISL_DEBUG
+				if (nPosOk != -1) {
 					AppLogDebug(2, ISLSHMDATA_DEBUG,
-						"[G7] Try to get on ind=%d (%d/%d), time=%gs[ts=%gs].",
-						j, usCur, usInd, m_dTimes[j], m_dSteps[j]);
-#endif
-					if (m_dTimes[j] <= dInTime + dTolerance) {
-						if ((m_dSteps[j] <= 0.0) && (m_dTimes[j] > dTimeOk)) {
-#ifdef ISL_DEBUG
-							AppLogDebug(2, ISLSHMDATA_DEBUG, "[G9] We have one at %gs.", m_dTimes[j]);
-#endif
-							dTimeOk = m_dTimes[j];
-							nPosOk = j;
-						}
-						else if (m_dTimes[j] + m_dSteps[j] > dInTime + dTolerance) {
-#ifdef ISL_DEBUG
-							AppLogDebug(2, ISLSHMDATA_DEBUG,
-								"[G21] We have one at %gs.", m_dTimes[j]);
-#endif
-							nPosOk = j;
-						}
-					}
+						"[G7] Try to get on ind=%d (%u), time=%gs[ts=%gs].",
+						nPosOk, uInd, m_dTimes[nPosOk], m_dSteps[nPosOk]);
 				}
-				if (bListen != NULL) {
-					*bListen = false;
+#endif
+				if ((nPosOk != -1) && (IsValidAt(nPosOk, dInTime + dTolerance) == false)) {
+					nPosOk = -1;
 				}
+				*bWait = false;
 				if (nPosOk == -1) {
 					// No value found
 #ifdef ISL_DEBUG
@@ -838,12 +1626,7 @@ bool isl::CSHMData::GetData(void * pData, double * dOutTime, double * dOutStep,
 						nPosOk, *dOutTime);
 #endif
 					// We read the last value
-					if (usInd == usDepth - 1) {
-						m_usIndReads[m_nReaderInd] = 0;
-					}
-					else {
-						m_usIndReads[m_nReaderInd] = usInd + 1;
-					}
+					*uRead = uInd + 1;
 				}
 #ifdef ISL_DEBUG
 				else {
@@ -853,53 +1636,38 @@ bool isl::CSHMData::GetData(void * pData, double * dOutTime, double * dOutStep,
 #endif
 				return true;
 			}
-			bIsFifoEmpty = IsFifoEmpty();
+			bIsFifoEmpty = IsFifoEmpty(*uRead);
 		}
 	}
 	// If we are above current time and Fifo is empty
 	if ((dInTime >= dTime - dTolerance) && bIsFifoEmpty) {
-		// We read the most recent value
-		int nPosOk = -1;
-		double dTimeOk = -1.0;
+		// We read the most recent value, if it is valid until further notice
+		int nPosOk = SearchHistory(*uRead, uMask, dInTime + dTolerance);
 #ifdef ISL_DEBUG
 		AppLogDebug(2, ISLSHMDATA_DEBUG, "[G22] (dInTime >= dTime - dTolerance) && bIsFifoEmpty.");
 #endif
-		// We read from our current position down to 0
-		unsigned short usCur = usInd;
-		for (unsigned short i = 1; i < usDepth; i++) {
-			usCur -= 1;
-#ifdef ISL_DEBUG
-			AppLogDebug(2, ISLSHMDATA_DEBUG, "[G23] For i=%d to usDepth=%d, usCur=%d, MAX_FIFO_DEPTH=%d.",
-				i, usDepth, usCur, MAX_FIFO_DEPTH);
-#endif
-			if (usCur == MAX_FIFO_DEPTH) {
-				usCur = usDepth - 1;
+		if (nPosOk != -1) {
+			// The values with a step are skipped back to the newest one valid until further notice
+			unsigned int uBack = (*uRead - (unsigned int)nPosOk) & uMask;
+			while ((m_dSteps[nPosOk] >= 0.0) && (m_dTimes[nPosOk] > -1.0) && (uBack < uMask)) {
 #ifdef ISL_DEBUG
-				AppLogDebug(2, ISLSHMDATA_DEBUG, "[G24] usCur=%d.", usCur);
+				AppLogDebug(2, ISLSHMDATA_DEBUG, "[G16] Try to get on ind=%d, time=%gs.",
+					nPosOk, m_dTimes[nPosOk]);
 #endif
+				uBack++;
+				nPosOk = (int)((*uRead - uBack) & uMask);
 			}
-			int j = (int)usCur;
-#ifdef ISL_DEBUG
-			AppLogDebug(2, ISLSHMDATA_DEBUG, "[G25] j=%d.", j);
-#endif
-			if (m_dSteps[j] < 0.0) {
-#ifdef ISL_DEBUG
-				AppLogDebug(2, ISLSHMDATA_DEBUG, "[G16] Try to get on ind=%d (%d/%d), time=%gs.",
-					j, usCur, usInd, m_dTimes[j]);
-#endif
-				if ((dInTime >= m_dTimes[j] - dTolerance) && (m_dTimes[j] > dTimeOk)) {
-#ifdef ISL_DEBUG
-					AppLogDebug(2, ISLSHMDATA_DEBUG, "[G17] We have one at time %gs.", m_dTimes[j]);
-#endif
-					dTimeOk = m_dTimes[j];
-					nPosOk = j;
-				}
+			if ((m_dSteps[nPosOk] >= 0.0) || (m_dTimes[nPosOk] <= -1.0)) {
+				nPosOk = -1;
 			}
 		}
+#ifdef ISL_DEBUG
+		if (nPosOk != -1) {
+			AppLogDebug(2, ISLSHMDATA_DEBUG, "[G17] We have one at time %gs.", m_dTimes[nPosOk]);
+		}
+#endif
 		if (nPosOk != -1) {
-			if (bListen != NULL) {
-				*bListen = false; // We found it
-			}
+			*bWait = false; // We found it
 			// One value found
 			void * pElement = (char *)m_pData + nPosOk * nSize;
 			//memcpy(pData, pElement, nSize);
@@ -914,85 +1682,158 @@ bool isl::CSHMData::GetData(void * pData, double * dOutTime, double * dOutStep,
 		}
 	}
 	// Wait for the next value
-	if (bListen != NULL) {
-		int nVal = *m_nReaderListen;
-		*m_nReaderListen = nVal + 1;
-		*bListen = true;
-	}
+	*bWait = true;
 #ifdef ISL_DEBUG
 	AppLogDebug(2, ISLSHMDATA_DEBUG, "[G6] Get data for time: %gs. Wait for a new value.", dInTime);
 #endif
 	return false;
 }
 
-bool isl::CSHMData::SetData(void * pData, double dTime, int nInd)
+// The searches below rely on the times written in the FIFO never decreasing
+// with the FIFO indexes (see IsTimeOrdered), so that the lookups are
+// logarithmic in the FIFO depth.
+bool isl::CSHMData::IsSuperseded(unsigned int uInd, double dInTime)
 {
-	unsigned short usDepth = *m_usFifoDepth;
-	if (nInd >= (int)usDepth) {
-		return false;
+	int nInd = (int)(uInd & (*m_uFifoMask));
+	double dTime = m_dTimes[nInd];
+	double dStep = m_dSteps[nInd];
+	double dTolerance = m_dStepTolerance * (dStep < 0.0 ? 0.0 : dStep);
+	return (dInTime > dTime + dTolerance) && (dStep >= 0.0) && (dInTime >= dTime + dStep - dTolerance);
+}
+
+bool isl::CSHMData::IsValidAt(int nInd, double dLimit)
+{
+	if (m_dSteps[nInd] <= 0.0) {
+		return (m_dTimes[nInd] > 0.0);
+	}
+	return (m_dTimes[nInd] + m_dSteps[nInd] > dLimit);
+}
+
+unsigned int isl::CSHMData::SkipData(unsigned int uInd, double dInTime)
+{
+	// uInd is superseded, we gallop over the unread values then bisect
+	unsigned int uCount = CAtomic::LoadSeq(m_uIndWrite) - uInd;
+	unsigned int uLow = 0;
+	unsigned int uHigh = 1;
+	while ((uHigh < uCount) && IsSuperseded(uInd + uHigh, dInTime)) {
+		uLow = uHigh;
+		uHigh = (uHigh > uCount / 2 ? uCount : 2 * uHigh);
+	}
+	if (uHigh > uCount) {
+		uHigh = uCount;
 	}
-	unsigned short usInd = *m_usIndWrite;
-	// Start just after the ucIndWrite
-	for (int i = 0; i <= nInd; i++) {
-		if (usInd == usDepth - 1) {
-			usInd = 0;
+	while (uHigh - uLow > 1) {
+		unsigned int uMid = uLow + (uHigh - uLow) / 2;
+		if (IsSuperseded(uInd + uMid, dInTime)) {
+			uLow = uMid;
 		}
 		else {
-			usInd += 1;
+			uHigh = uMid;
 		}
 	}
-	nInd = (int)usInd;
+#ifdef ISL_DEBUG
+	AppLogDebug(2, ISLSHMDATA_DEBUG, "[G18] %u value(s) skipped for time: %gs.", uLow + 1, dInTime);
+#endif
+	return uInd + uLow;
+}
+
+bool isl::CSHMData::IsTimeOrdered(double dTime, const double * dPrevious)
+{
+	double dLast = -DBL_MAX;
+	if (dPrevious != NULL) {
+		dLast = *dPrevious;
+	}
+	else if (GetWriteInd() != 0) {
+		dLast = m_dTimes[(GetWriteInd() - 1) & *m_uFifoMask];
+	}
+	// The events all have the same time and are never searched
+	if ((dTime >= dLast) || (dTime == EVENT_DEF_TIME_VAL)) {
+		return true;
+	}
+	if (m_bTimeWarned == false) {
+		AppLogWarning(ISLSHMDATA_TIME_BACKWARD, "Variable %s: value at %gs rejected, the previous one is at %gs.",
+			(m_sName == NULL ? "unknown" : m_sName), dTime, dLast);
+		m_bTimeWarned = true;
+	}
+	return false;
+}
+
+int isl::CSHMData::SearchHistory(unsigned int uLast, unsigned int uCount, double dLimit)
+{
+	// Gallop backward from the most recent value then bisect
+	if (uCount == 0) {
+		return -1;
+	}
+	unsigned int uMask = *m_uFifoMask;
+	unsigned int uLow = 0;
+	unsigned int uHigh = 1;
+	while ((uHigh < uCount) && (m_dTimes[(uLast - uHigh) & uMask] > dLimit)) {
+		uLow = uHigh;
+		uHigh = (uHigh > uCount / 2 ? uCount : 2 * uHigh);
+	}
+	if (m_dTimes[(uLast - uHigh) & uMask] > dLimit) {
+		return -1;
+	}
+	while (uHigh - uLow > 1) {
+		unsigned int uMid = uLow + (uHigh - uLow) / 2;
+		if (m_dTimes[(uLast - uMid) & uMask] <= dLimit) {
+			uHigh = uMid;
+		}
+		else {
+			uLow = uMid;
+		}
+	}
+	return (int)((uLast - uHigh) & uMask);
+}
+
+bool isl::CSHMData::SetData(void * pData, double dTime, int nInd)
+{
+	if (nInd >= (int)(*m_uFifoDepth)) {
+		return false;
+	}
+	// Start just after the write index
+	nInd = (int)((GetWriteInd() + (unsigned int)nInd + 1) & *m_uFifoMask);
 	int nSize = (*m_nSizeType)*(*m_nSize);
 	void * pElement = (char *)m_pData + nInd*nSize;
+	BeginWrite();
 	memcpy(pElement, pData, nSize);
 	m_dTimes[nInd] = dTime;
+	EndWrite();
 	return true;
 }
 
 bool isl::CSHMData::GetData(void * pData, double * dTime, int nInd)
 {
-	unsigned short usDepth = *m_usFifoDepth;
-	int nDepth = (int)usDepth;
+	int nDepth = (int)(*m_uFifoDepth);
 	if (nInd >= nDepth) {
 		return false;
 	}
 	if (nInd <= -nDepth) {
 		return false;
 	}
-	unsigned short usInd = m_usIndReads[m_nReaderInd];
+	unsigned int uRead = *IndRead(m_nReaderInd);
 	if (nInd < 0) {
-		for (int i = 0; i >= nInd; i--) {
-			if (usInd == 0) {
-				usInd = usDepth - 1;
-			}
-			else {
-				usInd -= 1;
-			}
-		}
+		// Walk back from the read index
+		nInd = (int)((uRead - (unsigned int)(1 - nInd)) & *m_uFifoMask);
 	}
 	else {
-		// Start just after the m_ucIndReads[m_nReaderInd]
-		for (int i = 0; i <= nInd; i++) {
-			if (usInd == usDepth - 1) {
-				usInd = 0;
-			}
-			else {
-				usInd += 1;
-			}
-		}
+		// Start just after the read index
+		nInd = (int)((uRead + (unsigned int)nInd + 1) & *m_uFifoMask);
 	}
-	nInd = (int)usInd;
 	int nSize = (*m_nSizeType)*(*m_nSize);
 	void * pElement = (char *)m_pData + nInd*nSize;
-	memcpy(pData, pElement, nSize);
-	*dTime = m_dTimes[nInd];
+	unsigned int uSeq;
+	do {
+		uSeq = BeginRead();
+		memcpy(pData, pElement, nSize);
+		*dTime = m_dTimes[nInd];
+	} while (EndRead(uSeq) == false);
 	return true;
 }
 
 bool isl::CSHMData::GetMemData(void * pData, double * dTime, double * dStep, int nInd)
 {
-	unsigned short usDepth = *m_usFifoDepth;
-	if (nInd >= (int)usDepth) {
+	if (nInd > (int)(*m_uFifoMask)) {
 		return false;
 	}
 	if (nInd < 0) {
@@ -1000,12 +1841,45 @@ bool isl::CSHMData::GetMemData(void * pData, double * dTime, double * dStep, int
 	}
 	int nSize = (*m_nSizeType)*(*m_nSize);
 	void * pElement = (char *)m_pData + nInd*nSize;
-	memcpy(pData, pElement, nSize);
-	*dTime = m_dTimes[nInd];
-	*dStep = m_dSteps[nInd];
+	unsigned int uSeq;
+	do {
+		uSeq = BeginRead();
+		memcpy(pData, pElement, nSize);
+		*dTime = m_dTimes[nInd];
+		*dStep = m_dSteps[nInd];
+	} while (EndRead(uSeq) == false);
 	return true;
 }
 
+void isl::CSHMData::BeginWrite()
+{
+	// Only one writer: no concurrent update of the sequence
+	CAtomic::Store(m_uWriteSeq, *m_uWriteSeq + 1);
+	CAtomic::FenceRelease();
+}
+
+void isl::CSHMData::EndWrite()
+{
+	CAtomic::Store(m_uWriteSeq, *m_uWriteSeq + 1);
+}
+
+unsigned int isl::CSHMData::BeginRead()
+{
+	unsigned int uSeq = CAtomic::Load(m_uWriteSeq);
+	while ((uSeq & 1) != 0) {
+		// The writer is updating a slot
+		CAtomic::Pause();
+		uSeq = CAtomic::Load(m_uWriteSeq);
+	}
+	return uSeq;
+}
+
+bool isl::CSHMData::EndRead(unsigned int uSeq)
+{
+	CAtomic::FenceAcquire();
+	return CAtomic::Load(m_uWriteSeq) == uSeq;
+}
+
 bool isl::CSHMData::MemCopy(void * pDst, void * pSrc, size_t nSize, bool bToSHM)
 {
 	// No check on pointers, we suppose a correct usage
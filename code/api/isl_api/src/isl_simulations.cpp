@@ -36,11 +36,17 @@
   *     Header files
   */
 
+#include <string.h>
+
 #include <boost/format.hpp>
+#include <boost/thread/mutex.hpp>
 
 #include <isl_log.h>
 #include "isl_api.h"
 #include <isl_shm.h>
+#include <isl_atomic.h>
+#include <isl_thread.h>
+#include <isl_misc.h>
 #include "isl_shm_connect.h"
 #include "isl_settings.h"
 #include "isl_errorcodes.h"
@@ -51,10 +57,115 @@
  */
 
 #define SHM_ISL_KEY_ID			"_isl_shm_gen%1%"
+#define SHM_ISL_REGISTRY_KEY_ID	"_isl_shm_gen%1%_reg"
+#define SHM_ISL_CHUNK_KEY_ID	"_isl_shm_gen%1%_%2%"
+
+#define SIMS_VERSION		1u
+// Chunks of MaxNbSimulations slots added when all the slots are used
+#define SIMS_MAX_CHUNKS		64u
+
+// States of the registry header
+#define SIMS_EMPTY			0u
+#define SIMS_WRITING		1u
+#define SIMS_READY			2u
+
+// The process creating the registry only writes its header (milliseconds)
+#define SIMS_WAIT			1000
+// Spins before yielding while a slot is written
+#define SIMS_READ_SPINS		64
+// A slot left odd for this time (milliseconds) has lost its writer
+#define SIMS_READ_DEAD		1000
+
+// Entries of the index: (hash of the session << 32) | (slot + 1)
+#define SIMS_INDEX_FREE		0ull
+#define SIMS_INDEX_REMOVED	0xFFFFFFFFFFFFFFFFull
 
 const std::string isl::CSimulations::c_sKeyGeneralId = "7HZ5IPtt27157jTz";
 
 
+/*
+ *     Registry layout
+ */
+
+namespace isl {
+	// Followed by the index of the sessions (uIndexSize entries) then, for each
+	// chunk, the bitmap of the used slots and the sequence number of each slot
+	struct tsSimsRegistry {
+		unsigned int uState;
+		unsigned int uVersion;
+		unsigned int uSlots;		// Slots of a chunk
+		unsigned int uSlotSize;
+		unsigned int uMaxStrSize;
+		unsigned int uIndexSize;	// Power of 2
+		unsigned int uNbChunks;		// Only grows
+		unsigned int uNext;			// Cursor of the allocation
+	};
+}
+
+
+/*
+ *     Functions
+ */
+
+// Protects the chunks attached by this process
+static boost::mutex & GetChunksLock()
+{
+	static boost::mutex * cLock = new boost::mutex();
+	return *cLock;
+}
+
+static isl::CSHM * NewSHM(const std::string & sSHMId)
+{
+	bool bIsGlobalIPC = isl::CAppSettings().IsGlobalIPC();
+	if (isl::CAppSettings().IsISLCompatible()) {
+		return new isl::CSHM(sSHMId, "qipc_sharedmemory_", bIsGlobalIPC);
+	}
+	isl::CSHM * cMem = new isl::CSHM(sSHMId, bIsGlobalIPC);
+	cMem->SetBackend(isl::CSHM::GetBackendFromStr(isl::CAppSettings().GetSHMBackend()));
+	return cMem;
+}
+
+static unsigned int GetNbWords(unsigned int uSlots)
+{
+	return (uSlots + 31) / 32;
+}
+
+static int GetRegistrySize(unsigned int uSlots, unsigned int uIndexSize)
+{
+	return (int)(sizeof(isl::tsSimsRegistry) + uIndexSize * sizeof(unsigned long long) +
+		SIMS_MAX_CHUNKS * (GetNbWords(uSlots) + uSlots) * sizeof(unsigned int));
+}
+
+static unsigned long long * GetIndex(isl::tsSimsRegistry * pRegistry)
+{
+	return (unsigned long long *)(pRegistry + 1);
+}
+
+static unsigned int * GetBitmap(isl::tsSimsRegistry * pRegistry, unsigned int uChunk)
+{
+	unsigned int * pChunks = (unsigned int *)(GetIndex(pRegistry) + pRegistry->uIndexSize);
+	return pChunks + uChunk * (GetNbWords(pRegistry->uSlots) + pRegistry->uSlots);
+}
+
+static unsigned int * GetSeq(isl::tsSimsRegistry * pRegistry, int nSlot)
+{
+	unsigned int uChunk = (unsigned int)nSlot / pRegistry->uSlots;
+	return GetBitmap(pRegistry, uChunk) + GetNbWords(pRegistry->uSlots) + (unsigned int)nSlot % pRegistry->uSlots;
+}
+
+// Index of the lowest bit set, uVal must not be 0
+static unsigned int GetFirstBit(unsigned int uVal)
+{
+#ifdef WIN32
+	unsigned long ulInd = 0;
+	_BitScanForward(&ulInd, uVal);
+	return (unsigned int)ulInd;
+#else
+	return (unsigned int)__builtin_ctz(uVal);
+#endif
+}
+
+
 /*
  *     Classes definition
  */
@@ -85,8 +196,8 @@ isl::CSimulations::CSimulations()
 	m_ulAPID = 0;
 	m_nANbIOs = 0;
 	//
-	m_cContainer = 0;
-	m_cData = 0;
+	m_cRegistry = 0;
+	m_pRegistry = 0;
 }
 
 isl::CSimulations::~CSimulations()
@@ -100,7 +211,11 @@ unsigned int isl::CSimulations::GetMaxStringSize()
 
 int isl::CSimulations::GetMaxNb()
 {
-	return m_nMaxNbSims;
+	// The chunks added by the other processes are counted
+	if (Connect() == false) {
+		return m_nMaxNbSims;
+	}
+	return (int)(CAtomic::Load(&m_pRegistry->uNbChunks) * m_pRegistry->uSlots);
 }
 
 int isl::CSimulations::GetSizeOneSim()
@@ -170,61 +285,88 @@ std::string isl::CSimulations::GetSessionId()
 
 void * isl::CSimulations::Add()
 {
-	if (m_cData == 0) {
-		if (Connect() == false) {
+	if (Connect() == false) {
+		return 0;
+	}
+	int nSlot = -1;
+	while (nSlot < 0) {
+		unsigned int uNbChunks = CAtomic::Load(&m_pRegistry->uNbChunks);
+		nSlot = Allocate(uNbChunks);
+		if (nSlot >= 0) {
+			break;
+		}
+		if (uNbChunks >= SIMS_MAX_CHUNKS) {
+			AppLogError(ISLSIMS_ADD_NOSLOT,
+				"Simulations management: the %d simulations slots are used.", GetMaxNb());
 			return 0;
 		}
-	}
-	m_cContainer->Lock();
-	void * pSim = m_cData;
-	for (int i = 0; i < m_nMaxNbSims; i++) {
-		if (*(unsigned int *)pSim == 0) {
-			// Return the pointer to the part of the SHM related to this simulation
-			void * pASimData = pSim;
-			// ISL id of the model
-			*(unsigned int *)pSim = m_uAId;
-			pSim = (char *)pSim + m_nSizeId;
-			// PID
-			*(unsigned long *)pSim = m_ulAPID;
-			pSim = (char *)pSim + m_nSizePID;
-			// Model name
-			int nSize = m_sAName.size();
-			*(int *)pSim = nSize;
-			pSim = (char *)pSim + m_nSizeSizeName;
-			if (nSize != 0) {
-				memcpy(pSim, m_sAName.c_str(), nSize);
-				((char *)pSim)[nSize] = '\0';
-			}
-			pSim = (char *)pSim + m_nSizeName;
-			// Session id
-			nSize = m_sASessionId.size();
-			*(int *)pSim = nSize;
-			pSim = (char *)pSim + m_nSizeSizeSession;
-			if (nSize != 0) {
-				memcpy(pSim, m_sASessionId.c_str(), nSize);
-				((char *)pSim)[nSize] = '\0';
-			}
-			pSim = (char *)pSim + m_nSizeSession;
-			//
-			m_cContainer->Unlock();
-			return pASimData;
+		// All the slots are used: a chunk is added, by this process or another one
+		if (GetChunk(uNbChunks, true) == 0) {
+			return 0;
 		}
-		pSim = (char *)pSim + m_nSize;
+		CAtomic::CompareExchange(&m_pRegistry->uNbChunks, uNbChunks, uNbChunks + 1);
+	}
+	void * pChunk = GetChunk(nSlot / m_nMaxNbSims, true);
+	if (pChunk == 0) {
+		Release(nSlot);
+		return 0;
+	}
+	// Return the pointer to the part of the SHM related to this simulation
+	void * pASimData = (char *)pChunk + (nSlot % m_nMaxNbSims) * m_nSize;
+	void * pSim = pASimData;
+	// The readers retry while the sequence number is odd or has changed
+	unsigned int * pSeq = GetSeq(m_pRegistry, nSlot);
+	CAtomic::Store(pSeq, CAtomic::Load(pSeq) + 1);
+	CAtomic::FenceRelease();
+	// ISL id of the model, written last as it tells the slot is used
+	pSim = (char *)pSim + m_nSizeId;
+	// PID
+	*(unsigned long *)pSim = m_ulAPID;
+	pSim = (char *)pSim + m_nSizePID;
+	// Model name
+	int nSize = (int)m_sAName.size();
+	if (nSize >= m_nSizeName) {
+		nSize = m_nSizeName - 1;
 	}
-	m_cContainer->Unlock();
-	return 0;
+	*(int *)pSim = nSize;
+	pSim = (char *)pSim + m_nSizeSizeName;
+	memcpy(pSim, m_sAName.c_str(), nSize);
+	((char *)pSim)[nSize] = '\0';
+	pSim = (char *)pSim + m_nSizeName;
+	// Session id
+	nSize = (int)m_sASessionId.size();
+	if (nSize >= m_nSizeSession) {
+		nSize = m_nSizeSession - 1;
+	}
+	*(int *)pSim = nSize;
+	pSim = (char *)pSim + m_nSizeSizeSession;
+	memcpy(pSim, m_sASessionId.c_str(), nSize);
+	((char *)pSim)[nSize] = '\0';
+	//
+	CAtomic::Store((unsigned int *)pASimData, m_uAId);
+	CAtomic::Store(pSeq, CAtomic::Load(pSeq) + 1);
+	AddToIndex(m_sASessionId, nSlot);
+	return pASimData;
 }
 
 bool isl::CSimulations::Remove(void * pASimData)
 {
-	if (m_cData == NULL) {
+	if (m_pRegistry == NULL) {
 		return false;
 	}
 	if (pASimData == NULL) {
 		return false;
 	}
-	m_cContainer->Lock();
+	int nSlot = GetSlot(pASimData);
+	if (nSlot < 0) {
+		return false;
+	}
 	void * pSim = pASimData;
+	RemoveFromIndex(std::string((char *)pSim + m_nSizeId + m_nSizePID + m_nSizeSizeName + m_nSizeName +
+		m_nSizeSizeSession), nSlot);
+	unsigned int * pSeq = GetSeq(m_pRegistry, nSlot);
+	CAtomic::Store(pSeq, CAtomic::Load(pSeq) + 1);
+	CAtomic::FenceRelease();
 	// ISL id of the model
 	*(unsigned int *)pSim = 0;
 	pSim = (char *)pSim + m_nSizeId;
@@ -241,48 +383,34 @@ bool isl::CSimulations::Remove(void * pASimData)
 	pSim = (char *)pSim + m_nSizeSizeSession;
 	*(char *)pSim = '\0';
 	//
-	m_cContainer->Unlock();
+	CAtomic::Store(pSeq, CAtomic::Load(pSeq) + 1);
+	Release(nSlot);
 	return true;
 }
 
 bool isl::CSimulations::Get(int nInd)
 {
-	if (m_cData == NULL) {
-		if (Connect() == false) {
-			return false;
-		}
+	if (Connect() == false) {
+		return false;
 	}
-	if ((nInd < 0) || (nInd >= m_nMaxNbSims)) {
+	if ((nInd < 0) || (nInd >= GetMaxNb())) {
 		return false;
 	}
-	m_cContainer->Lock();
-	void * pSim = (char *)m_cData + nInd * m_nSize;
-	// ISL id of the model
-	m_uAId = *(unsigned int *)pSim;
-	pSim = (char *)pSim + m_nSizeId;
-	// PID
-	m_ulAPID = *(unsigned long *)pSim;
-	pSim = (char *)pSim + m_nSizePID;
-	// Model name
-	pSim = (char *)pSim + m_nSizeSizeName;
-	m_sAName = std::string((char *)pSim);
-	pSim = (char *)pSim + m_nSizeName;
-	// Session id
-	pSim = (char *)pSim + m_nSizeSizeSession;
-	m_sASessionId = std::string((char *)pSim);
-	//
-	m_cContainer->Unlock();
+	m_uAType = 0;
+	m_nANbIOs = 0;
+	m_sAUUID.clear();
+	m_sAFile.clear();
+	if (ReadSlot(nInd, m_uAId, m_ulAPID, m_sAName, m_sASessionId) == false) {
+		return false;
+	}
+	if (m_uAId == 0) {
+		// Free slot
+		return true;
+	}
 	//
 	// Try to connect on the connector SHM
 	std::string sSHM(boost::str(boost::format(SHM_MODEL_KEY_ID) % m_sASessionId % m_uAId));
-	bool bIsGlobalIPC = CAppSettings().IsGlobalIPC();
-	CSHM * cMem = 0;
-	if (CAppSettings().IsISLCompatible()) {
-		cMem = new CSHM(sSHM, "qipc_sharedmemory_", bIsGlobalIPC);
-	}
-	else {
-		cMem = new CSHM(sSHM, bIsGlobalIPC);
-	}
+	CSHM * cMem = NewSHM(sSHM);
 	if (cMem->Attach(CSHM::READONLY)) {
 		CSHMConnect cSimData(cMem->Data(), NULL);
 		m_uAType = cSimData.GetType();
@@ -296,108 +424,390 @@ bool isl::CSimulations::Get(int nInd)
 	return true;
 }
 
+std::vector<int> isl::CSimulations::Find(const std::string & sSessionId)
+{
+	std::vector<int> lSlots;
+	if (Connect() == false) {
+		return lSlots;
+	}
+	unsigned long long * pIndex = GetIndex(m_pRegistry);
+	unsigned int uMask = m_pRegistry->uIndexSize - 1;
+	unsigned int uHash = CString::GetHash(sSessionId);
+	unsigned int uId = 0;
+	unsigned long ulPID = 0;
+	std::string sName;
+	std::string sSession;
+	for (unsigned int i = 0; i <= uMask; i++) {
+		unsigned long long ulEntry = CAtomic::Load(&pIndex[(uHash + i) & uMask]);
+		if (ulEntry == SIMS_INDEX_FREE) {
+			break;
+		}
+		if ((ulEntry == SIMS_INDEX_REMOVED) || ((unsigned int)(ulEntry >> 32) != uHash)) {
+			continue;
+		}
+		// Several sessions may have the same hash
+		int nSlot = (int)(ulEntry & 0xFFFFFFFFull) - 1;
+		if (ReadSlot(nSlot, uId, ulPID, sName, sSession) && (uId != 0) && (sSession == sSessionId)) {
+			lSlots.push_back(nSlot);
+		}
+	}
+	return lSlots;
+}
+
 bool isl::CSimulations::Connect()
 {
-	if (m_cData != 0) {
+	if (m_pRegistry != 0) {
 		return true;
 	}
-	// ISL shared memory
-	std::string sSHMId(boost::str(boost::format(SHM_ISL_KEY_ID) % c_sKeyGeneralId));
-	bool bIsGlobalIPC = CAppSettings().IsGlobalIPC();
-	CSHM * cISLMem = 0;
-	if (CAppSettings().IsISLCompatible()) {
-		cISLMem = new CSHM(sSHMId, "qipc_sharedmemory_", bIsGlobalIPC);
+	// Registry shared by the processes: its layout is given by the first one
+	std::string sSHMId(boost::str(boost::format(SHM_ISL_REGISTRY_KEY_ID) % c_sKeyGeneralId));
+	CSHM * cMem = NewSHM(sSHMId);
+	unsigned int uSlots = (m_nMaxNbSims > 0) ? (unsigned int)m_nMaxNbSims : 1u;
+	unsigned int uIndexSize = 1;
+	while (uIndexSize < 2 * SIMS_MAX_CHUNKS * uSlots) {
+		uIndexSize <<= 1;
+	}
+	// The memory is zeroed when created: header to write, no slot used
+	bool bOk = cMem->Attach(CSHM::READWRITE);
+	if ((bOk == false) && (cMem->GetStatus() == CSHM::NOTFOUND)) {
+		bOk = cMem->Create(GetRegistrySize(uSlots, uIndexSize), CSHM::READWRITE);
+		if ((bOk == false) && (cMem->GetStatus() == CSHM::ALREADYEXISTS)) {
+			// Created by another process in the meantime
+			bOk = cMem->Attach(CSHM::READWRITE);
+		}
+	}
+	if ((bOk == false) || (cMem->Data() == 0)) {
+		AppLogError(ISLSIMS_CONNECT_FAILEDTOATTACHSHM,
+			"Simulations management: failed to attach shared memory '%s': %d-%d",
+			sSHMId.c_str(), cMem->GetStatus(), cMem->GetError());
+		delete cMem;
+		return false;
+	}
+	tsSimsRegistry * pRegistry = (tsSimsRegistry *)cMem->Data();
+	unsigned int uState = SIMS_EMPTY;
+	if (CAtomic::CompareExchange(&pRegistry->uState, uState, SIMS_WRITING)) {
+		pRegistry->uVersion = SIMS_VERSION;
+		pRegistry->uSlots = uSlots;
+		pRegistry->uSlotSize = (unsigned int)m_nSize;
+		pRegistry->uMaxStrSize = m_uMaxStrSize;
+		pRegistry->uIndexSize = uIndexSize;
+		pRegistry->uNbChunks = 1;
+		CAtomic::Store(&pRegistry->uState, SIMS_READY);
+		uState = SIMS_READY;
+	}
+	for (int i = 0; (uState == SIMS_WRITING) && (i < SIMS_WAIT); i++) {
+		CThread::Sleep(1);
+		uState = CAtomic::Load(&pRegistry->uState);
+	}
+	// Layout of another version
+	unsigned int uSlotSize = (unsigned int)(m_nSizeId + m_nSizePID + m_nSizeSizeName + m_nSizeSizeSession) +
+		pRegistry->uMaxStrSize * 2 * sizeof(char);
+	if ((uState != SIMS_READY) || (pRegistry->uVersion != SIMS_VERSION) || (pRegistry->uSlotSize != uSlotSize) ||
+		(cMem->Size() < GetRegistrySize(pRegistry->uSlots, pRegistry->uIndexSize))) {
+		AppLogError(ISLSIMS_CONNECT_WRONGLAYOUT,
+			"Simulations management: the shared memory '%s' has an unexpected layout.", sSHMId.c_str());
+		cMem->Detach();
+		delete cMem;
+		return false;
+	}
+	// The settings of the first process are used by all the processes
+	m_nMaxNbSims = (int)pRegistry->uSlots;
+	m_uMaxStrSize = pRegistry->uMaxStrSize;
+	m_nSizeName = sizeof(char) * m_uMaxStrSize;
+	m_nSizeSession = sizeof(char) * m_uMaxStrSize;
+	m_nSize = (int)pRegistry->uSlotSize;
+	m_cRegistry = cMem;
+	m_pRegistry = pRegistry;
+	m_lChunks.assign(SIMS_MAX_CHUNKS, (CSHM *)0);
+	// The first chunk is kept by all the processes
+	if (GetChunk(0, true) == 0) {
+		Disconnect();
+		return false;
+	}
+	return true;
+}
+
+bool isl::CSimulations::Disconnect()
+{
+	bool bRet = true;
+	if (m_cRegistry != NULL) {
+		// The status is not changed even if it returns false
+		// If it returns false, it means that the shared memory is still used by another process
+		AppLogInfo(ISLCONNECT_DISCONNECT_DETACHSHM,
+			"Simulations management: detach shared memory...");
+		for (std::vector<CSHM *>::size_type i = 0; i < m_lChunks.size(); i++) {
+			if (m_lChunks[i] != NULL) {
+				bRet = m_lChunks[i]->Detach() && bRet;
+				delete m_lChunks[i];
+			}
+		}
+		m_cRegistry->Detach();
+		delete m_cRegistry;
+	}
+	m_lChunks.clear();
+	m_cRegistry = 0;
+	m_pRegistry = 0;
+	return bRet;
+}
+
+void * isl::CSimulations::GetChunk(int nChunk, bool bCreate)
+{
+	boost::mutex::scoped_lock cLock(GetChunksLock());
+	if ((nChunk < 0) || (nChunk >= (int)m_lChunks.size())) {
+		return 0;
+	}
+	if (m_lChunks[nChunk] != NULL) {
+		return m_lChunks[nChunk]->Data();
+	}
+	std::string sSHMId;
+	if (nChunk == 0) {
+		sSHMId = boost::str(boost::format(SHM_ISL_KEY_ID) % c_sKeyGeneralId);
 	}
 	else {
-		cISLMem = new CSHM(sSHMId, bIsGlobalIPC);
+		sSHMId = boost::str(boost::format(SHM_ISL_CHUNK_KEY_ID) % c_sKeyGeneralId % nChunk);
 	}
+	CSHM * cISLMem = NewSHM(sSHMId);
 	int nISLSize = m_nMaxNbSims * m_nSize;
-	// Try to create
-	bool bISLCreated = cISLMem->Create(nISLSize, CSHM::READWRITE);
-	if (bISLCreated == false) {
-		if (cISLMem->GetStatus() == CSHM::ALREADYEXISTS) {
-			// Try to attach
-			if (cISLMem->Attach(CSHM::READWRITE) == false) {
-				AppLogError(ISLSIMS_CONNECT_FAILEDTOATTACHSHM,
-					"Simulations management: failed to attach shared memory '%s': %d-%d",
-					sSHMId.c_str(), cISLMem->GetStatus(), cISLMem->GetError());
-				delete cISLMem;
-				return false;
-			}
-			AppLogInfo(ISLSIMS_CONNECT_CONNECTED,
-				"Simulations management: Connected to the shared memory '%s'.",
-				sSHMId.c_str());
+	// A chunk is removed with its last process: its slots are then all free
+	if (cISLMem->Attach(CSHM::READWRITE)) {
+		AppLogInfo(ISLSIMS_CONNECT_CONNECTED,
+			"Simulations management: Connected to the shared memory '%s'.",
+			sSHMId.c_str());
+	}
+	else if (bCreate && (cISLMem->GetStatus() == CSHM::NOTFOUND)) {
+		if (cISLMem->Create(nISLSize, CSHM::READWRITE)) {
+			AppLogInfo(ISLSIMS_CONNECT_CREATED,
+				"Simulations management: Shared memory '%s' created.", sSHMId.c_str());
 		}
-		else {
+		else if ((cISLMem->GetStatus() != CSHM::ALREADYEXISTS) || (cISLMem->Attach(CSHM::READWRITE) == false)) {
 			AppLogError(ISLSIMS_CONNECT_FAILEDTOCREATESHM,
 				"Simulations management: failed to create shared memory '%s': %d-%d",
 				sSHMId.c_str(), cISLMem->GetStatus(), cISLMem->GetError());
 			delete cISLMem;
-			return false;
+			return 0;
 		}
 	}
 	else {
-		AppLogInfo(ISLSIMS_CONNECT_CREATED,
-			"Simulations management: Shared memory '%s' created.", sSHMId.c_str());
+		if (bCreate) {
+			AppLogError(ISLSIMS_CONNECT_FAILEDTOATTACHSHM,
+				"Simulations management: failed to attach shared memory '%s': %d-%d",
+				sSHMId.c_str(), cISLMem->GetStatus(), cISLMem->GetError());
+		}
+		delete cISLMem;
+		return 0;
 	}
-	// We are connected to the ISL shared memory
-	m_cContainer = cISLMem;
-	if (cISLMem->Data() == 0) {
+	if ((cISLMem->Data() == 0) || (cISLMem->Size() < nISLSize)) {
 		AppLogError(ISLSIMS_CONNECT_FAILEDTOGETDATA,
 			"Simulations management: failed to get access to the allocated space.");
-		return false;
+		cISLMem->Detach();
+		delete cISLMem;
+		return 0;
 	}
-	m_cData = (CSHMConnect *)cISLMem->Data();
-	if (bISLCreated) {
-		// Initialize
-		cISLMem->Lock();
-		Initialize();
-		cISLMem->Unlock();
+	m_lChunks[nChunk] = cISLMem;
+	return cISLMem->Data();
+}
+
+int isl::CSimulations::Allocate(unsigned int uNbChunks)
+{
+	unsigned int uSlots = m_pRegistry->uSlots;
+	unsigned int uNbWords = GetNbWords(uSlots);
+	unsigned int uTotal = uNbChunks * uNbWords;
+	if (uTotal == 0) {
+		return -1;
 	}
-	return true;
+	// The processes start from different words so that they do not compete for the same bits
+	unsigned int uStart = (CAtomic::FetchAdd(&m_pRegistry->uNext, 1u) % (uNbChunks * uSlots)) / 32;
+	for (unsigned int i = 0; i < uTotal; i++) {
+		unsigned int uWord = (uStart + i) % uTotal;
+		unsigned int uChunk = uWord / uNbWords;
+		unsigned int uInd = uWord % uNbWords;
+		unsigned int uValid = 0xFFFFFFFFu;
+		if ((uInd == uNbWords - 1) && (uSlots % 32 != 0)) {
+			uValid = (1u << (uSlots % 32)) - 1;
+		}
+		unsigned int * pWord = GetBitmap(m_pRegistry, uChunk) + uInd;
+		unsigned int uVal = CAtomic::Load(pWord);
+		while ((~uVal & uValid) != 0) {
+			unsigned int uBit = GetFirstBit(~uVal & uValid);
+			// uVal is updated on failure
+			if (CAtomic::CompareExchange(pWord, uVal, uVal | (1u << uBit))) {
+				return (int)(uChunk * uSlots + uInd * 32 + uBit);
+			}
+		}
+	}
+	return -1;
 }
 
-bool isl::CSimulations::Disconnect()
+void isl::CSimulations::Release(int nSlot)
 {
-	bool bRet = true;
-	if (m_cContainer != NULL) {
-		// The status is not changed even if it returns false
-		// If it returns false, it means that the shared memory is still used by another process
-		AppLogInfo(ISLCONNECT_DISCONNECT_DETACHSHM,
-			"Simulations management: detach shared memory...");
-		bRet = m_cContainer->Detach();
-		delete m_cContainer;
+	unsigned int uSlots = m_pRegistry->uSlots;
+	unsigned int uInd = (unsigned int)nSlot % uSlots;
+	unsigned int * pWord = GetBitmap(m_pRegistry, (unsigned int)nSlot / uSlots) + uInd / 32;
+	unsigned int uVal = CAtomic::Load(pWord);
+	// uVal is updated on failure
+	while (CAtomic::CompareExchange(pWord, uVal, uVal & ~(1u << (uInd % 32))) == false) {
+		CAtomic::Pause();
 	}
-	m_cContainer = 0;
-	m_cData = 0;
-	return bRet;
 }
 
-bool isl::CSimulations::Initialize()
+int isl::CSimulations::GetSlot(void * pASimData)
+{
+	boost::mutex::scoped_lock cLock(GetChunksLock());
+	for (std::vector<CSHM *>::size_type i = 0; i < m_lChunks.size(); i++) {
+		if (m_lChunks[i] == NULL) {
+			continue;
+		}
+		char * pData = (char *)m_lChunks[i]->Data();
+		if (((char *)pASimData >= pData) && ((char *)pASimData < pData + m_nMaxNbSims * m_nSize)) {
+			return (int)i * m_nMaxNbSims + (int)(((char *)pASimData - pData) / m_nSize);
+		}
+	}
+	return -1;
+}
+
+bool isl::CSimulations::ReadSlot(int nSlot, unsigned int & uId, unsigned long & ulPID,
+	std::string & sName, std::string & sSessionId)
 {
-	if (m_cData == 0) {
+	uId = 0;
+	ulPID = 0;
+	sName.clear();
+	sSessionId.clear();
+	if ((nSlot < 0) || (nSlot >= m_nMaxNbSims * (int)SIMS_MAX_CHUNKS)) {
 		return false;
 	}
-	void * pSim = m_cData;
-	for (int i = 0; i < m_nMaxNbSims; i++) {
+	// Not attached by any process: the slots are free
+	void * pChunk = GetChunk(nSlot / m_nMaxNbSims, false);
+	if (pChunk == 0) {
+		return true;
+	}
+	unsigned int * pSeq = GetSeq(m_pRegistry, nSlot);
+	// Retried until the slot is not written during the copy
+	unsigned int uOdd = 0;
+	int nOddWaits = 0;
+	for (int i = 0; ; i++) {
+		unsigned int uSeq = CAtomic::Load(pSeq);
+		if ((uSeq & 1u) != 0) {
+			if (i < SIMS_READ_SPINS) {
+				CAtomic::Pause();
+				continue;
+			}
+			// Only a process ended while writing leaves the number odd
+			nOddWaits = (uSeq == uOdd ? nOddWaits + 1 : 0);
+			uOdd = uSeq;
+			if (nOddWaits >= SIMS_READ_DEAD) {
+				break;
+			}
+			CThread::Sleep(1);
+			continue;
+		}
+		void * pSim = (char *)pChunk + (nSlot % m_nMaxNbSims) * m_nSize;
 		// ISL id of the model
-		*(unsigned int *)pSim = 0;
+		uId = *(unsigned int *)pSim;
 		pSim = (char *)pSim + m_nSizeId;
 		// PID
-		*(unsigned long *)pSim = 0;
+		ulPID = *(unsigned long *)pSim;
 		pSim = (char *)pSim + m_nSizePID;
 		// Model name
-		*(int *)pSim = 0;
 		pSim = (char *)pSim + m_nSizeSizeName;
-		*(char *)pSim = '\0';
+		sName = std::string((char *)pSim, strnlen((char *)pSim, m_nSizeName));
 		pSim = (char *)pSim + m_nSizeName;
-		// Session name
-		*(int *)pSim = 0;
+		// Session id
 		pSim = (char *)pSim + m_nSizeSizeSession;
-		*(char *)pSim = '\0';
-		pSim = (char *)pSim + m_nSizeSession;
+		sSessionId = std::string((char *)pSim, strnlen((char *)pSim, m_nSizeSession));
+		//
+		CAtomic::FenceAcquire();
+		if (CAtomic::Load(pSeq) == uSeq) {
+			return true;
+		}
+	}
+	uId = 0;
+	ulPID = 0;
+	sName.clear();
+	sSessionId.clear();
+	return false;
+}
+
+void isl::CSimulations::AddToIndex(const std::string & sSessionId, int nSlot)
+{
+	unsigned long long * pIndex = GetIndex(m_pRegistry);
+	unsigned int uMask = m_pRegistry->uIndexSize - 1;
+	unsigned int uHash = CString::GetHash(sSessionId);
+	unsigned long long ulEntry = ((unsigned long long)uHash << 32) | (unsigned long long)(nSlot + 1);
+	// The index is larger than the number of slots: a place is always found
+	unsigned int uAt = 0;
+	bool bFound = false;
+	for (unsigned int i = 0; (bFound == false) && (i <= uMask); i++) {
+		unsigned long long * pEntry = &pIndex[(uHash + i) & uMask];
+		unsigned long long ulVal = CAtomic::Load(pEntry);
+		while ((ulVal == SIMS_INDEX_FREE) || (ulVal == SIMS_INDEX_REMOVED)) {
+			if (CAtomic::CompareExchange(pEntry, ulVal, ulEntry)) {
+				uAt = i;
+				bFound = true;
+				break;
+			}
+		}
+	}
+	// A removal may free an entry passed while probing, which ends the chain before
+	// this one: the entry is then moved there
+	unsigned int i = 0;
+	while (bFound && (i < uAt)) {
+		unsigned long long ulVal = SIMS_INDEX_FREE;
+		if (CAtomic::CompareExchange(&pIndex[(uHash + i) & uMask], ulVal, ulEntry)) {
+			ClearIndex((uHash + uAt) & uMask, ulEntry);
+			// Checked again from the start of the chain
+			uAt = i;
+			i = 0;
+			continue;
+		}
+		i++;
+	}
+}
+
+void isl::CSimulations::RemoveFromIndex(const std::string & sSessionId, int nSlot)
+{
+	unsigned long long * pIndex = GetIndex(m_pRegistry);
+	unsigned int uMask = m_pRegistry->uIndexSize - 1;
+	unsigned int uHash = CString::GetHash(sSessionId);
+	unsigned long long ulEntry = ((unsigned long long)uHash << 32) | (unsigned long long)(nSlot + 1);
+	for (unsigned int i = 0; i <= uMask; i++) {
+		unsigned long long ulVal = CAtomic::Load(&pIndex[(uHash + i) & uMask]);
+		if (ulVal == SIMS_INDEX_FREE) {
+			return;
+		}
+		// Only this process removes its own entry
+		if (ulVal == ulEntry) {
+			ClearIndex((uHash + i) & uMask, ulEntry);
+			return;
+		}
+	}
+}
+
+void isl::CSimulations::ClearIndex(unsigned int uPos, unsigned long long ulEntry)
+{
+	unsigned long long * pIndex = GetIndex(m_pRegistry);
+	unsigned int uMask = m_pRegistry->uIndexSize - 1;
+	if (CAtomic::CompareExchange(&pIndex[uPos], ulEntry, SIMS_INDEX_REMOVED) == false) {
+		return;
+	}
+	// The chains end at the first free entry: the removed entries just before one
+	// are freed, so that the chains do not grow with the removals
+	for (unsigned int i = 0; i <= uMask; i++) {
+		unsigned long long * pNext = &pIndex[(uPos + 1) & uMask];
+		if (CAtomic::Load(pNext) != SIMS_INDEX_FREE) {
+			return;
+		}
+		unsigned long long ulVal = SIMS_INDEX_REMOVED;
+		if (CAtomic::CompareExchange(&pIndex[uPos], ulVal, SIMS_INDEX_FREE) == false) {
+			return;
+		}
+		// An entry added after this one meanwhile must stay reachable
+		if (CAtomic::LoadSeq(pNext) != SIMS_INDEX_FREE) {
+			ulVal = SIMS_INDEX_FREE;
+			CAtomic::CompareExchange(&pIndex[uPos], ulVal, SIMS_INDEX_REMOVED);
+			return;
+		}
+		uPos = (uPos - 1) & uMask;
 	}
-	return true;
 }
 
 isl::CSimulations * isl::CSimulations::Instance()
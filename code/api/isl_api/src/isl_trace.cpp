@@ -0,0 +1,201 @@
+/*
+ *     Name: isl_trace.cpp
+ *
+ *     Description: Binary trace of the data exchanges.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+/*
+ *     Header files
+ */
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <boost/format.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/process/environment.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <isl_log.h>
+#include <isl_atomic.h>
+
+#include "isl_errorcodes.h"
+#include "isl_trace.h"
+
+
+/*
+ *     Local variables and functions
+ */
+
+namespace isl {
+	// Never destroyed: the records may be written by the destructors of static objects
+	static boost::mutex & GetTraceLock()
+	{
+		static boost::mutex * cLock = new boost::mutex();
+		return *cLock;
+	}
+
+	static std::map<std::string, unsigned int> & GetTraceNames()
+	{
+		static std::map<std::string, unsigned int> * mNames = new std::map<std::string, unsigned int>();
+		return *mNames;
+	}
+
+	static std::string sTraceFile;
+	static unsigned long long ulTraceMask = 0;
+	static std::chrono::steady_clock::time_point tpTraceStart;
+	static unsigned int uTraceThreads = 0;
+
+	static unsigned short GetTraceThread()
+	{
+		static thread_local unsigned short usThread =
+			(unsigned short)CAtomic::FetchAdd(&uTraceThreads, 1u);
+		return usThread;
+	}
+}
+
+
+/*
+ *     Classes definition
+ */
+
+tsTraceHeader * isl::CTrace::m_pHeader = 0;
+tsTraceRecord * isl::CTrace::m_pRecords = 0;
+char * isl::CTrace::m_pNames = 0;
+
+bool isl::CTrace::Open(const std::string & sPath, unsigned int uSize)
+{
+	boost::mutex::scoped_lock cLock(GetTraceLock());
+	if (m_pHeader != 0) {
+		// Already opened by another connector of the process
+		return true;
+	}
+	unsigned long long ulCapacity = 1024;
+	while ((ulCapacity < uSize) && (ulCapacity < 0x40000000)) {
+		ulCapacity <<= 1;
+	}
+	boost::filesystem::path bpFile(sPath.empty() ? boost::filesystem::temp_directory_path() :
+		boost::filesystem::path(sPath));
+	bpFile.append(boost::str(boost::format("isl_trace_%1%.%2%") %
+		boost::this_process::get_id() % TRACE_FILE_EXT));
+	std::string sFile = bpFile.string();
+	unsigned long long ulSize = TRACE_HEADER_SIZE + TRACE_MAX_NAMES * TRACE_NAME_SIZE +
+		ulCapacity * sizeof(tsTraceRecord);
+	try {
+		// Sparse file: the pages are allocated when the records are written
+		{
+			std::ofstream ofFile(sFile.c_str(), std::ios::binary | std::ios::trunc);
+		}
+		boost::filesystem::resize_file(sFile, ulSize);
+		// Both objects are kept until the end of the process
+		boost::interprocess::file_mapping * cFile =
+			new boost::interprocess::file_mapping(sFile.c_str(), boost::interprocess::read_write);
+		boost::interprocess::mapped_region * cRegion =
+			new boost::interprocess::mapped_region(*cFile, boost::interprocess::read_write);
+		char * pBase = (char *)cRegion->get_address();
+		m_pNames = pBase + TRACE_HEADER_SIZE;
+		m_pRecords = (tsTraceRecord *)(m_pNames + TRACE_MAX_NAMES * TRACE_NAME_SIZE);
+		tsTraceHeader * pHeader = (tsTraceHeader *)pBase;
+		memcpy(pHeader->sMagic, TRACE_MAGIC, sizeof(pHeader->sMagic));
+		pHeader->uVersion = TRACE_VERSION;
+		pHeader->uRecordSize = sizeof(tsTraceRecord);
+		pHeader->uCapacity = (unsigned int)ulCapacity;
+		pHeader->uNbNames = 1;
+		pHeader->ulPID = (unsigned long long)boost::this_process::get_id();
+		pHeader->ulWallTime = (unsigned long long)std::chrono::duration_cast<std::chrono::microseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+		pHeader->ulWrite = 0;
+		ulTraceMask = ulCapacity - 1;
+		tpTraceStart = std::chrono::steady_clock::now();
+		sTraceFile = sFile;
+		// Enables the records
+		CAtomic::Store(&m_pHeader, pHeader);
+	}
+	catch (std::exception & e) {
+		AppLogError(ISLTRACE_OPEN_FAILED, "Failed to create the trace file '%s': %s",
+			sFile.c_str(), e.what());
+		return false;
+	}
+	AppLogInfo(ISLTRACE_OPENED, "Trace of the data exchanges in '%s' (%llu records).",
+		sFile.c_str(), ulCapacity);
+	return true;
+}
+
+std::string isl::CTrace::GetFile()
+{
+	boost::mutex::scoped_lock cLock(GetTraceLock());
+	return sTraceFile;
+}
+
+unsigned int isl::CTrace::RegisterName(const std::string & sName)
+{
+	if (IsEnabled() == false) {
+		return 0;
+	}
+	boost::mutex::scoped_lock cLock(GetTraceLock());
+	std::map<std::string, unsigned int> & mNames = GetTraceNames();
+	std::map<std::string, unsigned int>::iterator itName = mNames.find(sName);
+	if (itName != mNames.end()) {
+		return itName->second;
+	}
+	if (m_pHeader->uNbNames >= TRACE_MAX_NAMES) {
+		return 0;
+	}
+	unsigned int uName = m_pHeader->uNbNames;
+	char * pName = m_pNames + uName * TRACE_NAME_SIZE;
+	strncpy(pName, sName.c_str(), TRACE_NAME_SIZE - 1);
+	pName[TRACE_NAME_SIZE - 1] = '\0';
+	m_pHeader->uNbNames = uName + 1;
+	mNames[sName] = uName;
+	return uName;
+}
+
+void isl::CTrace::Record(tEvent eEvent, unsigned int uName, double dSimTime, unsigned int uArg)
+{
+	tsTraceHeader * pHeader = CAtomic::Load(&m_pHeader);
+	if (pHeader == 0) {
+		return;
+	}
+	unsigned long long ulInd = CAtomic::FetchAdd(&pHeader->ulWrite, 1ULL);
+	tsTraceRecord * pRecord = &m_pRecords[ulInd & ulTraceMask];
+	pRecord->ulTime = (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - tpTraceStart).count();
+	pRecord->dSimTime = dSimTime;
+	pRecord->uName = uName;
+	pRecord->usEvent = (unsigned short)eEvent;
+	pRecord->usThread = GetTraceThread();
+	pRecord->uArg = uArg;
+	// The decoder ignores the records being written
+	CAtomic::Store(&pRecord->uSeq, (unsigned int)(ulInd + 1));
+}
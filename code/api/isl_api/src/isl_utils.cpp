@@ -105,6 +105,9 @@ void isl::CUtils::Error(unsigned int uId, const char * sFormat, ...)
 
 void isl::CUtils::Debug(unsigned int uLevel, unsigned int uId, const char * sFormat, ...)
 {
+	if (isl::CMsgLogger::IsDebugEnabled(uLevel) == false) {
+		return;
+	}
 	va_list lArgs;
 	va_start(lArgs, sFormat);
 	size_t len = std::vsnprintf(NULL, 0, sFormat, lArgs);
@@ -120,3 +123,13 @@ void isl::CUtils::CloseLog()
 {
 	AppLog_Close;
 }
+
+void isl::CUtils::FlushLog()
+{
+	AppLog->Flush();
+}
+
+unsigned int isl::CUtils::GetLogDropped()
+{
+	return AppLog->GetDropped();
+}
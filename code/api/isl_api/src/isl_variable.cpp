@@ -483,6 +483,13 @@ isl::CVariable::CVariable(CConnect * cParent, const std::string & sId)
 	m_dStepSize = -1.0; // <0 means no local step size has been defined
 	m_bStore = false;
 	m_nSyncTimeout = -1; // <0 means infinite wait
+	m_eWaitPolicy = WP_DEFAULT;
+	m_nSpinCount = -1;
+	m_eMode = MD_FIFO;
+	m_eBackPressure = BP_BLOCK;
+	m_bHugePages = false;
+	m_eNumaPolicy = NP_DEFAULT;
+	m_nNumaNode = 0;
 	if (m_cParent == 0) {
 		m_eState = ST_NOT_DEFINED;
 		AppLogError(ISLVARIABLE_NO_PARENT, "Variable %s must be linked to a connector.", sId.c_str());
@@ -652,6 +659,214 @@ int isl::CVariable::GetSyncTimeout()
 	return m_nSyncTimeout;
 }
 
+void isl::CVariable::SetWaitPolicy(const std::string & sVal)
+{
+	m_eWaitPolicy = GetWaitPolicyFromStr(sVal);
+}
+
+void isl::CVariable::SetWaitPolicy(tWaitPolicy eWaitPolicy)
+{
+	m_eWaitPolicy = eWaitPolicy;
+}
+
+isl::CVariable::tWaitPolicy isl::CVariable::GetWaitPolicy()
+{
+	return m_eWaitPolicy;
+}
+
+std::string isl::CVariable::GetWaitPolicyAsStr()
+{
+	return GetWaitPolicyStr(m_eWaitPolicy);
+}
+
+void isl::CVariable::SetSpinCount(int nCount)
+{
+	m_nSpinCount = nCount;
+}
+
+int isl::CVariable::GetSpinCount()
+{
+	return m_nSpinCount;
+}
+
+void isl::CVariable::SetMode(const std::string & sVal)
+{
+	m_eMode = GetModeFromStr(sVal);
+}
+
+void isl::CVariable::SetMode(tMode eMode)
+{
+	m_eMode = eMode;
+}
+
+isl::CVariable::tMode isl::CVariable::GetMode()
+{
+	return m_eMode;
+}
+
+std::string isl::CVariable::GetModeAsStr()
+{
+	return GetModeStr(m_eMode);
+}
+
+void isl::CVariable::SetBackPressure(const std::string & sVal)
+{
+	m_eBackPressure = GetBackPressureFromStr(sVal);
+}
+
+void isl::CVariable::SetBackPressure(tBackPressure eBackPressure)
+{
+	m_eBackPressure = eBackPressure;
+}
+
+isl::CVariable::tBackPressure isl::CVariable::GetBackPressure()
+{
+	return m_eBackPressure;
+}
+
+std::string isl::CVariable::GetBackPressureAsStr()
+{
+	return GetBackPressureStr(m_eBackPressure);
+}
+
+void isl::CVariable::UseHugePages(bool bUse)
+{
+	m_bHugePages = bUse;
+}
+
+bool isl::CVariable::IsHugePagesUsed()
+{
+	return m_bHugePages;
+}
+
+void isl::CVariable::SetNumaPolicy(const std::string & sVal)
+{
+	if (sVal == "interleave") {
+		SetNumaPolicy(NP_INTERLEAVE);
+	}
+	else if ((sVal.empty() == false) && (sVal.find_first_not_of("0123456789") == std::string::npos)) {
+		SetNumaPolicy(NP_BIND, CString::GetInteger(sVal));
+	}
+	else {
+		SetNumaPolicy(NP_DEFAULT);
+	}
+}
+
+void isl::CVariable::SetNumaPolicy(tNumaPolicy ePolicy, int nNode)
+{
+	if ((ePolicy == NP_BIND) && (nNode < 0)) {
+		ePolicy = NP_DEFAULT;
+	}
+	m_eNumaPolicy = ePolicy;
+	m_nNumaNode = (ePolicy == NP_BIND ? nNode : 0);
+}
+
+isl::CVariable::tNumaPolicy isl::CVariable::GetNumaPolicy()
+{
+	return m_eNumaPolicy;
+}
+
+int isl::CVariable::GetNumaNode()
+{
+	return m_nNumaNode;
+}
+
+std::string isl::CVariable::GetNumaPolicyAsStr()
+{
+	switch (m_eNumaPolicy) {
+		case NP_BIND:
+			return boost::str(boost::format("%1%") % m_nNumaNode);
+		case NP_INTERLEAVE:
+			return "interleave";
+		default:
+			break;
+	}
+	return "default";
+}
+
+isl::CVariable::tWaitPolicy isl::CVariable::GetWaitPolicyFromStr(const std::string & sVal)
+{
+	if (sVal == "block") {
+		return WP_BLOCK;
+	}
+	else if (sVal == "spin") {
+		return WP_SPIN;
+	}
+	else if (sVal == "spinpause") {
+		return WP_SPINPAUSE;
+	}
+	else if (sVal == "busypoll") {
+		return WP_BUSYPOLL;
+	}
+	return WP_DEFAULT;
+}
+
+std::string isl::CVariable::GetWaitPolicyStr(tWaitPolicy eWaitPolicy)
+{
+	std::string sWaitPolicy;
+	switch (eWaitPolicy) {
+		case WP_BLOCK:
+			sWaitPolicy = "block";
+			break;
+		case WP_SPIN:
+			sWaitPolicy = "spin";
+			break;
+		case WP_SPINPAUSE:
+			sWaitPolicy = "spinpause";
+			break;
+		case WP_BUSYPOLL:
+			sWaitPolicy = "busypoll";
+			break;
+		default:
+			break;
+	}
+	return sWaitPolicy;
+}
+
+isl::CVariable::tMode isl::CVariable::GetModeFromStr(const std::string & sVal)
+{
+	if (sVal == "latest") {
+		return MD_LATEST;
+	}
+	return MD_FIFO;
+}
+
+std::string isl::CVariable::GetModeStr(tMode eMode)
+{
+	if (eMode == MD_LATEST) {
+		return "latest";
+	}
+	return "fifo";
+}
+
+isl::CVariable::tBackPressure isl::CVariable::GetBackPressureFromStr(const std::string & sVal)
+{
+	if (sVal == "dropoldest") {
+		return BP_DROPOLDEST;
+	}
+	else if (sVal == "dropnewest") {
+		return BP_DROPNEWEST;
+	}
+	return BP_BLOCK;
+}
+
+std::string isl::CVariable::GetBackPressureStr(tBackPressure eBackPressure)
+{
+	std::string sBackPressure;
+	switch (eBackPressure) {
+		case BP_DROPOLDEST:
+			sBackPressure = "dropoldest";
+			break;
+		case BP_DROPNEWEST:
+			sBackPressure = "dropnewest";
+			break;
+		default:
+			sBackPressure = "block";
+			break;
+	}
+	return sBackPressure;
+}
+
 bool isl::CVariable::IsChecked()
 {
 	return m_bChecked;
@@ -723,10 +938,14 @@ bool isl::CVariable::Check()
 	InitOnCheck();
 	// TODO: check the compute settings
 	AppLogInfo(ISLVARIABLE_CHECK_INFO, "Variable '%s':\n\tId: %s\n\tName: %s\n\tCausality: %s\n\tType (Size): %s (%d)"
-		"\n\tConnection Id: %s\n\tInitial value: [%s]\n\tStep size: %gs\n\tStorage: %s\n\tSynchronisation timeout: %ds",
+		"\n\tConnection Id: %s\n\tInitial value: [%s]\n\tStep size: %gs\n\tStorage: %s\n\tSynchronisation timeout: %ds"
+		"\n\tWait policy (Spin count): %s (%d)\n\tMode (Back-pressure): %s (%s)"
+		"\n\tHuge pages (NUMA): %s (%s)",
 		m_sId.c_str(), m_sId.c_str(), m_sName.c_str(), GetCausalityAsStr().c_str(), GetType()->GetIdAsStr().c_str(),
 		GetType()->GetSize(), m_sConnectId.c_str(), m_cType->GetInitialAsStr().c_str(), m_dStepSize,
-		(m_bStore ? "true" : "false"), m_nSyncTimeout);
+		(m_bStore ? "true" : "false"), m_nSyncTimeout, GetWaitPolicyAsStr().c_str(), m_nSpinCount,
+		GetModeAsStr().c_str(), GetBackPressureAsStr().c_str(), (m_bHugePages ? "true" : "false"),
+		GetNumaPolicyAsStr().c_str());
 	m_bChecked = true;
 	return true;
 }
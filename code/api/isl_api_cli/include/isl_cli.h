@@ -83,9 +83,9 @@ namespace isl_cli {
 		Boolean IsInput();
 		Boolean IsOutput();
 
-		void SetFifoDepth(Int16 nDepth);
-		Int16 GetFifoDepth();
-		Int16 GetMaxFifoDepth();
+		void SetFifoDepth(Int32 nDepth);
+		Int32 GetFifoDepth();
+		Int32 GetMaxFifoDepth();
 		Int32 GetMaxReaders();
 
 		void Allocate();
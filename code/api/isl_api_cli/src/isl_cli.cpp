@@ -146,25 +146,25 @@ Boolean CData::IsOutput()
 	return false;
 }
 
-void CData::SetFifoDepth(Int16 nDepth)
+void CData::SetFifoDepth(Int32 nDepth)
 {
 	if (m_cData != NULL) {
-		m_cData->SetFifoDepth(nDepth);
+		m_cData->SetFifoDepth((unsigned int)nDepth);
 	}
 }
 
-Int16 CData::GetFifoDepth()
+Int32 CData::GetFifoDepth()
 {
 	if (m_cData != NULL) {
-		return m_cData->GetFifoDepth();
+		return (Int32)m_cData->GetFifoDepth();
 	}
 	return 0;
 }
 
-Int16 CData::GetMaxFifoDepth()
+Int32 CData::GetMaxFifoDepth()
 {
 	if (m_cData != NULL) {
-		return m_cData->GetMaxFifoDepth();
+		return (Int32)m_cData->GetMaxFifoDepth();
 	}
 	return 0;
 }
@@ -166,6 +166,7 @@ class CISLLib(Singleton):
 
         self.SimsGetMaxNb = None
         self.SimsGet = None
+        self.SimsFind = None
         self.SimsClose = None
 
         self.SimsGetType = None
@@ -312,6 +313,7 @@ class CISLLib(Singleton):
 
         self.SimsGetMaxNb = None
         self.SimsGet = None
+        self.SimsFind = None
         self.SimsClose = None
 
         self.SimsGetType = None
@@ -1212,6 +1214,15 @@ class CISLLib(Singleton):
             e = sys.exc_info()
             print("Error [L049]: ", e[0], ": ", e[1])
 
+        # ISL_SimsFind
+        try:
+            self.SimsFind = self.m_Lib.ISL_SimsFind
+            self.SimsFind.restype = c_int
+            self.SimsFind.argtypes = [c_char_p, c_int]
+        except:
+            e = sys.exc_info()
+            print("Error [L113]: ", e[0], ": ", e[1])
+
         # ISL_SimsClose
         try:
             self.SimsClose = self.m_Lib.ISL_SimsClose
@@ -0,0 +1,161 @@
+/*
+ *     Name: main.cpp
+ *
+ *     Description: Lists the variables of an ISL session from its manifest.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+
+/*
+ *     Header files
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <isl_api.h>
+
+#include "swversion.h"
+
+
+/*
+ *     Macros and constants definition
+ */
+
+namespace bpo = boost::program_options;
+
+
+/*
+ *     Types definition
+ */
+
+typedef struct {
+	std::string m_sSession;
+	bool m_bAll;
+} tCmdLine;
+
+
+/*
+ *     Local functions
+ */
+
+static bool GetCmdLine(int argc, char** argv, tCmdLine * stCmdLine)
+{
+	if (stCmdLine == NULL) {
+		return false;
+	}
+	bpo::options_description bpDesc("Allowed options");
+	bpDesc.add_options()
+		("version,v", "print version number")
+		("help,h", "print help message")
+		("all,a", "also list the variables removed by their writer")
+		("session,s", bpo::value<std::string>(), "session id");
+	bpo::positional_options_description bpPos;
+	bpPos.add("session", 1);
+	bpo::variables_map bpVars;
+	try {
+		bpo::store(bpo::command_line_parser(argc, argv).options(bpDesc).positional(bpPos).run(), bpVars);
+		bpo::notify(bpVars);
+	}
+	catch (bpo::error & bpErr)
+	{
+		std::ostringstream osMsg;
+		osMsg << "Error: " << bpErr.what() << std::endl << std::endl;
+		osMsg << bpDesc;
+		ISLLogError(300, "Command line error: %s", osMsg.str().c_str());
+		return false;
+	}
+	// Help
+	if (bpVars.count("help")) {
+		std::ostringstream osMsg;
+		osMsg << bpDesc;
+		ISLLogInfo(100, "Command line description:\n%s", osMsg.str().c_str());
+		return false; // No need to go further
+	}
+	// Print version
+	if (bpVars.count("version")) {
+		ISLLogInfo(101, APP_NAME" version: " GET_APP_VERSION(FULL_VERSION_NUMBER));
+		return false; // No need to go further
+	}
+	if (bpVars.count("session") == 0) {
+		ISLLogError(301, "No session id given.");
+		return false;
+	}
+	stCmdLine->m_sSession = bpVars["session"].as<std::string>();
+	stCmdLine->m_bAll = (bpVars.count("all") > 0);
+	return true;
+}
+
+
+/*
+ *     Main function
+ */
+
+int main(int argc, char *argv[])
+{
+	tCmdLine stCmdLine;
+	if (GetCmdLine(argc, argv, &stCmdLine) == false) {
+		return 1;
+	}
+	// Only read: the manifest is not created if the session does not run
+	isl::CManifest cManifest;
+	if (cManifest.Open(stCmdLine.m_sSession, false) == false) {
+		ISLLogError(302, "No manifest found for the session '%s'.", stCmdLine.m_sSession.c_str());
+		return 1;
+	}
+	std::cout << boost::str(boost::format("%-24s %-10s %6s %-7s %6s %10s %-10s %10s %s") %
+		"Connection id" % "Type" % "Size" % "Mode" % "Depth" % "Writer" % "Segment" % "Bytes" % "State") << std::endl;
+	int nListed = 0;
+	int nCount = cManifest.GetCount();
+	for (int i = 0; i < nCount; i++) {
+		tsManifestEntry stEntry;
+		if (cManifest.GetEntry(i, stEntry) == false) {
+			continue; // Not written yet
+		}
+		if ((stEntry.uState != isl::CManifest::ME_READY) && (stCmdLine.m_bAll == false)) {
+			continue;
+		}
+		isl::CDataType cType((isl::CDataType::tType)stEntry.uType, 1);
+		// Created from the key of the connection id when no identifier is given
+		std::string sSegment = (stEntry.uSegmentId != 0 ?
+			boost::str(boost::format("0x%08x") % stEntry.uSegmentId) : std::string("key"));
+		std::cout << boost::str(boost::format("%-24s %-10s %6u %-7s %6u %10u %-10s %10u %s") %
+			stEntry.sConnectId % cType.GetIdAsStr() % stEntry.uSize %
+			isl::CVariable::GetModeStr((isl::CVariable::tMode)stEntry.uMode) % stEntry.uFifoDepth %
+			stEntry.uWriter % sSegment % stEntry.uSegmentSize %
+			(stEntry.uState == isl::CManifest::ME_READY ? "ready" : "removed")) << std::endl;
+		nListed++;
+	}
+	std::cout << boost::str(boost::format("%d variables listed (%d appended).") % nListed % nCount) << std::endl;
+	return 0;
+}
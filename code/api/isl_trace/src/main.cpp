@@ -0,0 +1,337 @@
+/*
+ *     Name: main.cpp
+ *
+ *     Description: Converts the ISL trace files to the Chrome trace format (JSON).
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+/*
+ *     Header files
+ */
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <isl_api.h>
+
+#include "swversion.h"
+
+
+/*
+ *     Macros and constants definition
+ */
+
+namespace bpo = boost::program_options;
+
+
+/*
+ *     Types definition
+ */
+
+typedef struct {
+	std::vector<std::string> m_lFiles;
+	std::string m_sOutput;
+} tCmdLine;
+
+// Call being recorded on a thread
+typedef struct {
+	unsigned short m_usEvent;
+	unsigned int m_uName;
+	double m_dTs;
+	double m_dSimTime;
+	unsigned int m_uArg;
+} tOpenCall;
+
+
+/*
+ *     Local functions
+ */
+
+static bool GetCmdLine(int argc, char** argv, tCmdLine * stCmdLine)
+{
+	if (stCmdLine == NULL) {
+		return false;
+	}
+	bpo::options_description bpDesc("Allowed options");
+	bpDesc.add_options()
+		("version,v", "print version number")
+		("help,h", "print help message")
+		("output,o", bpo::value<std::string>()->default_value("trace.json"), "Chrome trace file (JSON)")
+		("input,i", bpo::value<std::vector<std::string> >(), "ISL trace files (isl_trace_<pid>.trc)");
+	bpo::positional_options_description bpPos;
+	bpPos.add("input", -1);
+	bpo::variables_map bpVars;
+	try {
+		bpo::store(bpo::command_line_parser(argc, argv).options(bpDesc).positional(bpPos).run(), bpVars);
+		bpo::notify(bpVars);
+	}
+	catch (bpo::error & bpErr)
+	{
+		std::ostringstream osMsg;
+		osMsg << "Error: " << bpErr.what() << std::endl << std::endl;
+		osMsg << bpDesc;
+		ISLLogError(300, "Command line error: %s", osMsg.str().c_str());
+		return false;
+	}
+	// Help
+	if (bpVars.count("help")) {
+		std::ostringstream osMsg;
+		osMsg << bpDesc;
+		ISLLogInfo(100, "Command line description:\n%s", osMsg.str().c_str());
+		return false; // No need to go further
+	}
+	// Print version
+	if (bpVars.count("version")) {
+		ISLLogInfo(101, APP_NAME" version: " GET_APP_VERSION(FULL_VERSION_NUMBER));
+		return false; // No need to go further
+	}
+	if (bpVars.count("input") == 0) {
+		ISLLogError(301, "No trace file given.");
+		return false;
+	}
+	stCmdLine->m_lFiles = bpVars["input"].as<std::vector<std::string> >();
+	stCmdLine->m_sOutput = bpVars["output"].as<std::string>();
+	return true;
+}
+
+static std::string Escape(const std::string & sVal)
+{
+	std::string sRes;
+	for (size_t i = 0; i < sVal.size(); i++) {
+		unsigned char c = (unsigned char)sVal[i];
+		if ((c == '"') || (c == '\\')) {
+			sRes.push_back('\\');
+			sRes.push_back((char)c);
+		}
+		else if (c < 0x20) {
+			sRes.append(boost::str(boost::format("\\u%04x") % (unsigned int)c));
+		}
+		else {
+			sRes.push_back((char)c);
+		}
+	}
+	return sRes;
+}
+
+static std::string GetEventName(unsigned short usEvent, const std::string & sName)
+{
+	switch (usEvent) {
+	case isl::CTrace::TE_SET_ENTER:
+		return "SetData " + sName;
+	case isl::CTrace::TE_GET_ENTER:
+		return "GetData " + sName;
+	case isl::CTrace::TE_WAIT_BEGIN:
+		return "Wait " + sName;
+	case isl::CTrace::TE_WAKEUP:
+		return "Wakeup " + sName;
+	case isl::CTrace::TE_FRAME_BEGIN:
+		return "Frame " + sName;
+	case isl::CTrace::TE_STEP:
+		return "Step " + sName;
+	default:
+		return sName;
+	}
+}
+
+static std::string GetArgs(unsigned short usEvent, double dSimTime, unsigned int uArg)
+{
+	std::string sArgs = (dSimTime < 0.0 ? "" : boost::str(boost::format("\"time\":%.17g") % dSimTime));
+	std::string sExtra;
+	switch (usEvent) {
+	case isl::CTrace::TE_WAIT_BEGIN:
+		sExtra = (uArg == 0 ? "\"fifo\":\"full\"" : "\"fifo\":\"empty\"");
+		break;
+	case isl::CTrace::TE_WAKEUP:
+		sExtra = boost::str(boost::format("\"released\":%1%") % uArg);
+		break;
+	default:
+		break;
+	}
+	if ((sArgs.empty() == false) && (sExtra.empty() == false)) {
+		sArgs.append(",");
+	}
+	sArgs.append(sExtra);
+	return "{" + sArgs + "}";
+}
+
+static void WriteEvent(std::ostream & osOut, bool & bFirst, const std::string & sEvent)
+{
+	osOut << (bFirst ? "\n" : ",\n") << sEvent;
+	bFirst = false;
+}
+
+// Return the number of records converted, -1 on error
+static int Convert(const std::string & sFile, std::ostream & osOut, bool & bFirst)
+{
+	std::ifstream ifFile(sFile.c_str(), std::ios::binary);
+	if (ifFile.is_open() == false) {
+		ISLLogError(302, "Failed to open the file '%s'.", sFile.c_str());
+		return -1;
+	}
+	std::vector<char> lContent((std::istreambuf_iterator<char>(ifFile)), std::istreambuf_iterator<char>());
+	if (lContent.size() < TRACE_HEADER_SIZE + TRACE_MAX_NAMES * TRACE_NAME_SIZE) {
+		ISLLogError(303, "The file '%s' is not an ISL trace.", sFile.c_str());
+		return -1;
+	}
+	tsTraceHeader * pHeader = (tsTraceHeader *)&lContent[0];
+	if ((memcmp(pHeader->sMagic, TRACE_MAGIC, sizeof(pHeader->sMagic)) != 0)
+		|| (pHeader->uVersion != TRACE_VERSION) || (pHeader->uRecordSize != sizeof(tsTraceRecord))) {
+		ISLLogError(303, "The file '%s' is not an ISL trace.", sFile.c_str());
+		return -1;
+	}
+	unsigned long long ulCapacity = pHeader->uCapacity;
+	const char * pNames = &lContent[TRACE_HEADER_SIZE];
+	const tsTraceRecord * pRecords = (const tsTraceRecord *)(pNames + TRACE_MAX_NAMES * TRACE_NAME_SIZE);
+	if ((ulCapacity == 0) || ((ulCapacity & (ulCapacity - 1)) != 0)
+		|| (lContent.size() < TRACE_HEADER_SIZE + TRACE_MAX_NAMES * TRACE_NAME_SIZE + ulCapacity * sizeof(tsTraceRecord))) {
+		ISLLogError(304, "The trace file '%s' is truncated.", sFile.c_str());
+		return -1;
+	}
+	std::vector<std::string> lNames;
+	for (unsigned int i = 0; (i < pHeader->uNbNames) && (i < TRACE_MAX_NAMES); i++) {
+		lNames.push_back(std::string(pNames + i * TRACE_NAME_SIZE,
+			strnlen(pNames + i * TRACE_NAME_SIZE, TRACE_NAME_SIZE)));
+	}
+	unsigned long long ulPID = pHeader->ulPID;
+	WriteEvent(osOut, bFirst, boost::str(boost::format(
+		"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%1%,\"args\":{\"name\":\"%2%\"}}") %
+		ulPID % Escape(sFile)));
+	// The ring keeps the last records
+	unsigned long long ulWrite = pHeader->ulWrite;
+	unsigned long long ulFirst = (ulWrite > ulCapacity ? ulWrite - ulCapacity : 0);
+	std::map<unsigned short, std::vector<tOpenCall> > mOpen;
+	int nRecords = 0;
+	for (unsigned long long ulInd = ulFirst; ulInd < ulWrite; ulInd++) {
+		const tsTraceRecord * pRecord = &pRecords[ulInd & (ulCapacity - 1)];
+		if (pRecord->uSeq != (unsigned int)(ulInd + 1)) {
+			// Being written when the file was copied or the process stopped
+			continue;
+		}
+		std::string sName = (pRecord->uName < lNames.size() ? lNames[pRecord->uName] : "");
+		double dTs = (double)pHeader->ulWallTime + (double)pRecord->ulTime / 1000.0;
+		std::vector<tOpenCall> & lStack = mOpen[pRecord->usThread];
+		switch (pRecord->usEvent) {
+		case isl::CTrace::TE_SET_ENTER:
+		case isl::CTrace::TE_GET_ENTER:
+		case isl::CTrace::TE_WAIT_BEGIN:
+		case isl::CTrace::TE_FRAME_BEGIN:
+		{
+			tOpenCall stCall = { pRecord->usEvent, pRecord->uName, dTs, pRecord->dSimTime, pRecord->uArg };
+			lStack.push_back(stCall);
+			break;
+		}
+		case isl::CTrace::TE_SET_EXIT:
+		case isl::CTrace::TE_GET_EXIT:
+		case isl::CTrace::TE_WAIT_END:
+		case isl::CTrace::TE_FRAME_END:
+		{
+			// The enter event may have been overwritten in the ring
+			if (lStack.empty() || (lStack.back().m_usEvent + 1 != pRecord->usEvent)
+				|| (lStack.back().m_uName != pRecord->uName)) {
+				break;
+			}
+			tOpenCall stCall = lStack.back();
+			lStack.pop_back();
+			// The time read by GetData is known at the exit
+			double dSimTime = (pRecord->dSimTime >= 0.0 ? pRecord->dSimTime : stCall.m_dSimTime);
+			WriteEvent(osOut, bFirst, boost::str(boost::format(
+				"{\"name\":\"%1%\",\"cat\":\"isl\",\"ph\":\"X\",\"ts\":%2$.3f,\"dur\":%3$.3f,"
+				"\"pid\":%4%,\"tid\":%5%,\"args\":%6%}") %
+				Escape(GetEventName(stCall.m_usEvent, sName)) % stCall.m_dTs % (dTs - stCall.m_dTs) %
+				ulPID % pRecord->usThread % GetArgs(stCall.m_usEvent, dSimTime, stCall.m_uArg)));
+			break;
+		}
+		case isl::CTrace::TE_WAKEUP:
+		case isl::CTrace::TE_STEP:
+			WriteEvent(osOut, bFirst, boost::str(boost::format(
+				"{\"name\":\"%1%\",\"cat\":\"isl\",\"ph\":\"i\",\"s\":\"%2%\",\"ts\":%3$.3f,"
+				"\"pid\":%4%,\"tid\":%5%,\"args\":%6%}") %
+				Escape(GetEventName(pRecord->usEvent, sName)) %
+				(pRecord->usEvent == isl::CTrace::TE_STEP ? "p" : "t") % dTs %
+				ulPID % pRecord->usThread % GetArgs(pRecord->usEvent, pRecord->dSimTime, pRecord->uArg)));
+			break;
+		default:
+			break;
+		}
+		nRecords++;
+	}
+	// Calls not completed: the thread was blocked there when the trace was taken
+	for (std::map<unsigned short, std::vector<tOpenCall> >::iterator itThread = mOpen.begin();
+		itThread != mOpen.end(); itThread++) {
+		for (size_t i = 0; i < itThread->second.size(); i++) {
+			tOpenCall & stCall = itThread->second[i];
+			std::string sName = (stCall.m_uName < lNames.size() ? lNames[stCall.m_uName] : "");
+			WriteEvent(osOut, bFirst, boost::str(boost::format(
+				"{\"name\":\"%1%\",\"cat\":\"isl\",\"ph\":\"B\",\"ts\":%2$.3f,"
+				"\"pid\":%3%,\"tid\":%4%,\"args\":%5%}") %
+				Escape(GetEventName(stCall.m_usEvent, sName)) % stCall.m_dTs %
+				ulPID % itThread->first % GetArgs(stCall.m_usEvent, stCall.m_dSimTime, stCall.m_uArg)));
+		}
+	}
+	ISLLogInfo(102, "%s: %d records converted (%llu written).", sFile.c_str(), nRecords, ulWrite);
+	return nRecords;
+}
+
+
+/*
+ *     Main function
+ */
+
+int main(int argc, char *argv[])
+{
+	tCmdLine stCmdLine;
+	if (GetCmdLine(argc, argv, &stCmdLine) == false) {
+		return 1;
+	}
+	std::ofstream ofOut(stCmdLine.m_sOutput.c_str());
+	if (ofOut.is_open() == false) {
+		ISLLogError(305, "Failed to create the file '%s'.", stCmdLine.m_sOutput.c_str());
+		return 1;
+	}
+	// The timestamps are in microseconds since the epoch: the processes are aligned
+	ofOut << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+	bool bFirst = true;
+	int nRet = 0;
+	for (size_t i = 0; i < stCmdLine.m_lFiles.size(); i++) {
+		if (Convert(stCmdLine.m_lFiles[i], ofOut, bFirst) < 0) {
+			nRet = 1;
+		}
+	}
+	ofOut << "\n]}\n";
+	ofOut.close();
+	ISLLogInfo(103, "Chrome trace written in '%s'.", stCmdLine.m_sOutput.c_str());
+	return nRet;
+}
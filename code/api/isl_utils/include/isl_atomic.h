@@ -0,0 +1,208 @@
+/*
+ *     Name: isl_atomic.h
+ *
+ *     Description: Atomic operations on shared memory words.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+#ifndef _ISL_ATOMIC_H_
+#define _ISL_ATOMIC_H_
+
+/*
+ *     Header files
+ */
+
+#ifdef WIN32
+#include <intrin.h>
+#endif
+
+
+/*
+ *     Classes declaration
+ */
+
+namespace isl {
+	// Atomic accesses on plain words located in a shared memory segment.
+	// std::atomic cannot be used there as the memory is not constructed
+	// by the compiler and may be mapped at different addresses.
+	// Only 2, 4 and 8 bytes integral types are supported.
+	class CAtomic {
+	public:
+		template <typename T> static T Load(T * pVal)
+		{
+#ifdef WIN32
+			T tVal = *(volatile T *)pVal;
+			_ReadWriteBarrier();
+			return tVal;
+#else
+			return __atomic_load_n(pVal, __ATOMIC_ACQUIRE);
+#endif
+		}
+
+		template <typename T> static void Store(T * pVal, T tVal)
+		{
+#ifdef WIN32
+			_ReadWriteBarrier();
+			*(volatile T *)pVal = tVal;
+#else
+			__atomic_store_n(pVal, tVal, __ATOMIC_RELEASE);
+#endif
+		}
+
+		template <typename T> static T LoadSeq(T * pVal)
+		{
+#ifdef WIN32
+			_mm_mfence();
+			return *(volatile T *)pVal;
+#else
+			return __atomic_load_n(pVal, __ATOMIC_SEQ_CST);
+#endif
+		}
+
+		template <typename T> static void StoreSeq(T * pVal, T tVal)
+		{
+#ifdef WIN32
+			*(volatile T *)pVal = tVal;
+			_mm_mfence();
+#else
+			__atomic_store_n(pVal, tVal, __ATOMIC_SEQ_CST);
+#endif
+		}
+
+		// Return the previous value
+		template <typename T> static T FetchAdd(T * pVal, T tVal)
+		{
+#ifdef WIN32
+			switch (sizeof(T)) {
+			case 2:
+				return (T)_InterlockedExchangeAdd16((short *)pVal, (short)tVal);
+			case 8:
+				return (T)_InterlockedExchangeAdd64((__int64 *)pVal, (__int64)tVal);
+			default:
+				return (T)_InterlockedExchangeAdd((long *)pVal, (long)tVal);
+			}
+#else
+			return __atomic_fetch_add(pVal, tVal, __ATOMIC_SEQ_CST);
+#endif
+		}
+
+		// Return the previous value
+		template <typename T> static T Exchange(T * pVal, T tVal)
+		{
+#ifdef WIN32
+			switch (sizeof(T)) {
+			case 2:
+				return (T)_InterlockedExchange16((short *)pVal, (short)tVal);
+			case 8:
+				return (T)_InterlockedExchange64((__int64 *)pVal, (__int64)tVal);
+			default:
+				return (T)_InterlockedExchange((long *)pVal, (long)tVal);
+			}
+#else
+			return __atomic_exchange_n(pVal, tVal, __ATOMIC_SEQ_CST);
+#endif
+		}
+
+		// tExpected is updated with the current value on failure
+		template <typename T> static bool CompareExchange(T * pVal, T & tExpected, T tVal)
+		{
+#ifdef WIN32
+			T tPrev;
+			switch (sizeof(T)) {
+			case 2:
+				tPrev = (T)_InterlockedCompareExchange16((short *)pVal, (short)tVal, (short)tExpected);
+				break;
+			case 8:
+				tPrev = (T)_InterlockedCompareExchange64((__int64 *)pVal, (__int64)tVal, (__int64)tExpected);
+				break;
+			default:
+				tPrev = (T)_InterlockedCompareExchange((long *)pVal, (long)tVal, (long)tExpected);
+				break;
+			}
+			if (tPrev == tExpected) {
+				return true;
+			}
+			tExpected = tPrev;
+			return false;
+#else
+			return __atomic_compare_exchange_n(pVal, &tExpected, tVal, false,
+				__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+		}
+
+		static void FenceAcquire()
+		{
+#ifdef WIN32
+			_ReadWriteBarrier();
+#else
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+#endif
+		}
+
+		static void FenceRelease()
+		{
+#ifdef WIN32
+			_ReadWriteBarrier();
+#else
+			__atomic_thread_fence(__ATOMIC_RELEASE);
+#endif
+		}
+
+		// Orders a previous store with a following load (store-load barrier)
+		static void FenceSeq()
+		{
+#ifdef WIN32
+			_mm_mfence();
+#else
+			__atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+		}
+
+		// CPU hint used in spin loops: frees resources for the sibling hyper-thread
+		static void Pause()
+		{
+#ifdef WIN32
+#if defined(_M_ARM64) || defined(_M_ARM)
+			__yield();
+#else
+			_mm_pause();
+#endif
+#elif defined(__i386__) || defined(__x86_64__)
+			__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+			__asm__ __volatile__("yield" ::: "memory");
+#else
+			__atomic_signal_fence(__ATOMIC_SEQ_CST);
+#endif
+		}
+	};
+}
+
+#endif // _ISL_ATOMIC_H_
@@ -0,0 +1,85 @@
+/*
+ *     Name: isl_futex.h
+ *
+ *     Description: Semaphore on a shared memory word (Linux futex).
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+#ifndef _ISL_FUTEX_H_
+#define _ISL_FUTEX_H_
+
+
+/*
+ *     Classes declaration
+ */
+
+namespace isl {
+	// Counting semaphore stored in a 32 bits word of a shared memory segment.
+	// On Linux, waiters sleep on the word itself (futex): no kernel object
+	// has to be created and a release costs one system call only.
+	// Not available on Windows (CSem shall be used instead).
+	class CFutex
+	{
+	public:
+		enum tStatus {
+			SUCCESS = 0,
+			NOTAVAILABLE,
+			TIMEOUTREACHED,
+			MODIFYFAILED
+		};
+
+		static bool IsAvailable();
+
+		CFutex(unsigned int * pWord);
+		~CFutex();
+
+		void SetTimeout(int nTimeout); // milliseconds
+
+		bool Acquire();
+		bool TryAcquire(); // Does not wait
+		bool Release(int n = 1);
+
+		// The word used as a value and not as a count
+		bool WaitWhile(unsigned int uVal); // Sleeps while the word holds uVal
+		bool WakeAll(); // The word must be changed before
+
+		tStatus GetStatus();
+		int GetError();
+
+	private:
+		unsigned int * m_pWord;
+		int m_nTimeout;
+
+		tStatus m_eStatus;
+		int m_nError;
+	};
+}
+
+#endif // _ISL_FUTEX_H_
@@ -42,12 +42,22 @@
 #include <string>
 #include <fstream>
 
+#include "isl_atomic.h"
+
 
 /*
  *     Macros definition
  */
 
 #define LOG_FILE_EXT	"log"
+#define LOG_ASYNC_SIZE	4096 // Default number of messages in the asynchronous queue
+#define LOG_ASYNC_DRAIN	10 // Period (ms) of the asynchronous writer
+
+// Debug messages with a higher level are removed at compile time
+// (0 keeps only the level 0). By default, all levels are compiled.
+#ifndef ISL_LOG_MAX_DEBUG_LEVEL
+#define ISL_LOG_MAX_DEBUG_LEVEL 255
+#endif
 
 
 /*
@@ -55,9 +65,11 @@
  */
 
 namespace isl {
+	class CLogThread;
+
 	class CMsgLogger {
 	public:
-		CMsgLogger(const char * sFile, int nLine);
+		CMsgLogger(const char * sFile, int nLine) : m_sFile(sFile), m_nLine(nLine) {}
 		~CMsgLogger() {}
 
 		void Info(unsigned int uId, const char * sFormat, ...);
@@ -66,12 +78,32 @@ namespace isl {
 
 		void Debug(unsigned int uLevel, unsigned int uId, const char * sFormat, ...);
 
+		// Level given by the environment variable ISL_DEBUG_LEVEL, read once per process
+		static unsigned int GetDebugLevel()
+		{
+			int nLevel = CAtomic::Load(&m_nDebugLevel);
+			if (nLevel < 0) {
+				nLevel = LoadDebugLevel();
+			}
+			return (unsigned int)nLevel;
+		}
+		static void SetDebugLevel(unsigned int uLevel);
+
+		// Checked before the message is formatted
+		static bool IsDebugEnabled(unsigned int uLevel)
+		{
+			return (uLevel <= ISL_LOG_MAX_DEBUG_LEVEL) && (uLevel <= GetDebugLevel());
+		}
+
 	private:
-		std::string m_sFile;
+		static int LoadDebugLevel();
+
+		std::string GetContext();
+
+		const char * m_sFile;
 		int m_nLine;
 
-		std::string m_sContext;
-		unsigned int m_uDebugLevel;
+		static int m_nDebugLevel;
 	};
 
 	class CLogHandler {
@@ -98,10 +130,29 @@ namespace isl {
 		std::string GetHeader() { return m_sHeader; }
 		bool IsHeaderUsed() { return m_bUseHeader; }
 
+		// Asynchronous mode: the messages are queued without lock and written
+		// by a background thread. The queue is bounded (uSize messages, rounded
+		// to a power of 2) and the messages are dropped when it is full, except
+		// the errors which are then written by the caller.
+		// The size is only used the first time the mode is enabled.
+		void SetAsync(bool bAsync, unsigned int uSize = LOG_ASYNC_SIZE);
+		bool IsAsync();
+		// Write all queued messages
+		void Flush();
+		unsigned int GetDropped();
+
 		static void MessageHandler(tMsgType eType, const std::string & sContext,
 			const std::string & sMessage);
 
 	private:
+		struct tsRecord;
+
+		bool Push(tMsgType eType, const std::string & sContext, const std::string & sMessage);
+		void Write(tMsgType eType, const std::string & sTime, const std::string & sContext,
+			const std::string & sMessage);
+
+		static void FlushAtExit();
+
 		std::string m_sLogFile;
 		std::string m_sHeader;
 		bool m_bUseHeader;
@@ -109,6 +160,16 @@ namespace isl {
 
 		std::ofstream * m_ofLog;
 
+		// Asynchronous queue (multiple producers, single consumer)
+		int m_nAsync;
+		tsRecord * m_lRecords;
+		unsigned int m_uMask;
+		unsigned int m_uPush;
+		unsigned int m_uPop;
+		unsigned int m_uDropped;
+		unsigned int m_uReported;
+		CLogThread * m_cWriter;
+
 		static CLogHandler * m_cInstance;
 
 	public:
@@ -124,7 +185,10 @@ namespace isl {
 #define AppLogInfo		isl::CMsgLogger(__FILE__, __LINE__).Info
 #define AppLogWarning	isl::CMsgLogger(__FILE__, __LINE__).Warning
 #define AppLogError		isl::CMsgLogger(__FILE__, __LINE__).Error
-#define AppLogDebug		isl::CMsgLogger(__FILE__, __LINE__).Debug
+// The arguments are not evaluated when the level is disabled
+#define AppLogDebug(uLevel, ...) \
+	if (isl::CMsgLogger::IsDebugEnabled(uLevel) == false) {} \
+	else isl::CMsgLogger(__FILE__, __LINE__).Debug(uLevel, __VA_ARGS__)
 
 
 #endif // _ISL_LOG_H_
\ No newline at end of file
@@ -82,6 +82,8 @@ namespace isl {
 		static std::string Format(const char * sFormat, ...);
 
 		static std::string Getsha1(const std::string & sIn);
+		// FNV-1a: the same value in every process
+		static unsigned int GetHash(const std::string & sIn);
 
 		static int IsIdentifier(const std::string& sIn);
 	};
@@ -90,6 +92,8 @@ namespace isl {
 	public:
 		static void SetLibraryDirectory(const std::string & sPath, bool bNative);
 		static std::string GetRuntimePath();
+		static unsigned long GetProcessId();
+		static bool IsProcessAlive(unsigned long ulPID); // Local process only
 	};
 
 	class CFileSystem {
@@ -152,17 +152,28 @@ namespace isl {
 			tAccessMode eMode = OPEN, bool bIsGlobal = false);
 		CSem(const std::string & sKey, const std::string & sPrefix, int nInitVal = 0,
 			tAccessMode eMode = OPEN, bool bIsGlobal = false);
+		// Identifier allocated for the session (see CSessionKeys): the SysV key is the
+		// identifier itself, so no key file is created and the key is not hashed
+		CSem(unsigned int uId, int nInitVal = 0,
+			tAccessMode eMode = OPEN, bool bIsGlobal = false);
 		~CSem();
 
+		// Key given to the objects created from an identifier
+		static std::string GetIdKey(unsigned int uId);
+
 		void SetTimeout(int nTimeout); // milliseconds
 
 		void SetPrefix(const std::string & sPrefix);
 		void SetKey(const std::string & sKey, int nInitVal = 0,
 			tAccessMode eMode = OPEN, bool bIsGlobal = false);
+		void SetId(unsigned int uId, int nInitVal = 0,
+			tAccessMode eMode = OPEN, bool bIsGlobal = false);
 		std::string GetKey();
 		std::string GetName();
+		unsigned int GetId(); // 0 if created from a key
 
 		bool Acquire();
+		bool TryAcquire(); // Does not wait: fails with TIMEOUTREACHED if the count is 0
 		bool Release(int n = 1);
 
 		tStatus GetStatus();
@@ -181,6 +192,7 @@ namespace isl {
 		std::string m_sPrefix;
 		std::string m_sKey;
 		std::string m_sName;
+		unsigned int m_uId;
 		
 		int m_nInitVal;
 		int m_nTimeout;
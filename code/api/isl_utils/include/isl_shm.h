@@ -56,6 +56,8 @@ typedef void * tISLSHMHandle;
 typedef struct structISLSHMHandle {
 	key_t nKey;
 	bool bFileCreated;
+	int nFd; // POSIX backend
+	bool bHugePages;
 } tsISLSHMHandle;
 typedef tsISLSHMHandle * tISLSHMHandle;
 #endif
@@ -74,6 +76,19 @@ namespace isl {
 			READWRITE
 		};
 
+		// The POSIX backend (shm_open/mmap) is only available on Linux
+		enum tBackend {
+			SYSV = 0,
+			POSIX
+		};
+
+		// Placement of the memory on the NUMA nodes (Linux only)
+		enum tNumaPolicy {
+			NUMA_DEFAULT = 0,	// Local node of the first process touching the pages
+			NUMA_BIND,			// Node given
+			NUMA_INTERLEAVE		// Pages spread over the online nodes
+		};
+
 		enum tStatus {
 			SUCCESS = 0,
 			NOKEY,
@@ -102,9 +117,15 @@ namespace isl {
 
 		static const std::string c_sPrefix;
 		static const size_t c_nPrefixMinSize;
+		static const std::string c_sHugePagesDir;
+
+		static tBackend GetBackendFromStr(const std::string & sBackend);
 
 		CSHM(const std::string & sKey, bool bIsGlobal = false);
 		CSHM(const std::string & sKey, const std::string & sPrefix, bool bIsGlobal = false);
+		// Identifier allocated for the session (see CSessionKeys): no key file nor hash.
+		// The lock semaphore uses the same identifier.
+		CSHM(unsigned int uId, bool bIsGlobal = false);
 		~CSHM();
 
 		tStatus GetStatus();
@@ -113,8 +134,23 @@ namespace isl {
 
 		void SetPrefix(const std::string & sPrefix);
 		void SetKey(const std::string & sKey, bool bIsGlobal = false);
+		void SetId(unsigned int uId, bool bIsGlobal = false);
 		std::string GetKey();
 		std::string GetName();
+		unsigned int GetId(); // 0 if created from a key
+
+		// To be set before creating or attaching the memory. Every process sharing
+		// the memory must use the same backend; the huge pages are chosen by the creator.
+		void SetBackend(tBackend eBackend, bool bHugePages = false);
+		tBackend GetBackend();
+		// True if the memory is backed by huge pages (hugetlbfs or SHM_HUGETLB)
+		bool IsHugePages();
+		// Applied by the process creating the memory, before the pages are populated
+		void SetNumaPolicy(tNumaPolicy ePolicy, int nNode = 0);
+		tNumaPolicy GetNumaPolicy();
+		bool IsNumaApplied();
+		// Node of the first page of the memory, -1 if unknown
+		int GetNumaNode();
 
 		bool Create(int nSize, tAccessMode eMode = READWRITE);
 		int Size();
@@ -136,15 +172,33 @@ namespace isl {
 		bool Create();
 		bool Close();
 
+#ifndef WIN32
+		bool ApplyNumaPolicy(void * pAddr, size_t nSize);
+		std::string BuildPosixName(bool bHugePages);
+		bool CreatePosix(bool bHugePages);
+		bool GetPosix();
+		bool AttachPosix(bool bCreate);
+		bool DetachPosix();
+#endif
+
 	private:
 		tISLSHMHandle m_cSHM;
 
 		void * m_pData;
 		int m_nSize;
 
+		tBackend m_eBackend;
+		bool m_bHugePages;
+		void * m_pBase; // POSIX backend: mapping including the header
+		size_t m_nMapSize;
+		tNumaPolicy m_eNumaPolicy;
+		int m_nNumaNode;
+		bool m_bNumaApplied;
+
 		std::string m_sPrefix;
 		std::string m_sKey;
 		std::string m_sName;
+		unsigned int m_uId;
 
 		bool m_bIsGlobal;
 		tStatus m_eStatus;
@@ -41,6 +41,7 @@
 
 #include <boost/thread.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/function.hpp>
 
 
    /*
@@ -57,9 +58,11 @@ namespace isl {
 		};
 
 		static void Sleep(unsigned long ulMilliSec);
+		static void Reschedule(); // Gives the rest of the time slice to another thread
+		static unsigned int GetNbCores();
 
 		CThread();
-		~CThread();
+		virtual ~CThread();
 
 		bool Start();
 	protected:
@@ -83,6 +86,35 @@ namespace isl {
 		boost::thread m_cTh;
 		boost::mutex m_cLock;
 	};
+
+	// Fixed set of threads running batches of independent tasks.
+	// The calling thread takes part in the work of the batch.
+	class CThreadPool {
+	public:
+		CThreadPool(unsigned int uNbThreads = 0); // 0: number of cores
+		~CThreadPool();
+
+		unsigned int GetNbThreads() { return m_uNbThreads; }
+
+		// Calls fTask(i) for i in [0, nCount[ and returns once all the calls are completed
+		void Run(size_t nCount, const boost::function<void(size_t)> & fTask);
+
+	private:
+		void Work();
+		void RunTasks();
+
+		unsigned int m_uNbThreads;
+		boost::thread_group m_cThreads;
+		boost::mutex m_cLock;
+		boost::condition_variable m_cStart;
+		boost::condition_variable m_cDone;
+		const boost::function<void(size_t)> * m_fTask;
+		size_t m_nCount;
+		size_t m_nNext;
+		size_t m_nDone;
+		unsigned int m_uBatch;
+		bool m_bStop;
+	};
 }
 
 
@@ -0,0 +1,282 @@
+/*
+ *     Name: isl_futex.cpp
+ *
+ *     Description: Semaphore on a shared memory word (Linux futex).
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+/*
+ *     Header files
+ */
+
+#ifndef WIN32
+#include <unistd.h>
+#include <time.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+#include "isl_atomic.h"
+#include "isl_futex.h"
+
+
+/*
+ *     Local functions
+ */
+
+#ifndef WIN32
+static long FutexCall(unsigned int * pWord, int nOp, unsigned int uVal, const struct timespec * stWait)
+{
+	// The word is shared between processes: FUTEX_PRIVATE_FLAG cannot be used
+	return syscall(SYS_futex, pWord, nOp, uVal, stWait, 0, 0);
+}
+
+static void SetDeadline(int nTimeout, struct timespec * stEnd)
+{
+	clock_gettime(CLOCK_MONOTONIC, stEnd);
+	stEnd->tv_sec += nTimeout / 1000;
+	stEnd->tv_nsec += (nTimeout % 1000) * 1000000L;
+	if (stEnd->tv_nsec >= 1000000000L) {
+		stEnd->tv_sec += 1;
+		stEnd->tv_nsec -= 1000000000L;
+	}
+}
+
+// Returns false once the deadline is passed
+static bool GetTimeLeft(const struct timespec * stEnd, struct timespec * stLeft)
+{
+	struct timespec stNow;
+	clock_gettime(CLOCK_MONOTONIC, &stNow);
+	stLeft->tv_sec = stEnd->tv_sec - stNow.tv_sec;
+	stLeft->tv_nsec = stEnd->tv_nsec - stNow.tv_nsec;
+	if (stLeft->tv_nsec < 0) {
+		stLeft->tv_sec -= 1;
+		stLeft->tv_nsec += 1000000000L;
+	}
+	return (stLeft->tv_sec >= 0);
+}
+#endif
+
+
+/*
+ *     Classes definition
+ */
+
+bool isl::CFutex::IsAvailable()
+{
+#ifdef WIN32
+	return false;
+#else
+	return true;
+#endif
+}
+
+isl::CFutex::CFutex(unsigned int * pWord)
+{
+	m_pWord = pWord;
+	m_nTimeout = -1;
+	m_eStatus = SUCCESS;
+	m_nError = 0;
+}
+
+isl::CFutex::~CFutex()
+{
+	m_pWord = 0;
+}
+
+void isl::CFutex::SetTimeout(int nTimeout)
+{
+	m_nTimeout = nTimeout;
+}
+
+bool isl::CFutex::Acquire()
+{
+#ifdef WIN32
+	m_eStatus = NOTAVAILABLE;
+	return false;
+#else
+	if (m_pWord == 0) {
+		m_eStatus = NOTAVAILABLE;
+		return false;
+	}
+	struct timespec stEnd;
+	if (m_nTimeout > 0) {
+		SetDeadline(m_nTimeout, &stEnd);
+	}
+	while (true) {
+		unsigned int uVal = CAtomic::Load(m_pWord);
+		if (uVal > 0) {
+			if (CAtomic::CompareExchange(m_pWord, uVal, uVal - 1)) {
+				break;
+			}
+			continue;
+		}
+		struct timespec * stWait = 0;
+		struct timespec stLeft;
+		if (m_nTimeout > 0) {
+			if (GetTimeLeft(&stEnd, &stLeft) == false) {
+				m_eStatus = TIMEOUTREACHED;
+				return false;
+			}
+			stWait = &stLeft;
+		}
+		// Sleep only if the word is still 0
+		if (FutexCall(m_pWord, FUTEX_WAIT, 0, stWait) == -1) {
+			if (errno == ETIMEDOUT) {
+				m_eStatus = TIMEOUTREACHED;
+				return false;
+			}
+			if ((errno != EAGAIN) && (errno != EINTR)) {
+				m_eStatus = MODIFYFAILED;
+				m_nError = errno;
+				return false;
+			}
+		}
+	}
+	m_eStatus = SUCCESS;
+	m_nError = 0;
+	return true;
+#endif
+}
+
+bool isl::CFutex::TryAcquire()
+{
+	if (m_pWord == 0) {
+		m_eStatus = NOTAVAILABLE;
+		return false;
+	}
+	unsigned int uVal = CAtomic::Load(m_pWord);
+	while (uVal > 0) {
+		if (CAtomic::CompareExchange(m_pWord, uVal, uVal - 1)) {
+			m_eStatus = SUCCESS;
+			m_nError = 0;
+			return true;
+		}
+	}
+	m_eStatus = TIMEOUTREACHED;
+	return false;
+}
+
+bool isl::CFutex::Release(int n)
+{
+#ifdef WIN32
+	m_eStatus = NOTAVAILABLE;
+	return false;
+#else
+	if ((m_pWord == 0) || (n <= 0)) {
+		m_eStatus = NOTAVAILABLE;
+		return false;
+	}
+	CAtomic::FetchAdd(m_pWord, (unsigned int)n);
+	if (FutexCall(m_pWord, FUTEX_WAKE, (unsigned int)n, 0) == -1) {
+		m_eStatus = MODIFYFAILED;
+		m_nError = errno;
+		return false;
+	}
+	m_eStatus = SUCCESS;
+	m_nError = 0;
+	return true;
+#endif
+}
+
+bool isl::CFutex::WaitWhile(unsigned int uVal)
+{
+#ifdef WIN32
+	m_eStatus = NOTAVAILABLE;
+	return false;
+#else
+	if (m_pWord == 0) {
+		m_eStatus = NOTAVAILABLE;
+		return false;
+	}
+	struct timespec stEnd;
+	if (m_nTimeout > 0) {
+		SetDeadline(m_nTimeout, &stEnd);
+	}
+	while (CAtomic::Load(m_pWord) == uVal) {
+		struct timespec * stWait = 0;
+		struct timespec stLeft;
+		if (m_nTimeout > 0) {
+			if (GetTimeLeft(&stEnd, &stLeft) == false) {
+				m_eStatus = TIMEOUTREACHED;
+				return false;
+			}
+			stWait = &stLeft;
+		}
+		// Sleep only if the word still holds the value
+		if (FutexCall(m_pWord, FUTEX_WAIT, uVal, stWait) == -1) {
+			if (errno == ETIMEDOUT) {
+				m_eStatus = TIMEOUTREACHED;
+				return false;
+			}
+			if ((errno != EAGAIN) && (errno != EINTR)) {
+				m_eStatus = MODIFYFAILED;
+				m_nError = errno;
+				return false;
+			}
+		}
+	}
+	m_eStatus = SUCCESS;
+	m_nError = 0;
+	return true;
+#endif
+}
+
+bool isl::CFutex::WakeAll()
+{
+#ifdef WIN32
+	m_eStatus = NOTAVAILABLE;
+	return false;
+#else
+	if (m_pWord == 0) {
+		m_eStatus = NOTAVAILABLE;
+		return false;
+	}
+	if (FutexCall(m_pWord, FUTEX_WAKE, (unsigned int)INT_MAX, 0) == -1) {
+		m_eStatus = MODIFYFAILED;
+		m_nError = errno;
+		return false;
+	}
+	m_eStatus = SUCCESS;
+	m_nError = 0;
+	return true;
+#endif
+}
+
+isl::CFutex::tStatus isl::CFutex::GetStatus()
+{
+	return m_eStatus;
+}
+
+int isl::CFutex::GetError()
+{
+	return m_nError;
+}
@@ -37,9 +37,12 @@
  */
 
 #include <ostream>
+#include <cstdlib>
 
 #include "isl_log.h"
 #include "isl_misc.h"
+#include "isl_atomic.h"
+#include "isl_thread.h"
 #include <boost/format.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/process/environment.hpp>
@@ -59,24 +62,117 @@
 #define DEFAULT_LOG_FILE boost::str(boost::format("%1%/isl_app.log") % boost::filesystem::temp_directory_path().string())
 #endif
 #define ISL_DEBUG_LEVEL "ISL_DEBUG_LEVEL"
+#define LOG_ASYNC_MIN_SIZE 16
+
+
+/*
+ *     Local functions and classes
+ */
+
+namespace isl {
+	// Protects the outputs (console and log file)
+	static boost::mutex & GetSinkLock()
+	{
+		// Never destroyed: it can be used by the exit handler
+		static boost::mutex * cLock = new boost::mutex();
+		return *cLock;
+	}
+
+	// Only one thread drains the asynchronous queue at a time
+	static boost::mutex & GetDrainLock()
+	{
+		static boost::mutex * cLock = new boost::mutex();
+		return *cLock;
+	}
+
+	// Protects the start and stop of the writer
+	static boost::mutex & GetAsyncLock()
+	{
+		static boost::mutex * cLock = new boost::mutex();
+		return *cLock;
+	}
+
+	static std::string FormatTime(const boost::posix_time::ptime & tTime)
+	{
+		static std::locale loc(std::cout.getloc(), new boost::posix_time::time_facet("%Y.%m.%d %H:%M:%S"));
+		std::stringstream sStream;
+		sStream.imbue(loc);
+		sStream << tTime;
+		return sStream.str();
+	}
+
+	// Background writer of the asynchronous mode
+	class CLogThread : public CThread {
+	public:
+		CLogThread(CLogHandler * cHandler)
+		{
+			m_cHandler = cHandler;
+			m_nStop = 0;
+		}
+
+		void Stop() { CAtomic::Store(&m_nStop, 1); }
+
+	protected:
+		virtual void Run()
+		{
+			while (CAtomic::Load(&m_nStop) == 0) {
+				m_cHandler->Flush();
+				CThread::Sleep(LOG_ASYNC_DRAIN);
+			}
+			m_cHandler->Flush();
+		}
+
+	private:
+		CLogHandler * m_cHandler;
+		int m_nStop;
+	};
+}
+
+// Slot of the asynchronous queue. uSeq gives the state of the slot: equal to
+// the push position when free, to the push position + 1 when filled.
+struct isl::CLogHandler::tsRecord {
+	unsigned int uSeq;
+	tMsgType eType;
+	boost::posix_time::ptime tTime;
+	std::string sContext;
+	std::string sMessage;
+};
 
 
 /*
  *     Classes definition
  */
 
-isl::CMsgLogger::CMsgLogger(const char * sFile, int nLine)
-{
-	m_sFile = sFile;
-	m_nLine = nLine;
+int isl::CMsgLogger::m_nDebugLevel = -1;
 
-	m_sContext = boost::str(boost::format("%1%:%2%") % sFile % nLine);
+int isl::CMsgLogger::LoadDebugLevel()
+{
+	int nLevel;
 	try {
-		m_uDebugLevel = boost::lexical_cast<int>(boost::this_process::environment()["ISL_DEBUG_LEVEL"].to_string());
+		nLevel = boost::lexical_cast<int>(boost::this_process::environment()[ISL_DEBUG_LEVEL].to_string());
 	}
 	catch (...) {
-		m_uDebugLevel = 0;
+		nLevel = 0;
+	}
+	if (nLevel < 0) {
+		nLevel = 0;
+	}
+	// Concurrent first calls read the same value
+	CAtomic::Store(&m_nDebugLevel, nLevel);
+	return nLevel;
+}
+
+void isl::CMsgLogger::SetDebugLevel(unsigned int uLevel)
+{
+	CAtomic::Store(&m_nDebugLevel, (int)uLevel);
+}
+
+std::string isl::CMsgLogger::GetContext()
+{
+	if (AppLog->IsContextUsed() == false) {
+		return "";
 	}
+	return boost::str(boost::format("%1%:%2%") % m_sFile % m_nLine);
 }
 
 void isl::CMsgLogger::Info(unsigned int uId, const char * sFormat, ...)
@@ -90,7 +186,7 @@ void isl::CMsgLogger::Info(unsigned int uId, const char * sFormat, ...)
 	std::vsnprintf(&sVec[0], len + 1, sFormat, lArgs);
 	va_end(lArgs);
 	std::string sMsg = boost::str(boost::format("[%1%]: %2%") % uId % &sVec[0]);
-	isl::CLogHandler::MessageHandler(isl::CLogHandler::MSG_INFO, m_sContext, sMsg);
+	isl::CLogHandler::MessageHandler(isl::CLogHandler::MSG_INFO, GetContext(), sMsg);
 }
 
 void isl::CMsgLogger::Warning(unsigned int uId, const char * sFormat, ...)
@@ -104,7 +200,7 @@ void isl::CMsgLogger::Warning(unsigned int uId, const char * sFormat, ...)
 	std::vsnprintf(&sVec[0], len + 1, sFormat, lArgs);
 	va_end(lArgs);
 	std::string sMsg = boost::str(boost::format("[%1%]: %2%") % uId % &sVec[0]);
-	isl::CLogHandler::MessageHandler(isl::CLogHandler::MSG_WARNING, m_sContext, sMsg);
+	isl::CLogHandler::MessageHandler(isl::CLogHandler::MSG_WARNING, GetContext(), sMsg);
 }
 
 void isl::CMsgLogger::Error(unsigned int uId, const char * sFormat, ...)
@@ -118,12 +214,12 @@ void isl::CMsgLogger::Error(unsigned int uId, const char * sFormat, ...)
 	std::vsnprintf(&sVec[0], len + 1, sFormat, lArgs);
 	va_end(lArgs);
 	std::string sMsg = boost::str(boost::format("[%1%]: %2%") % uId % &sVec[0]);
-	isl::CLogHandler::MessageHandler(isl::CLogHandler::MSG_ERROR, m_sContext, sMsg);
+	isl::CLogHandler::MessageHandler(isl::CLogHandler::MSG_ERROR, GetContext(), sMsg);
 }
 
 void isl::CMsgLogger::Debug(unsigned int uLevel, unsigned int uId, const char * sFormat, ...)
 {
-	if (m_uDebugLevel >= uLevel) {
+	if (IsDebugEnabled(uLevel)) {
 		va_list lArgs;
 		va_start(lArgs, sFormat);
 		size_t len = std::vsnprintf(NULL, 0, sFormat, lArgs);
@@ -133,7 +229,7 @@ void isl::CMsgLogger::Debug(unsigned int uLevel, unsigned int uId, const char *
 		std::vsnprintf(&sVec[0], len + 1, sFormat, lArgs);
 		va_end(lArgs);
 		std::string sMsg = boost::str(boost::format("[L%1%] [%2%]: %3%") % uLevel % uId % &sVec[0]);
-		isl::CLogHandler::MessageHandler(isl::CLogHandler::MSG_DEBUG, m_sContext, sMsg);
+		isl::CLogHandler::MessageHandler(isl::CLogHandler::MSG_DEBUG, GetContext(), sMsg);
 	}
 }
 
@@ -145,10 +241,23 @@ isl::CLogHandler::CLogHandler()
 	m_ofLog = NULL;
 	m_bUseHeader = false;
 	m_bUseContext = false;
+	m_nAsync = 0;
+	m_lRecords = NULL;
+	m_uMask = 0;
+	m_uPush = 0;
+	m_uPop = 0;
+	m_uDropped = 0;
+	m_uReported = 0;
+	m_cWriter = NULL;
 }
 
 isl::CLogHandler::~CLogHandler()
 {
+	SetAsync(false);
+	if (m_lRecords != NULL) {
+		delete[] m_lRecords;
+	}
+	m_lRecords = NULL;
 	if (m_ofLog != NULL) {
 		m_ofLog->close();
 		delete m_ofLog;
@@ -158,6 +267,9 @@ isl::CLogHandler::~CLogHandler()
 
 void isl::CLogHandler::Init(const std::string & sFile)
 {
+	// The queued messages go to the previous log file
+	Flush();
+	boost::mutex::scoped_lock cLock(GetSinkLock());
 	m_sLogFile = sFile;
 	if (m_sLogFile.empty() == false) {
 		// Close old
@@ -187,12 +299,115 @@ void isl::CLogHandler::SetHeader(const std::string & sHeader)
 	m_sHeader = sHeader;
 }
 
-void isl::CLogHandler::MessageHandler(tMsgType eType, const std::string & sContext,
+void isl::CLogHandler::SetAsync(bool bAsync, unsigned int uSize)
+{
+	static bool bExitHandler = false;
+	boost::mutex::scoped_lock cLock(GetAsyncLock());
+	if (bAsync) {
+		if (m_cWriter != NULL) {
+			return;
+		}
+		if (m_lRecords == NULL) {
+			unsigned int uCapacity = LOG_ASYNC_MIN_SIZE;
+			while ((uCapacity < uSize) && (uCapacity < 0x80000000)) {
+				uCapacity <<= 1;
+			}
+			m_lRecords = new tsRecord[uCapacity];
+			for (unsigned int i = 0; i < uCapacity; i++) {
+				m_lRecords[i].uSeq = i;
+			}
+			m_uMask = uCapacity - 1;
+		}
+		m_cWriter = new isl::CLogThread(this);
+		m_cWriter->Start();
+		CAtomic::Store(&m_nAsync, 1);
+		if (bExitHandler == false) {
+			// The time format is built first: destroyed after the exit handler runs
+			FormatTime(boost::posix_time::second_clock::local_time());
+			std::atexit(&isl::CLogHandler::FlushAtExit);
+			bExitHandler = true;
+		}
+	}
+	else {
+		if (m_cWriter == NULL) {
+			return;
+		}
+		CAtomic::StoreSeq(&m_nAsync, 0);
+		// The writer drains the queue before ending
+		m_cWriter->Stop();
+		m_cWriter->Join();
+		delete m_cWriter;
+		m_cWriter = NULL;
+		// Messages pushed while stopping
+		Flush();
+	}
+}
+
+bool isl::CLogHandler::IsAsync()
+{
+	return CAtomic::Load(&m_nAsync) != 0;
+}
+
+void isl::CLogHandler::Flush()
+{
+	boost::mutex::scoped_lock cLock(GetDrainLock());
+	if (m_lRecords == NULL) {
+		return;
+	}
+	for (;;) {
+		tsRecord * pRecord = &m_lRecords[m_uPop & m_uMask];
+		if (CAtomic::Load(&pRecord->uSeq) != m_uPop + 1) {
+			break;
+		}
+		Write(pRecord->eType, FormatTime(pRecord->tTime), pRecord->sContext, pRecord->sMessage);
+		// Free the slot for the next round
+		CAtomic::Store(&pRecord->uSeq, m_uPop + m_uMask + 1);
+		m_uPop++;
+	}
+	unsigned int uDropped = CAtomic::Load(&m_uDropped);
+	if (uDropped != m_uReported) {
+		Write(MSG_WARNING, FormatTime(boost::posix_time::second_clock::local_time()), "",
+			boost::str(boost::format("[0]: %1% log message(s) dropped, the asynchronous queue is full.") %
+			(uDropped - m_uReported)));
+		m_uReported = uDropped;
+	}
+}
+
+unsigned int isl::CLogHandler::GetDropped()
+{
+	return CAtomic::Load(&m_uDropped);
+}
+
+bool isl::CLogHandler::Push(tMsgType eType, const std::string & sContext, const std::string & sMessage)
+{
+	unsigned int uPos = CAtomic::Load(&m_uPush);
+	for (;;) {
+		tsRecord * pRecord = &m_lRecords[uPos & m_uMask];
+		int nDiff = (int)(CAtomic::Load(&pRecord->uSeq) - uPos);
+		if (nDiff == 0) {
+			if (CAtomic::CompareExchange(&m_uPush, uPos, uPos + 1)) {
+				pRecord->eType = eType;
+				pRecord->tTime = boost::posix_time::second_clock::local_time();
+				pRecord->sContext = sContext;
+				pRecord->sMessage = sMessage;
+				CAtomic::Store(&pRecord->uSeq, uPos + 1);
+				return true;
+			}
+			// uPos updated by the failed exchange
+		}
+		else if (nDiff < 0) {
+			// Full: never block the caller
+			return false;
+		}
+		else {
+			uPos = CAtomic::Load(&m_uPush);
+		}
+	}
+}
+
+void isl::CLogHandler::Write(tMsgType eType, const std::string & sTime, const std::string & sContext,
 	const std::string & sMessage)
 {
-	static boost::mutex cSync;
-	cSync.lock();
-	//
 	std::string sToPrint;
 	std::ostream * fOut = &std::cout;
 	switch (eType) {
@@ -214,29 +429,57 @@ void isl::CLogHandler::MessageHandler(tMsgType eType, const std::string & sConte
 			sToPrint = "Info";
 			break;
 	}
-	static std::locale loc(std::cout.getloc(), new boost::posix_time::time_facet("%Y.%m.%d %H:%M:%S"));
-	std::stringstream sStream;
-	sStream.imbue(loc);
-	sStream << boost::posix_time::second_clock::local_time();
-	sToPrint.append(boost::str(boost::format(" (%1%)") % sStream.str()));
-	if (AppLog->IsHeaderUsed()) {
-		sToPrint.append(boost::str(boost::format(" (%1%)") % AppLog->GetHeader()));
+	sToPrint.append(boost::str(boost::format(" (%1%)") % sTime));
+	if (IsHeaderUsed()) {
+		sToPrint.append(boost::str(boost::format(" (%1%)") % GetHeader()));
 	}
 	sToPrint.append(boost::str(boost::format(" : %1%") % sMessage));
-	if (AppLog->IsContextUsed()) {
+	if (IsContextUsed() && (sContext.empty() == false)) {
 		sToPrint.append(boost::str(boost::format(" (%1%)") % sContext));
 	}
+	boost::mutex::scoped_lock cLock(GetSinkLock());
 	// Print to stderr/stdout
 	*fOut << sToPrint << std::endl;
 
 	// Print in log file
-	std::ofstream * ofLog = AppLog->GetLog();
-	if (ofLog != NULL) {
-		if (ofLog->bad() == false) {
-			*ofLog << sToPrint << std::endl;
+	if (m_ofLog != NULL) {
+		if (m_ofLog->bad() == false) {
+			*m_ofLog << sToPrint << std::endl;
+		}
+	}
+}
+
+void isl::CLogHandler::MessageHandler(tMsgType eType, const std::string & sContext,
+	const std::string & sMessage)
+{
+	isl::CLogHandler * cLog = AppLog;
+	if (cLog->IsAsync()) {
+		if (cLog->Push(eType, sContext, sMessage) == false) {
+			if (eType != MSG_ERROR) {
+				CAtomic::FetchAdd(&cLog->m_uDropped, 1u);
+				return;
+			}
+			// The queue is full: an error is not lost but written now
+			cLog->Write(eType, FormatTime(boost::posix_time::second_clock::local_time()), sContext, sMessage);
+			return;
+		}
+		// The last flush of SetAsync(false) may have been done before the push
+		CAtomic::FenceSeq();
+		if (cLog->IsAsync() == false) {
+			cLog->Flush();
 		}
+		return;
+	}
+	cLog->Write(eType, FormatTime(boost::posix_time::second_clock::local_time()), sContext, sMessage);
+}
+
+void isl::CLogHandler::FlushAtExit()
+{
+	// The writer thread uses static objects (time format): it is stopped
+	// before they are destroyed, then the remaining messages are written
+	if (m_cInstance != NULL) {
+		m_cInstance->SetAsync(false);
 	}
-	cSync.unlock();
 }
 
 isl::CLogHandler * isl::CLogHandler::Instance()
@@ -43,6 +43,8 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <dlfcn.h>
+#include <signal.h>
+#include <unistd.h>
 #endif // WIN32
 
 #include <isl_misc.h>
@@ -191,6 +193,16 @@ std::string isl::CString::Getsha1(const std::string & sIn)
 	return std::string(sBuf);
 }
 
+unsigned int isl::CString::GetHash(const std::string & sIn)
+{
+	unsigned int uHash = 2166136261u;
+	for (std::string::size_type i = 0; i < sIn.size(); i++) {
+		uHash ^= (unsigned char)sIn[i];
+		uHash *= 16777619u;
+	}
+	return uHash;
+}
+
 int isl::CString::IsIdentifier(const std::string& sIn)
 {
 	for (std::string::size_type i = 0; i < sIn.size(); i++) {
@@ -261,6 +273,35 @@ std::string isl::CApplication::GetRuntimePath()
 	return sRes;
 }
 
+unsigned long isl::CApplication::GetProcessId()
+{
+#ifdef WIN32
+	return (unsigned long)GetCurrentProcessId();
+#else
+	return (unsigned long)getpid();
+#endif
+}
+
+bool isl::CApplication::IsProcessAlive(unsigned long ulPID)
+{
+#ifdef WIN32
+	HANDLE hProcess = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)ulPID);
+	if (hProcess == NULL) {
+		// Not existing anymore, unless not accessible
+		return (GetLastError() == ERROR_ACCESS_DENIED);
+	}
+	bool bAlive = (WaitForSingleObject(hProcess, 0) == WAIT_TIMEOUT);
+	CloseHandle(hProcess);
+	return bAlive;
+#else
+	// No signal sent, only the existence of the process is checked
+	if (kill((pid_t)ulPID, 0) == 0) {
+		return true;
+	}
+	return (errno == EPERM);
+#endif
+}
+
 int isl::CFileSystem::CreateEmptyFile(const std::string & sFileName)
 {
 #ifdef WIN32
@@ -47,6 +47,7 @@
 #include <errno.h>
 #include <boost/filesystem.hpp>
 #endif
+#include <stdio.h>
 #include <vector>
 #include "isl_sem.h"
 #include "isl_misc.h"
@@ -332,6 +333,8 @@ isl::CSem::CSem(const std::string & sKey, int nInitVal, tAccessMode eMode, bool
 {
 	m_bIsGlobal = bIsGlobal;
 	m_cSem = 0;
+	m_uId = 0;
+	m_nTimeout = -1;
 	m_sPrefix = c_sPrefix;
 	SetKey(sKey, nInitVal, eMode, bIsGlobal);
 }
@@ -340,11 +343,23 @@ isl::CSem::CSem(const std::string & sKey, const std::string & sPrefix, int nInit
 {
 	m_bIsGlobal = bIsGlobal;
 	m_cSem = 0;
+	m_uId = 0;
+	m_nTimeout = -1;
 	m_sPrefix = c_sPrefix;
 	SetPrefix(sPrefix);
 	SetKey(sKey, nInitVal, eMode, bIsGlobal);
 }
 
+isl::CSem::CSem(unsigned int uId, int nInitVal, tAccessMode eMode, bool bIsGlobal)
+{
+	m_bIsGlobal = bIsGlobal;
+	m_cSem = 0;
+	m_uId = 0;
+	m_nTimeout = -1;
+	m_sPrefix = c_sPrefix;
+	SetId(uId, nInitVal, eMode, bIsGlobal);
+}
+
 isl::CSem::~CSem()
 {
 	Close();
@@ -376,7 +391,7 @@ void isl::CSem::SetKey(const std::string & sKey, int nInitVal, tAccessMode eMode
 #ifndef WIN32
 	if (m_cSem != 0) {
 		if ((m_sKey == sKey) && (eMode == CREATE)) {
-			if (m_cSem->bSemCreated && m_cSem->bFileCreated) {
+			if (m_cSem->bSemCreated && (m_cSem->bFileCreated || (m_uId != 0))) {
 				m_nInitVal = nInitVal;
 				m_cSem->nKey = -1;
 				Create(eMode);
@@ -387,6 +402,9 @@ void isl::CSem::SetKey(const std::string & sKey, int nInitVal, tAccessMode eMode
 	m_bIsGlobal = bIsGlobal;
 	m_eStatus = SUCCESS;
 	m_nError = 0;
+	if (sKey != GetIdKey(m_uId)) {
+		m_uId = 0;
+	}
 	m_sKey = sKey;
 	m_sName = BuildName();
 	m_eMode = eMode;
@@ -395,6 +413,26 @@ void isl::CSem::SetKey(const std::string & sKey, int nInitVal, tAccessMode eMode
 	Create();
 }
 
+void isl::CSem::SetId(unsigned int uId, int nInitVal, tAccessMode eMode, bool bIsGlobal)
+{
+	if (uId == 0) {
+		SetKey(std::string(), nInitVal, eMode, bIsGlobal);
+		return;
+	}
+	m_uId = uId;
+	SetKey(GetIdKey(uId), nInitVal, eMode, bIsGlobal);
+}
+
+std::string isl::CSem::GetIdKey(unsigned int uId)
+{
+	if (uId == 0) {
+		return std::string();
+	}
+	char sKey[16];
+	snprintf(sKey, sizeof(sKey), "#%08x", uId);
+	return std::string(sKey);
+}
+
 std::string isl::CSem::GetKey()
 {
 	return m_sKey;
@@ -405,11 +443,55 @@ std::string isl::CSem::GetName()
 	return m_sName;
 }
 
+unsigned int isl::CSem::GetId()
+{
+	return m_uId;
+}
+
 bool isl::CSem::Acquire()
 {
 	return Modify(-1);
 }
 
+bool isl::CSem::TryAcquire()
+{
+	if (m_cSem == 0) {
+		return false;
+	}
+#ifdef WIN32
+	DWORD ulRes = WaitForSingleObjectEx(m_cSem, 0, FALSE);
+	if (ulRes != WAIT_OBJECT_0) {
+		m_eStatus = ACQUIREFAILED;
+		if (ulRes == WAIT_TIMEOUT) {
+			m_eStatus = TIMEOUTREACHED;
+		}
+		return false;
+	}
+#else
+	struct sembuf stOp;
+	stOp.sem_num = 0;
+	stOp.sem_op = -1;
+	stOp.sem_flg = SEM_UNDO | IPC_NOWAIT;
+	int nRet = -1;
+	do {
+		nRet = semop(m_cSem->nSemaphore, &stOp, 1);
+		if ((nRet == -1) && (errno == ERANGE) && (stOp.sem_flg & SEM_UNDO)) {
+			// The undo value of the process is saturated (the semaphore is used for signals)
+			stOp.sem_flg = IPC_NOWAIT;
+			errno = EINTR;
+		}
+	} while (nRet == -1 && errno == EINTR);
+	if (nRet == -1) {
+		m_eStatus = (errno == EAGAIN ? TIMEOUTREACHED : MODIFYFAILED);
+		m_nError = errno;
+		return false;
+	}
+#endif // WIN32
+	m_eStatus = SUCCESS;
+	m_nError = 0;
+	return true;
+}
+
 bool isl::CSem::Release(int n)
 {
 	if (n < 0) {
@@ -443,9 +525,17 @@ std::string isl::CSem::BuildName()
 		sName += isl::CIPCGlobal::Instance()->GetPrefix();
 	}
 #else
-	std::string sName = boost::filesystem::temp_directory_path().string() + "/";
+	std::string sName;
+	if (m_uId == 0) {
+		sName = boost::filesystem::temp_directory_path().string() + "/";
+	}
 #endif
 	sName += m_sPrefix; // Set the prefix
+	if (m_uId != 0) {
+		char sId[16];
+		snprintf(sId, sizeof(sId), "id%08x", m_uId);
+		return sName + sId;
+	}
 	std::string sTmpKey = isl::CString::ToWord(m_sKey);
 	if (sTmpKey.empty()) {
 		m_eStatus = WRONGKEYFORMAT;
@@ -509,19 +599,24 @@ bool isl::CSem::Create(tAccessMode eMode)
 		if (m_cSem->nKey != -1) {
 			return true;
 		}
-		int nRet = isl::CFileSystem::CreateEmptyFile(m_sName);
 		m_cSem->bFileCreated = false;
-		if (nRet == -1) {
-			m_eStatus = KEYERROR;
-			return false;
-		}
-		else if (nRet == 1) {
-			m_cSem->bFileCreated = true;
+		if (m_uId != 0) {
+			m_cSem->nKey = (key_t)m_uId;
 		}
-		m_cSem->nKey = ftok(m_sName.c_str(), 73);
-		if (m_cSem->nKey == -1) {
-			m_eStatus = KEYERROR;
-			return false;
+		else {
+			int nRet = isl::CFileSystem::CreateEmptyFile(m_sName);
+			if (nRet == -1) {
+				m_eStatus = KEYERROR;
+				return false;
+			}
+			else if (nRet == 1) {
+				m_cSem->bFileCreated = true;
+			}
+			m_cSem->nKey = ftok(m_sName.c_str(), 73);
+			if (m_cSem->nKey == -1) {
+				m_eStatus = KEYERROR;
+				return false;
+			}
 		}
 		m_cSem->nSemaphore = semget(m_cSem->nKey, 1, 0600 | IPC_CREAT | IPC_EXCL);
 		if (m_cSem->nSemaphore == -1) {
@@ -537,11 +632,11 @@ bool isl::CSem::Create(tAccessMode eMode)
 		}
 		else {
 			m_cSem->bSemCreated = true;
-			m_cSem->bFileCreated = true;
+			m_cSem->bFileCreated = (m_uId == 0);
 		}
 		if (eMode == CREATE) {
 			m_cSem->bSemCreated = true;
-			m_cSem->bFileCreated = true;
+			m_cSem->bFileCreated = (m_uId == 0);
 		}
 		if (m_cSem->bSemCreated && m_nInitVal >= 0) {
 			semun uInitValOp;
@@ -632,12 +727,17 @@ bool isl::CSem::Modify(int n)
 	struct timespec * stWait = 0;
 	if (m_nTimeout > 0) {
 		stWait = new timespec;
-		stWait->tv_sec = m_nTimeout * 1000;
-		stWait->tv_nsec = 0;
+		stWait->tv_sec = m_nTimeout / 1000;
+		stWait->tv_nsec = (m_nTimeout % 1000) * 1000000L;
 	}
 	int nRet = -1;
 	do {
 		nRet = semtimedop(m_cSem->nSemaphore, &stOp, 1, stWait);
+		if ((nRet == -1) && (errno == ERANGE) && (stOp.sem_flg & SEM_UNDO)) {
+			// The undo value of the process is saturated (the semaphore is used for signals)
+			stOp.sem_flg = 0;
+			errno = EINTR;
+		}
 	} while (nRet == -1 && errno == EINTR);
 	if (stWait != 0) {
 		delete stWait;
@@ -650,7 +750,7 @@ bool isl::CSem::Modify(int n)
 			Create();
 			return Modify(n);
 		}
-		m_eStatus = MODIFYFAILED;
+		m_eStatus = (errno == EAGAIN ? TIMEOUTREACHED : MODIFYFAILED);
 		m_nError = errno;
 		return false;
 	}
@@ -43,14 +43,41 @@
 #include <sys/ipc.h>
 #include <sys/shm.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/vfs.h>
+#include <sys/syscall.h>
+#include <linux/magic.h>
+#include <linux/mempolicy.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
 #include <boost/filesystem.hpp>
 #endif
+#include <stdio.h>
 #include "isl_shm.h"
 #include "isl_misc.h"
 
 
+/*
+ *     Constants and types definition
+ */
+
+#ifndef WIN32
+// Header of the POSIX memories: SysV gives the number of attached processes,
+// it is counted here under the lock of the memory
+#define SHM_POSIX_MAGIC 0x4D4C5349
+#define SHM_POSIX_HEADER_SIZE 64 // Keeps the data aligned on a cache line
+
+typedef struct structISLSHMHeader {
+	unsigned int uMagic;
+	int nAttached;
+	int nSize;
+} tsISLSHMHeader;
+#endif
+
+
 /*
  *     Classes definition
  */
@@ -86,17 +113,115 @@ namespace isl {
 
 const std::string isl::CSHM::c_sPrefix = "isl_sysshm_";
 const size_t isl::CSHM::c_nPrefixMinSize = 3;
+const std::string isl::CSHM::c_sHugePagesDir = "/dev/hugepages";
+
+#ifndef WIN32
+static isl::CSHM::tStatus GetStatusFromErrno(int nError)
+{
+	switch (nError) {
+	case EACCES:
+		return isl::CSHM::PERMISSIONDENIED;
+	case EINVAL:
+	case EFBIG:
+		return isl::CSHM::INVALIDSIZE;
+	case ENOENT:
+		return isl::CSHM::NOTFOUND;
+	case EMFILE:
+	case ENFILE:
+	case ENOSPC:
+		return isl::CSHM::OUTOFRESOURCES;
+	case ENOMEM:
+		return isl::CSHM::OUTOFMEMORY;
+	case EEXIST:
+		return isl::CSHM::ALREADYEXISTS;
+	default:
+		break;
+	}
+	return isl::CSHM::UNKNOWN;
+}
+
+static size_t GetHugePageSize()
+{
+	static size_t nHugePageSize = 0;
+	if (nHugePageSize == 0) {
+		size_t nSize = 2 * 1024 * 1024;
+		std::ifstream fsInfo("/proc/meminfo");
+		std::string sLine;
+		while (std::getline(fsInfo, sLine)) {
+			if (sLine.compare(0, 13, "Hugepagesize:") == 0) { // In kB
+				nSize = (size_t)strtoul(sLine.c_str() + 13, NULL, 10) * 1024;
+				break;
+			}
+		}
+		nHugePageSize = nSize;
+	}
+	return nHugePageSize;
+}
+
+// Format of the list: 0-1,3
+static bool GetOnlineNumaNodes(unsigned long * lMask, size_t nMaxNodes)
+{
+	std::ifstream fsNodes("/sys/devices/system/node/online");
+	std::string sList;
+	if (std::getline(fsNodes, sList).fail()) {
+		return false;
+	}
+	const size_t nBits = 8 * sizeof(unsigned long);
+	bool bFound = false;
+	const char * pCur = sList.c_str();
+	while (*pCur != '\0') {
+		char * pEnd = NULL;
+		unsigned long uFirst = strtoul(pCur, &pEnd, 10);
+		if (pEnd == pCur) {
+			break;
+		}
+		unsigned long uLast = uFirst;
+		pCur = pEnd;
+		if (*pCur == '-') {
+			uLast = strtoul(pCur + 1, &pEnd, 10);
+			pCur = pEnd;
+		}
+		for (unsigned long i = uFirst; (i <= uLast) && (i < nMaxNodes); i++) {
+			lMask[i / nBits] |= 1UL << (i % nBits);
+			bFound = true;
+		}
+		if (*pCur == ',') {
+			pCur++;
+		}
+		else {
+			break;
+		}
+	}
+	return bFound;
+}
+#endif
+
+isl::CSHM::tBackend isl::CSHM::GetBackendFromStr(const std::string & sBackend)
+{
+	if (sBackend == "posix") {
+		return POSIX;
+	}
+	return SYSV;
+}
 
 isl::CSHM::CSHM(const std::string & sKey, bool bIsGlobal) : m_cSem(std::string())
 {
 	m_bIsGlobal = bIsGlobal;
 	m_pData = 0;
 	m_nSize = 0;
+	m_eBackend = SYSV;
+	m_bHugePages = false;
+	m_pBase = 0;
+	m_nMapSize = 0;
+	m_eNumaPolicy = NUMA_DEFAULT;
+	m_nNumaNode = 0;
+	m_bNumaApplied = false;
 	m_eStatus = SUCCESS;
 	m_nError = 0;
 	m_cSHM = 0;
 	m_bLockedByMe = false;
 	m_bCreationMode = false;
+	m_uId = 0;
 	m_sPrefix = c_sPrefix;
 	SetKey(sKey, bIsGlobal);
 }
@@ -107,16 +232,46 @@ isl::CSHM::CSHM(const std::string & sKey, const std::string & sPrefix, bool bIsG
 	m_bIsGlobal = bIsGlobal;
 	m_pData = 0;
 	m_nSize = 0;
+	m_eBackend = SYSV;
+	m_bHugePages = false;
+	m_pBase = 0;
+	m_nMapSize = 0;
+	m_eNumaPolicy = NUMA_DEFAULT;
+	m_nNumaNode = 0;
+	m_bNumaApplied = false;
 	m_eStatus = SUCCESS;
 	m_nError = 0;
 	m_cSHM = 0;
 	m_bLockedByMe = false;
 	m_bCreationMode = false;
+	m_uId = 0;
 	m_sPrefix = c_sPrefix;
 	SetPrefix(sPrefix);
 	SetKey(sKey, bIsGlobal);
 }
 
+isl::CSHM::CSHM(unsigned int uId, bool bIsGlobal) : m_cSem(std::string())
+{
+	m_bIsGlobal = bIsGlobal;
+	m_pData = 0;
+	m_nSize = 0;
+	m_eBackend = SYSV;
+	m_bHugePages = false;
+	m_pBase = 0;
+	m_nMapSize = 0;
+	m_eNumaPolicy = NUMA_DEFAULT;
+	m_nNumaNode = 0;
+	m_bNumaApplied = false;
+	m_eStatus = SUCCESS;
+	m_nError = 0;
+	m_cSHM = 0;
+	m_bLockedByMe = false;
+	m_bCreationMode = false;
+	m_uId = 0;
+	m_sPrefix = c_sPrefix;
+	SetId(uId, bIsGlobal);
+}
+
 isl::CSHM::~CSHM()
 {
 	if (IsAttached()) {
@@ -168,10 +323,30 @@ void isl::CSHM::SetKey(const std::string & sKey, bool bIsGlobal)
 		Detach();
 	}
 	Close();
+	if (sKey != CSem::GetIdKey(m_uId)) {
+		m_uId = 0;
+	}
 	m_sKey = sKey;
 	m_sName = BuildName();
 }
 
+void isl::CSHM::SetId(unsigned int uId, bool bIsGlobal)
+{
+	if (uId == 0) {
+		SetKey(std::string(), bIsGlobal);
+		return;
+	}
+	std::string sKey = CSem::GetIdKey(uId);
+	if (sKey != m_sKey) {
+		if (IsAttached()) {
+			Detach();
+		}
+		Close();
+	}
+	m_uId = uId;
+	SetKey(sKey, bIsGlobal);
+}
+
 std::string isl::CSHM::GetKey()
 {
 	return m_sKey;
@@ -182,6 +357,68 @@ std::string isl::CSHM::GetName()
 	return m_sName;
 }
 
+unsigned int isl::CSHM::GetId()
+{
+	return m_uId;
+}
+
+void isl::CSHM::SetBackend(tBackend eBackend, bool bHugePages)
+{
+	if (IsAttached()) {
+		return;
+	}
+#ifndef WIN32
+	m_eBackend = eBackend;
+	m_bHugePages = bHugePages;
+#endif
+}
+
+isl::CSHM::tBackend isl::CSHM::GetBackend()
+{
+	return m_eBackend;
+}
+
+bool isl::CSHM::IsHugePages()
+{
+#ifdef WIN32
+	return false;
+#else
+	return (IsAttached() && (m_cSHM != 0) && m_cSHM->bHugePages);
+#endif
+}
+
+void isl::CSHM::SetNumaPolicy(tNumaPolicy ePolicy, int nNode)
+{
+	m_eNumaPolicy = ePolicy;
+	m_nNumaNode = nNode;
+}
+
+isl::CSHM::tNumaPolicy isl::CSHM::GetNumaPolicy()
+{
+	return m_eNumaPolicy;
+}
+
+bool isl::CSHM::IsNumaApplied()
+{
+	return m_bNumaApplied;
+}
+
+int isl::CSHM::GetNumaNode()
+{
+#ifdef WIN32
+	return -1;
+#else
+	if (IsAttached() == false) {
+		return -1;
+	}
+	int nNode = -1;
+	if (syscall(SYS_get_mempolicy, &nNode, NULL, 0, m_pData, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+		return -1;
+	}
+	return nNode;
+#endif
+}
+
 bool isl::CSHM::Create(int nSize, tAccessMode eMode)
 {
 	if (Init() == false) {
@@ -238,7 +475,14 @@ bool isl::CSHM::Attach(tAccessMode eMode)
 			return false;
 		}
 	}
+	bool bCreate = m_bCreationMode;
 	m_bCreationMode = false;
+	m_bNumaApplied = false;
+#ifndef WIN32
+	if (m_eBackend == POSIX) {
+		return AttachPosix(bCreate);
+	}
+#endif
 #ifdef WIN32
 	int nPerms = FILE_MAP_ALL_ACCESS;
 	if (eMode == READONLY) {
@@ -267,7 +511,8 @@ bool isl::CSHM::Attach(tAccessMode eMode)
 	}
 	int nId = shmget(m_cSHM->nKey, 0, nMode);
 	if (nId == -1) {
-		m_eStatus = ATTACHERROR;
+		// The key file may exist before the memory: not created yet
+		m_eStatus = (errno == ENOENT ? NOTFOUND : ATTACHERROR);
 		m_nError = errno;
 		return false;
 	}
@@ -290,6 +535,15 @@ bool isl::CSHM::Attach(tAccessMode eMode)
 		m_nError = errno;
 		return false;
 	}
+	if (bCreate && (m_eNumaPolicy != NUMA_DEFAULT)) {
+		// The policy is shared by the memory: the pages follow it whoever touches them first.
+		// A huge pages memory is mapped by whole huge pages.
+		size_t nSize = (size_t)m_nSize;
+		if (m_cSHM->bHugePages) {
+			nSize = ((nSize + GetHugePageSize() - 1) / GetHugePageSize()) * GetHugePageSize();
+		}
+		ApplyNumaPolicy(m_pData, nSize);
+	}
 #endif // WIN32
 	return true;
 }
@@ -323,6 +577,9 @@ bool isl::CSHM::Detach()
 	m_nSize = 0;
 	return Close();
 #else
+	if (m_eBackend == POSIX) {
+		return DetachPosix();
+	}
 	if (shmdt(m_pData) == -1) {
 		m_eStatus = DETACHERROR;
 		m_nError = errno;
@@ -372,7 +629,7 @@ bool isl::CSHM::Detach()
 				return false;
 			}
 		}
-		if (boost::filesystem::remove(boost::filesystem::path(m_sName)) == false) {
+		if ((m_uId == 0) && (boost::filesystem::remove(boost::filesystem::path(m_sName)) == false)) {
 			m_eStatus = FILEKEYNOTREMOVED;
 			return false;
 		}
@@ -424,9 +681,17 @@ std::string isl::CSHM::BuildName()
 		sName += isl::CIPCGlobal::Instance()->GetPrefix();
 	}
 #else
-	std::string sName = boost::filesystem::temp_directory_path().string() + "/";
+	std::string sName;
+	if (m_uId == 0) {
+		sName = boost::filesystem::temp_directory_path().string() + "/";
+	}
 #endif
 	sName += m_sPrefix; // Set the prefix
+	if (m_uId != 0) {
+		char sId[16];
+		snprintf(sId, sizeof(sId), "id%08x", m_uId);
+		return sName + sId;
+	}
 	std::string sTmpKey = isl::CString::ToWord(m_sKey);
 	if (sTmpKey.empty()) {
 		m_eStatus = WRONGKEYFORMAT;
@@ -442,8 +707,17 @@ bool isl::CSHM::Init()
 	if (Close() == false) {
 		return false;
 	}
-	m_cSem.SetKey(std::string(), 1);
-	m_cSem.SetKey(m_sKey, 1);
+	// The semaphore is kept between two attempts to attach:
+	// creating it again would remove the one used by the owner of the memory
+	if ((m_cSem.GetKey() != m_sKey) || (m_cSem.GetStatus() != isl::CSem::SUCCESS)) {
+		m_cSem.SetKey(std::string(), 1);
+		if (m_uId != 0) {
+			m_cSem.SetId(m_uId, 1);
+		}
+		else {
+			m_cSem.SetKey(m_sKey, 1);
+		}
+	}
 	if (m_cSem.GetStatus() != isl::CSem::SUCCESS) {
 		m_eStatus = SEMAPHOREERROR;
 		return false;
@@ -494,10 +768,20 @@ bool isl::CSHM::Get()
 		m_cSHM = new tsISLSHMHandle;
 		m_cSHM->nKey = -1;
 		m_cSHM->bFileCreated = false;
+		m_cSHM->nFd = -1;
+		m_cSHM->bHugePages = false;
+	}
+	if (m_eBackend == POSIX) {
+		return GetPosix();
 	}
+	m_cSHM->bHugePages = false;
 	if (m_cSHM->nKey > 0) {
 		return true;
 	}
+	if (m_uId != 0) {
+		m_cSHM->nKey = (key_t)m_uId;
+		return true;
+	}
 	if (boost::filesystem::exists(boost::filesystem::path(m_sName)) == false) {
 		m_eStatus = NOTFOUND;
 		return false;
@@ -565,15 +849,22 @@ bool isl::CSHM::Create()
 		m_cSHM = new tsISLSHMHandle;
 		m_cSHM->nKey = -1;
 		m_cSHM->bFileCreated = false;
+		m_cSHM->nFd = -1;
+		m_cSHM->bHugePages = false;
 	}
-	int nRet = isl::CFileSystem::CreateEmptyFile(m_sName);
-	m_cSHM->bFileCreated = false;
-	if (nRet == -1) {
-		m_eStatus = KEYERROR;
-		return false;
+	if (m_eBackend == POSIX) {
+		return CreatePosix(m_bHugePages);
 	}
-	else if (nRet == 1) {
-		m_cSHM->bFileCreated = true;
+	m_cSHM->bFileCreated = false;
+	if (m_uId == 0) {
+		int nRet = isl::CFileSystem::CreateEmptyFile(m_sName);
+		if (nRet == -1) {
+			m_eStatus = KEYERROR;
+			return false;
+		}
+		else if (nRet == 1) {
+			m_cSHM->bFileCreated = true;
+		}
 	}
 	if (Get() == false) {
 		if (m_cSHM->bFileCreated) {
@@ -582,7 +873,16 @@ bool isl::CSHM::Create()
 		}
 		return false;
 	}
-	if (shmget(m_cSHM->nKey, m_nSize, 0600 | IPC_CREAT | IPC_EXCL) == -1) {
+	int nFlags = 0600 | IPC_CREAT | IPC_EXCL;
+	if (m_bHugePages && ((size_t)m_nSize >= GetHugePageSize())) {
+		// Needs huge pages reserved (vm.nr_hugepages) and the rights (vm.hugetlb_shm_group),
+		// otherwise the regular memory is used
+		if (shmget(m_cSHM->nKey, m_nSize, nFlags | SHM_HUGETLB) != -1) {
+			m_cSHM->bHugePages = true;
+			return true;
+		}
+	}
+	if (shmget(m_cSHM->nKey, m_nSize, nFlags) == -1) {
 		m_eStatus = UNKNOWN;
 		m_nError = errno;
 		switch (m_nError) {
@@ -633,7 +933,237 @@ bool isl::CSHM::Close()
 	if (m_cSHM != 0) {
 		m_cSHM->nKey = 0;
 		m_cSHM->bFileCreated = false;
+		if (m_cSHM->nFd != -1) {
+			close(m_cSHM->nFd);
+			m_cSHM->nFd = -1;
+		}
 	}
 #endif // WIN32
 	return true;
-}
\ No newline at end of file
+}
+
+#ifndef WIN32
+bool isl::CSHM::ApplyNumaPolicy(void * pAddr, size_t nSize)
+{
+	const size_t nMaxNodes = 1024;
+	const size_t nBits = 8 * sizeof(unsigned long);
+	unsigned long lMask[nMaxNodes / (8 * sizeof(unsigned long))];
+	memset(lMask, 0, sizeof(lMask));
+	int nMode = MPOL_BIND;
+	if (m_eNumaPolicy == NUMA_INTERLEAVE) {
+		nMode = MPOL_INTERLEAVE;
+		if (GetOnlineNumaNodes(lMask, nMaxNodes) == false) {
+			m_nError = ENOENT;
+			return false;
+		}
+	}
+	else {
+		if ((m_nNumaNode < 0) || ((size_t)m_nNumaNode >= nMaxNodes)) {
+			m_nError = EINVAL;
+			return false;
+		}
+		lMask[m_nNumaNode / nBits] |= 1UL << (m_nNumaNode % nBits);
+	}
+	if (syscall(SYS_mbind, pAddr, nSize, nMode, lMask, nMaxNodes, 0) != 0) {
+		m_nError = errno;
+		return false;
+	}
+	m_bNumaApplied = true;
+	return true;
+}
+
+std::string isl::CSHM::BuildPosixName(bool bHugePages)
+{
+	// Same name as the key file of SysV, without its directory
+	std::string sName = "/" + boost::filesystem::path(m_sName).filename().string();
+	if (bHugePages) {
+		return c_sHugePagesDir + sName;
+	}
+	return sName;
+}
+
+bool isl::CSHM::CreatePosix(bool bHugePages)
+{
+	m_cSHM->bHugePages = false;
+	size_t nMapSize = SHM_POSIX_HEADER_SIZE + (size_t)m_nSize;
+	int nFd = -1;
+	if (bHugePages) {
+		std::string sPath = BuildPosixName(true);
+		nFd = open(sPath.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+		if (nFd != -1) {
+			struct statfs stFS;
+			// Small memories stay on regular pages: a huge page would be mostly unused
+			if ((fstatfs(nFd, &stFS) == 0) && (stFS.f_type == HUGETLBFS_MAGIC)
+				&& (nMapSize >= (size_t)stFS.f_bsize)) {
+				// The size must be a multiple of the huge page size
+				size_t nPageSize = (size_t)stFS.f_bsize;
+				nMapSize = ((nMapSize + nPageSize - 1) / nPageSize) * nPageSize;
+				m_cSHM->bHugePages = true;
+			}
+			else {
+				close(nFd);
+				unlink(sPath.c_str());
+				nFd = -1;
+			}
+		}
+		else if (errno == EEXIST) {
+			m_eStatus = ALREADYEXISTS;
+			m_nError = errno;
+			return false;
+		}
+		// Without hugetlbfs, the regular memory is used
+	}
+	if (nFd == -1) {
+		nFd = shm_open(BuildPosixName(false).c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+		if (nFd == -1) {
+			m_nError = errno;
+			m_eStatus = GetStatusFromErrno(m_nError);
+			return false;
+		}
+	}
+	if (ftruncate(nFd, (off_t)nMapSize) == -1) {
+		m_nError = errno;
+		m_eStatus = GetStatusFromErrno(m_nError);
+		close(nFd);
+		if (m_cSHM->bHugePages) {
+			unlink(BuildPosixName(true).c_str());
+		}
+		else {
+			shm_unlink(BuildPosixName(false).c_str());
+		}
+		m_cSHM->bHugePages = false;
+		return false;
+	}
+	m_cSHM->nFd = nFd;
+	return true;
+}
+
+bool isl::CSHM::GetPosix()
+{
+	if (m_cSHM->nFd != -1) {
+		return true;
+	}
+	// The creator decides of the huge pages
+	m_cSHM->bHugePages = false;
+	int nFd = shm_open(BuildPosixName(false).c_str(), O_RDWR, 0600);
+	if ((nFd == -1) && (errno == ENOENT)) {
+		nFd = open(BuildPosixName(true).c_str(), O_RDWR | O_CLOEXEC);
+		m_cSHM->bHugePages = (nFd != -1);
+	}
+	if (nFd == -1) {
+		m_nError = errno;
+		m_eStatus = GetStatusFromErrno(m_nError);
+		return false;
+	}
+	m_cSHM->nFd = nFd;
+	return true;
+}
+
+bool isl::CSHM::AttachPosix(bool bCreate)
+{
+	if ((m_cSHM == 0) || (m_cSHM->nFd == -1)) {
+		return false;
+	}
+	struct stat stStats;
+	if (fstat(m_cSHM->nFd, &stStats) == -1) {
+		m_eStatus = GETSIZEERROR;
+		m_nError = errno;
+		Close();
+		return false;
+	}
+	size_t nMapSize = (size_t)stStats.st_size;
+	if (nMapSize < SHM_POSIX_HEADER_SIZE) {
+		m_eStatus = GETSIZEERROR;
+		Close();
+		return false;
+	}
+	// The memory is mapped in read/write mode whatever the access mode: the header is updated.
+	// The pages are populated now rather than faulted in during the simulation,
+	// after the NUMA policy is set if any.
+	bool bPlace = (bCreate && (m_eNumaPolicy != NUMA_DEFAULT));
+	int nFlags = MAP_SHARED;
+#ifdef MAP_POPULATE
+	if (bPlace == false) {
+		nFlags |= MAP_POPULATE;
+	}
+#endif
+	void * pBase = mmap(0, nMapSize, PROT_READ | PROT_WRITE, nFlags, m_cSHM->nFd, 0);
+	if (pBase == MAP_FAILED) {
+		m_nError = errno;
+		Close();
+		if (bCreate && m_cSHM->bHugePages) {
+			// Not enough huge pages available: use the regular memory
+			unlink(BuildPosixName(true).c_str());
+			if (CreatePosix(false)) {
+				return AttachPosix(true);
+			}
+			return false;
+		}
+		m_eStatus = ATTACHERROR;
+		return false;
+	}
+	Close();
+#ifdef MADV_HUGEPAGE
+	if (m_bHugePages && (m_cSHM->bHugePages == false)) {
+		// Transparent huge pages, if enabled for the shared memories
+		madvise(pBase, nMapSize, MADV_HUGEPAGE);
+	}
+#endif
+	if (bPlace) {
+		ApplyNumaPolicy(pBase, nMapSize);
+		size_t nPageSize = (m_cSHM->bHugePages ? GetHugePageSize() : (size_t)sysconf(_SC_PAGESIZE));
+		for (size_t i = 0; i < nMapSize; i += nPageSize) {
+			((volatile char *)pBase)[i] = 0;
+		}
+	}
+	tsISLSHMHeader * pHeader = (tsISLSHMHeader *)pBase;
+	if (bCreate) {
+		pHeader->uMagic = SHM_POSIX_MAGIC;
+		pHeader->nAttached = 0;
+		pHeader->nSize = m_nSize;
+	}
+	else if (pHeader->uMagic != SHM_POSIX_MAGIC) {
+		munmap(pBase, nMapSize);
+		m_eStatus = ATTACHERROR;
+		return false;
+	}
+	pHeader->nAttached++;
+	m_pBase = pBase;
+	m_nMapSize = nMapSize;
+	m_nSize = pHeader->nSize;
+	m_pData = (char *)pBase + SHM_POSIX_HEADER_SIZE;
+	return true;
+}
+
+bool isl::CSHM::DetachPosix()
+{
+	tsISLSHMHeader * pHeader = (tsISLSHMHeader *)m_pBase;
+	int nAttached = --pHeader->nAttached;
+	if (munmap(m_pBase, m_nMapSize) == -1) {
+		m_eStatus = DETACHERROR;
+		m_nError = errno;
+		return false;
+	}
+	m_pBase = 0;
+	m_nMapSize = 0;
+	m_pData = 0;
+	m_nSize = 0;
+	Close();
+	if (nAttached > 0) {
+		return true;
+	}
+	int nRet = 0;
+	if (m_cSHM->bHugePages) {
+		nRet = unlink(BuildPosixName(true).c_str());
+	}
+	else {
+		nRet = shm_unlink(BuildPosixName(false).c_str());
+	}
+	if ((nRet == -1) && (errno != ENOENT)) {
+		m_eStatus = REMOVEERROR;
+		m_nError = errno;
+		return false;
+	}
+	return true;
+}
+#endif // WIN32
\ No newline at end of file
@@ -50,6 +50,16 @@ void isl::CThread::Sleep(unsigned long ulMilliSec)
 	boost::this_thread::sleep_for(boost::chrono::milliseconds(ulMilliSec));
 }
 
+void isl::CThread::Reschedule()
+{
+	boost::this_thread::yield();
+}
+
+unsigned int isl::CThread::GetNbCores()
+{
+	return boost::thread::hardware_concurrency();
+}
+
 isl::CThread::CThread()
 {
 	m_eStatus = isl::CThread::THREAD_IDLE;
@@ -92,3 +102,91 @@ void isl::CThread::Interrupt()
 }
 
 
+
+isl::CThreadPool::CThreadPool(unsigned int uNbThreads)
+{
+	m_uNbThreads = (uNbThreads == 0 ? CThread::GetNbCores() : uNbThreads);
+	if (m_uNbThreads == 0) {
+		m_uNbThreads = 1;
+	}
+	m_fTask = 0;
+	m_nCount = 0;
+	m_nNext = 0;
+	m_nDone = 0;
+	m_uBatch = 0;
+	m_bStop = false;
+	// The calling thread is one of them
+	for (unsigned int i = 1; i < m_uNbThreads; i++) {
+		m_cThreads.add_thread(new boost::thread(&isl::CThreadPool::Work, this));
+	}
+}
+
+isl::CThreadPool::~CThreadPool()
+{
+	{
+		boost::mutex::scoped_lock cLock(m_cLock);
+		m_bStop = true;
+	}
+	m_cStart.notify_all();
+	m_cThreads.join_all();
+}
+
+void isl::CThreadPool::Run(size_t nCount, const boost::function<void(size_t)> & fTask)
+{
+	if (nCount == 0) {
+		return;
+	}
+	if (m_uNbThreads == 1) {
+		for (size_t i = 0; i < nCount; i++) {
+			fTask(i);
+		}
+		return;
+	}
+	boost::mutex::scoped_lock cLock(m_cLock);
+	m_fTask = &fTask;
+	m_nCount = nCount;
+	m_nNext = 0;
+	m_nDone = 0;
+	m_uBatch++;
+	m_cStart.notify_all();
+	cLock.unlock();
+	RunTasks();
+	cLock.lock();
+	while (m_nDone < m_nCount) {
+		m_cDone.wait(cLock);
+	}
+	m_fTask = 0;
+}
+
+void isl::CThreadPool::Work()
+{
+	unsigned int uBatch = 0;
+	while (true) {
+		{
+			boost::mutex::scoped_lock cLock(m_cLock);
+			while ((m_bStop == false) && (m_uBatch == uBatch)) {
+				m_cStart.wait(cLock);
+			}
+			if (m_bStop) {
+				return;
+			}
+			uBatch = m_uBatch;
+		}
+		RunTasks();
+	}
+}
+
+void isl::CThreadPool::RunTasks()
+{
+	boost::mutex::scoped_lock cLock(m_cLock);
+	while (m_nNext < m_nCount) {
+		size_t i = m_nNext++;
+		const boost::function<void(size_t)> * fTask = m_fTask;
+		cLock.unlock();
+		(*fTask)(i);
+		cLock.lock();
+		if (++m_nDone == m_nCount) {
+			m_cDone.notify_all();
+		}
+	}
+}
@@ -0,0 +1,13 @@
+@echo off
+set OPENISL_PATH=%~dp0..\..
+set PATH=%OPENISL_PATH%\bin\x64;%PATH%
+
+del /F x64\ping.log 2> NUL
+del /F x64\pong.log 2> NUL
+
+start "" /D x64 latency.exe --pong %*
+start "" /D x64 /WAIT latency.exe %*
+
+find "Round trips" x64\ping.log
+
+pause
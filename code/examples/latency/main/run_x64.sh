@@ -0,0 +1,14 @@
+#! /bin/bash
+
+ROOT_PATH=`pwd`
+LD_LIBRARY_PATH="$ROOT_PATH/../../bin/x64:$LD_LIBRARY_PATH"
+export LD_LIBRARY_PATH
+
+cd x64
+rm -f ping.log pong.log 2> /dev/null
+./latency --pong "$@" &
+./latency "$@"
+wait
+cd ..
+
+grep "Round trips" x64/ping.log
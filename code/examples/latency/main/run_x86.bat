@@ -0,0 +1,13 @@
+@echo off
+set OPENISL_PATH=%~dp0..\..
+set PATH=%OPENISL_PATH%\bin\x86;%PATH%
+
+del /F x86\ping.log 2> NUL
+del /F x86\pong.log 2> NUL
+
+start "" /D x86 latency.exe --pong %*
+start "" /D x86 /WAIT latency.exe %*
+
+find "Round trips" x86\ping.log
+
+pause
@@ -0,0 +1,243 @@
+/*
+ *     Name: main.cpp
+ *
+ *     Description: latency: Round-trip latency benchmark of the blocking data exchange.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+/*
+ *     Header files
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <isl_api.h>
+
+#include "swversion.h"
+
+
+/*
+ *     Macros and constants definition
+ */
+
+namespace bpo = boost::program_options;
+const char c_Session[] = "isllatency";
+
+
+/*
+ *     Types definition
+ */
+
+typedef struct {
+	bool m_bPong;
+	bool m_bFutex;
+	bool m_bLockFree;
+	std::string m_sWaitPolicy;
+	int m_nSteps;
+} tCmdLine;
+
+
+/*
+ *     Local functions
+ */
+
+static bool GetCmdLine(int argc, char** argv, tCmdLine * stCmdLine)
+{
+	if (stCmdLine == NULL) {
+		return false;
+	}
+	bpo::options_description bpDesc("Allowed options");
+	bpDesc.add_options()
+		("version,v", "print version number")
+		("help,h", "print help message")
+		("pong,p", "Run the echoing side of the benchmark")
+		("steps,n", bpo::value<int>()->default_value(10000), "Number of round trips")
+		("futex,f", "Wait on futexes instead of semaphores (Linux only)")
+		("lockfree,l", "Use the lock-free FIFO mode")
+		("wait,w", bpo::value<std::string>()->default_value(""), "Wait policy: block, spin, spinpause or busypoll");
+	bpo::variables_map bpVars;
+	try {
+		bpo::store(bpo::parse_command_line(argc, argv, bpDesc), bpVars);
+		bpo::notify(bpVars);
+	}
+	catch (bpo::error & bpErr)
+	{
+		std::ostringstream osMsg;
+		osMsg << "Error: " << bpErr.what() << std::endl << std::endl;
+		osMsg << bpDesc;
+		ISLLogError(300, "Command line error: %s", osMsg.str().c_str());
+		return false;
+	}
+	// Help
+	if (bpVars.count("help")) {
+		std::ostringstream osMsg;
+		osMsg << bpDesc;
+		ISLLogInfo(100, "Command line description:\n%s", osMsg.str().c_str());
+		return false; // No need to go further
+	}
+	// Print version
+	if (bpVars.count("version")) {
+		ISLLogInfo(101, APP_NAME" version: " GET_APP_VERSION(FULL_VERSION_NUMBER));
+		return false; // No need to go further
+	}
+	stCmdLine->m_bPong = (bpVars.count("pong") != 0);
+	stCmdLine->m_bFutex = (bpVars.count("futex") != 0);
+	stCmdLine->m_bLockFree = (bpVars.count("lockfree") != 0);
+	stCmdLine->m_sWaitPolicy = bpVars["wait"].as<std::string>();
+	stCmdLine->m_nSteps = bpVars["steps"].as<int>();
+	if (stCmdLine->m_nSteps <= 0) {
+		ISLLogError(302, "The number of steps shall be positive.");
+		return false;
+	}
+	return true;
+}
+
+static double GetPercentile(const std::vector<double> & lSamples, double dRatio)
+{
+	size_t nInd = (size_t )(dRatio * (double )(lSamples.size() - 1));
+	return lSamples[nInd];
+}
+
+
+/*
+ *     Main function
+ */
+
+int main(int argc, char *argv[])
+{
+	//
+	// Get the command line
+	tCmdLine stCmdLine;
+	if (GetCmdLine(argc, argv, &stCmdLine) == false)  {
+		return -9;
+	}
+	//
+	// Initialize ISL
+	isl::CConnect cConnect;
+	cConnect.CloseLogOnDelete(true);
+	//
+	// Connector definition: the ping side writes Ping and reads Pong, the pong side echoes
+	if (cConnect.New(stCmdLine.m_bPong ? "pong" : "ping") == false) {
+		ISLLogError(301, "Failed to create the connector.");
+		return -1;
+	}
+	cConnect.SetEndTime((double )stCmdLine.m_nSteps);
+	cConnect.SetStepSize(1.0);
+	cConnect.SetFutex(stCmdLine.m_bFutex);
+	cConnect.SetLockFree(stCmdLine.m_bLockFree);
+	if (stCmdLine.m_sWaitPolicy.empty() == false) {
+		cConnect.SetWaitPolicy(isl::CVariable::GetWaitPolicyFromStr(stCmdLine.m_sWaitPolicy));
+	}
+	isl::CData * cOutput = cConnect.NewIO(stCmdLine.m_bPong ? "PongW" : "PingW",
+		isl::CVariable::CS_OUTPUT, isl::CDataType::TP_REAL, 1);
+	isl::CData * cInput = cConnect.NewIO(stCmdLine.m_bPong ? "PingR" : "PongR",
+		isl::CVariable::CS_INPUT, isl::CDataType::TP_REAL, 1);
+	if ((cOutput == 0) || (cInput == 0)) {
+		ISLLogError(304, "Failed to define the ISL variables.");
+		return -4;
+	}
+	cOutput->SetConnectId(stCmdLine.m_bPong ? "L101" : "L100");
+	cInput->SetConnectId(stCmdLine.m_bPong ? "L100" : "L101");
+	//
+	// Session setup
+	if (cConnect.Create(c_Session) == false) {
+		ISLLogError(303, "Failed to setup the OpenISL session %s.", c_Session);
+		return -3;
+	}
+	ISLLogInfo(105, "The session %s has been setup.", cConnect.GetSessionId().c_str());
+	//
+	// ISL connection
+	if (cConnect.Connect(true) == false) {
+		ISLLogError(309, "Failed to connect the inputs to ISL transmitters.");
+		return -10;
+	}
+	ISLLogInfo(110, "Connected to the transmitters (futex: %s, lock-free: %s, wait policy: %s).",
+		cConnect.IsFutex() ? "yes" : "no", cConnect.IsLockFree() ? "yes" : "no",
+		isl::CVariable::GetWaitPolicyStr(cConnect.GetWaitPolicy()).c_str());
+	//
+	// Exchange loop
+	std::vector<double> lSamples;
+	lSamples.reserve(stCmdLine.m_nSteps + 1);
+	double dTime = cConnect.GetStartTime();
+	double dStepSize = cConnect.GetStepSize();
+	double dEndTime = cConnect.GetEndTime();
+	double dValue = 0.0;
+	double dGivenTime;
+	while ((cConnect.IsTerminated() == false) && (dTime <= dEndTime)) {
+		if (stCmdLine.m_bPong) {
+			if (cInput->GetData(&dValue, &dGivenTime, dTime, true) == false) {
+				ISLLogWarning(202, "Failed to get data on PingR[%g].", dTime);
+			}
+			if (cOutput->SetData(&dValue, dTime, true) == false) {
+				ISLLogWarning(200, "Failed to set data on PongW[%g].", dTime);
+			}
+		}
+		else {
+			std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+			dValue = dTime;
+			if (cOutput->SetData(&dValue, dTime, true) == false) {
+				ISLLogWarning(200, "Failed to set data on PingW[%g].", dTime);
+			}
+			if (cInput->GetData(&dValue, &dGivenTime, dTime, true) == false) {
+				ISLLogWarning(202, "Failed to get data on PongR[%g].", dTime);
+			}
+			std::chrono::steady_clock::time_point tpEnd = std::chrono::steady_clock::now();
+			lSamples.push_back(std::chrono::duration<double, std::micro>(tpEnd - tpStart).count());
+		}
+		// Time increment
+		dTime += dStepSize;
+	}
+	//
+	// Results
+	if (lSamples.empty() == false) {
+		double dSum = 0.0;
+		for (size_t i = 0; i < lSamples.size(); i++) {
+			dSum += lSamples[i];
+		}
+		std::sort(lSamples.begin(), lSamples.end());
+		ISLLogInfo(111, "Round trips: %d, mean: %.2fus, p50: %.2fus, p99: %.2fus, max: %.2fus",
+			(int )lSamples.size(), dSum / (double )lSamples.size(), GetPercentile(lSamples, 0.50),
+			GetPercentile(lSamples, 0.99), lSamples.back());
+	}
+	//
+	// Closing the connection
+	if (cConnect.Disconnect() == false) {
+		ISLLogError(308, "Failed to disconnect from the ISL session.");
+		return -8;
+	}
+	//
+	//
+	return 0;
+}
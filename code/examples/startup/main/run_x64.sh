@@ -0,0 +1,14 @@
+#! /bin/bash
+
+ROOT_PATH=`pwd`
+LD_LIBRARY_PATH="$ROOT_PATH/../../bin/x64:$LD_LIBRARY_PATH"
+export LD_LIBRARY_PATH
+
+cd x64
+rm -f producer.log consumer.log 2> /dev/null
+./startup "$@" &
+./startup --consumer "$@"
+wait
+cd ..
+
+grep "Variables" x64/producer.log x64/consumer.log
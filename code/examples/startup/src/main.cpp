@@ -0,0 +1,224 @@
+/*
+ *     Name: main.cpp
+ *
+ *     Description: startup: Startup time of a session with a large number of variables.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+/*
+ *     Header files
+ */
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <isl_api.h>
+
+#include "swversion.h"
+
+
+/*
+ *     Macros and constants definition
+ */
+
+namespace bpo = boost::program_options;
+const char c_Session[] = "islstartup";
+
+
+/*
+ *     Types definition
+ */
+
+typedef struct {
+	bool m_bConsumer;
+	bool m_bFutex;
+	int m_nVariables;
+	int m_nThreads;
+} tCmdLine;
+
+
+/*
+ *     Local functions
+ */
+
+static bool GetCmdLine(int argc, char** argv, tCmdLine * stCmdLine)
+{
+	if (stCmdLine == NULL) {
+		return false;
+	}
+	bpo::options_description bpDesc("Allowed options");
+	bpDesc.add_options()
+		("version,v", "print version number")
+		("help,h", "print help message")
+		("consumer,c", "Run the reading side of the benchmark")
+		("variables,n", bpo::value<int>()->default_value(10000), "Number of variables")
+		("threads,t", bpo::value<int>()->default_value(-1),
+			"Threads connecting the variables: 0 for the number of cores, 1 for none (default: isl_api.ini)")
+		("futex,f", "Wait on futexes instead of semaphores (Linux only)");
+	bpo::variables_map bpVars;
+	try {
+		bpo::store(bpo::parse_command_line(argc, argv, bpDesc), bpVars);
+		bpo::notify(bpVars);
+	}
+	catch (bpo::error & bpErr)
+	{
+		std::ostringstream osMsg;
+		osMsg << "Error: " << bpErr.what() << std::endl << std::endl;
+		osMsg << bpDesc;
+		ISLLogError(300, "Command line error: %s", osMsg.str().c_str());
+		return false;
+	}
+	// Help
+	if (bpVars.count("help")) {
+		std::ostringstream osMsg;
+		osMsg << bpDesc;
+		ISLLogInfo(100, "Command line description:\n%s", osMsg.str().c_str());
+		return false; // No need to go further
+	}
+	// Print version
+	if (bpVars.count("version")) {
+		ISLLogInfo(101, APP_NAME" version: " GET_APP_VERSION(FULL_VERSION_NUMBER));
+		return false; // No need to go further
+	}
+	stCmdLine->m_bConsumer = (bpVars.count("consumer") != 0);
+	stCmdLine->m_bFutex = (bpVars.count("futex") != 0);
+	stCmdLine->m_nVariables = bpVars["variables"].as<int>();
+	stCmdLine->m_nThreads = bpVars["threads"].as<int>();
+	if (stCmdLine->m_nVariables <= 0) {
+		ISLLogError(302, "The number of variables shall be positive.");
+		return false;
+	}
+	return true;
+}
+
+static double GetElapsed(const std::chrono::steady_clock::time_point & tpStart)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tpStart).count();
+}
+
+
+/*
+ *     Main function
+ */
+
+int main(int argc, char *argv[])
+{
+	//
+	// Get the command line
+	tCmdLine stCmdLine;
+	if (GetCmdLine(argc, argv, &stCmdLine) == false)  {
+		return -9;
+	}
+	//
+	// Initialize ISL
+	isl::CConnect cConnect;
+	cConnect.CloseLogOnDelete(true);
+	//
+	// Connector definition: the producer writes the variables, the consumer reads them.
+	// The consumer tells the producer when all of them are attached.
+	if (cConnect.New(stCmdLine.m_bConsumer ? "consumer" : "producer") == false) {
+		ISLLogError(301, "Failed to create the connector.");
+		return -1;
+	}
+	cConnect.SetFutex(stCmdLine.m_bFutex);
+	if (stCmdLine.m_nThreads >= 0) {
+		cConnect.SetConnectThreads((unsigned int)stCmdLine.m_nThreads);
+	}
+	for (int i = 0; i < stCmdLine.m_nVariables; i++) {
+		isl::CData * cIO = cConnect.NewIO(boost::str(boost::format("%1%%2%") %
+			(stCmdLine.m_bConsumer ? "VarR" : "VarW") % i),
+			stCmdLine.m_bConsumer ? isl::CVariable::CS_INPUT : isl::CVariable::CS_OUTPUT,
+			isl::CDataType::TP_REAL, 1);
+		if (cIO == 0) {
+			ISLLogError(304, "Failed to define the ISL variables.");
+			return -4;
+		}
+		cIO->SetConnectId(boost::str(boost::format("V%1%") % i));
+	}
+	isl::CData * cDone = cConnect.NewIO(stCmdLine.m_bConsumer ? "DoneW" : "DoneR",
+		stCmdLine.m_bConsumer ? isl::CVariable::CS_OUTPUT : isl::CVariable::CS_INPUT,
+		isl::CDataType::TP_REAL, 1);
+	if (cDone == 0) {
+		ISLLogError(304, "Failed to define the ISL variables.");
+		return -4;
+	}
+	cDone->SetConnectId("D0");
+	// Checked before the measure
+	if (cConnect.Check() == false) {
+		ISLLogError(305, "The definition of the connector is not valid.");
+		return -5;
+	}
+	//
+	// Session setup: the outputs are created
+	std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+	if (cConnect.Create(c_Session) == false) {
+		ISLLogError(303, "Failed to setup the OpenISL session %s.", c_Session);
+		return -3;
+	}
+	double dCreate = GetElapsed(tpStart);
+	ISLLogInfo(105, "The session %s has been setup.", cConnect.GetSessionId().c_str());
+	//
+	// ISL connection: the inputs are attached
+	tpStart = std::chrono::steady_clock::now();
+	if (cConnect.Connect(true) == false) {
+		ISLLogError(309, "Failed to connect the inputs to ISL transmitters.");
+		return -10;
+	}
+	double dConnect = GetElapsed(tpStart);
+	ISLLogInfo(110, "Variables: %d, threads: %d, create: %.1fms, connect: %.1fms",
+		stCmdLine.m_nVariables, (int)cConnect.GetConnectThreads(), dCreate, dConnect);
+	//
+	// Synchronization before closing the session
+	double dVal = 1.0;
+	double dTime = 0.0;
+	if (stCmdLine.m_bConsumer) {
+		if (cDone->SetData(&dVal, 0.0, true) == false) {
+			ISLLogWarning(200, "Failed to set data on DoneW.");
+		}
+	}
+	else {
+		if (cDone->GetData(&dVal, &dTime, true) == false) {
+			ISLLogWarning(202, "Failed to get data on DoneR.");
+		}
+	}
+	//
+	// Closing the connection
+	if (cConnect.Disconnect() == false) {
+		ISLLogError(308, "Failed to disconnect from the ISL session.");
+		return -8;
+	}
+	//
+	//
+	return 0;
+}
@@ -0,0 +1,13 @@
+@echo off
+set OPENISL_PATH=%~dp0..\..
+set PATH=%OPENISL_PATH%\bin\x64;%PATH%
+
+del /F x64\producer.log 2> NUL
+del /F x64\consumer.log 2> NUL
+
+start "" /D x64 throughput.exe %*
+start "" /D x64 /WAIT throughput.exe --consumer %*
+
+find "Samples" x64\consumer.log
+
+pause
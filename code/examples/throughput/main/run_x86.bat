@@ -0,0 +1,13 @@
+@echo off
+set OPENISL_PATH=%~dp0..\..
+set PATH=%OPENISL_PATH%\bin\x86;%PATH%
+
+del /F x86\producer.log 2> NUL
+del /F x86\consumer.log 2> NUL
+
+start "" /D x86 throughput.exe %*
+start "" /D x86 /WAIT throughput.exe --consumer %*
+
+find "Samples" x86\consumer.log
+
+pause
@@ -0,0 +1,14 @@
+#! /bin/bash
+
+ROOT_PATH=`pwd`
+LD_LIBRARY_PATH="$ROOT_PATH/../../bin/x86:$LD_LIBRARY_PATH"
+export LD_LIBRARY_PATH
+
+cd x86
+rm -f producer.log consumer.log 2> /dev/null
+./throughput "$@" &
+./throughput --consumer "$@"
+wait
+cd ..
+
+grep "Samples" x86/consumer.log
@@ -0,0 +1,264 @@
+/*
+ *     Name: main.cpp
+ *
+ *     Description: throughput: Throughput benchmark of a sample stream, written by batches.
+ *
+ *     Author: T. Roudier
+ *     Copyright (c) 2019-2025 E-Sim Solutions Inc
+ *
+ *     Distributed under the MIT License.
+ * 
+ *     --------------------------------------------------------------------------
+ * 
+ *     Permission is hereby granted, free of charge, to any person obtaining a
+ *     copy of this software and associated documentation files (the “Software”),
+ *     to deal in the Software without restriction, including without limitation
+ *     the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ *     and/or sell copies of the Software, and to permit persons to whom the
+ *     Software is furnished to do so, subject to the following conditions:
+ *
+ *     The above copyright notice and this permission notice shall be included in
+ *     all copies or substantial portions of the Software.
+ *
+ *     THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *     IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *     FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ *     THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *     LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ *     FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ *     DEALINGS IN THE SOFTWARE.
+ * 
+ *     --------------------------------------------------------------------------
+ *
+ */
+
+/*
+ *     Header files
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+#include <isl_api.h>
+
+#include "swversion.h"
+
+
+/*
+ *     Macros and constants definition
+ */
+
+namespace bpo = boost::program_options;
+const char c_Session[] = "islthroughput";
+
+
+/*
+ *     Types definition
+ */
+
+typedef struct {
+	bool m_bConsumer;
+	bool m_bFutex;
+	bool m_bLockFree;
+	std::string m_sWaitPolicy;
+	int m_nSamples;
+	int m_nBatch;
+} tCmdLine;
+
+
+/*
+ *     Local functions
+ */
+
+static bool GetCmdLine(int argc, char** argv, tCmdLine * stCmdLine)
+{
+	if (stCmdLine == NULL) {
+		return false;
+	}
+	bpo::options_description bpDesc("Allowed options");
+	bpDesc.add_options()
+		("version,v", "print version number")
+		("help,h", "print help message")
+		("consumer,c", "Run the reading side of the benchmark")
+		("samples,n", bpo::value<int>()->default_value(1000000), "Number of samples")
+		("batch,b", bpo::value<int>()->default_value(1), "Number of samples written or read at once")
+		("futex,f", "Wait on futexes instead of semaphores (Linux only)")
+		("lockfree,l", "Use the lock-free FIFO mode")
+		("wait,w", bpo::value<std::string>()->default_value(""), "Wait policy: block, spin, spinpause or busypoll");
+	bpo::variables_map bpVars;
+	try {
+		bpo::store(bpo::parse_command_line(argc, argv, bpDesc), bpVars);
+		bpo::notify(bpVars);
+	}
+	catch (bpo::error & bpErr)
+	{
+		std::ostringstream osMsg;
+		osMsg << "Error: " << bpErr.what() << std::endl << std::endl;
+		osMsg << bpDesc;
+		ISLLogError(300, "Command line error: %s", osMsg.str().c_str());
+		return false;
+	}
+	// Help
+	if (bpVars.count("help")) {
+		std::ostringstream osMsg;
+		osMsg << bpDesc;
+		ISLLogInfo(100, "Command line description:\n%s", osMsg.str().c_str());
+		return false; // No need to go further
+	}
+	// Print version
+	if (bpVars.count("version")) {
+		ISLLogInfo(101, APP_NAME" version: " GET_APP_VERSION(FULL_VERSION_NUMBER));
+		return false; // No need to go further
+	}
+	stCmdLine->m_bConsumer = (bpVars.count("consumer") != 0);
+	stCmdLine->m_bFutex = (bpVars.count("futex") != 0);
+	stCmdLine->m_bLockFree = (bpVars.count("lockfree") != 0);
+	stCmdLine->m_sWaitPolicy = bpVars["wait"].as<std::string>();
+	stCmdLine->m_nSamples = bpVars["samples"].as<int>();
+	stCmdLine->m_nBatch = bpVars["batch"].as<int>();
+	if ((stCmdLine->m_nSamples <= 0) || (stCmdLine->m_nBatch <= 0)) {
+		ISLLogError(302, "The number of samples and the batch size shall be positive.");
+		return false;
+	}
+	return true;
+}
+
+static int Produce(isl::CData * cOutput, const tCmdLine & stCmdLine)
+{
+	std::vector<double> lValues(stCmdLine.m_nBatch);
+	std::vector<double> lTimes(stCmdLine.m_nBatch);
+	int nSent = 0;
+	while (nSent < stCmdLine.m_nSamples) {
+		int nCount = std::min(stCmdLine.m_nBatch, stCmdLine.m_nSamples - nSent);
+		for (int i = 0; i < nCount; i++) {
+			lValues[i] = (double )(nSent + i);
+			lTimes[i] = (double )(nSent + i);
+		}
+		int nSet = 0;
+		if (stCmdLine.m_nBatch == 1) {
+			nSet = (cOutput->SetData(&lValues[0], lTimes[0], true) ? 1 : 0);
+		}
+		else {
+			nSet = cOutput->SetDataBatch(&lValues[0], &lTimes[0], NULL, nCount, true);
+		}
+		if (nSet != nCount) {
+			ISLLogWarning(200, "Failed to set data on StreamW[%d].", nSent);
+			break;
+		}
+		nSent += nCount;
+	}
+	return nSent;
+}
+
+static int Consume(isl::CData * cInput, const tCmdLine & stCmdLine, int * nErrors)
+{
+	std::vector<double> lValues(stCmdLine.m_nBatch);
+	std::vector<double> lTimes(stCmdLine.m_nBatch);
+	int nReceived = 0;
+	while (nReceived < stCmdLine.m_nSamples) {
+		int nGet = 0;
+		if (stCmdLine.m_nBatch == 1) {
+			nGet = (cInput->GetData(&lValues[0], &lTimes[0], true) ? 1 : 0);
+		}
+		else {
+			nGet = cInput->GetDataBatch(&lValues[0], &lTimes[0], NULL, stCmdLine.m_nBatch, true);
+		}
+		if (nGet <= 0) {
+			ISLLogWarning(202, "Failed to get data on StreamR[%d].", nReceived);
+			break;
+		}
+		for (int i = 0; i < nGet; i++) {
+			if (lValues[i] != (double )(nReceived + i)) {
+				(*nErrors)++;
+			}
+		}
+		nReceived += nGet;
+	}
+	return nReceived;
+}
+
+
+/*
+ *     Main function
+ */
+
+int main(int argc, char *argv[])
+{
+	//
+	// Get the command line
+	tCmdLine stCmdLine;
+	if (GetCmdLine(argc, argv, &stCmdLine) == false)  {
+		return -9;
+	}
+	//
+	// Initialize ISL
+	isl::CConnect cConnect;
+	cConnect.CloseLogOnDelete(true);
+	//
+	// Connector definition: the producer writes the stream, the consumer reads it
+	if (cConnect.New(stCmdLine.m_bConsumer ? "consumer" : "producer") == false) {
+		ISLLogError(301, "Failed to create the connector.");
+		return -1;
+	}
+	cConnect.SetEndTime((double )stCmdLine.m_nSamples);
+	cConnect.SetStepSize(1.0);
+	cConnect.SetFutex(stCmdLine.m_bFutex);
+	cConnect.SetLockFree(stCmdLine.m_bLockFree);
+	if (stCmdLine.m_sWaitPolicy.empty() == false) {
+		cConnect.SetWaitPolicy(isl::CVariable::GetWaitPolicyFromStr(stCmdLine.m_sWaitPolicy));
+	}
+	isl::CData * cIO = cConnect.NewIO(stCmdLine.m_bConsumer ? "StreamR" : "StreamW",
+		stCmdLine.m_bConsumer ? isl::CVariable::CS_INPUT : isl::CVariable::CS_OUTPUT,
+		isl::CDataType::TP_REAL, 1);
+	if (cIO == 0) {
+		ISLLogError(304, "Failed to define the ISL variables.");
+		return -4;
+	}
+	cIO->SetConnectId("T100");
+	//
+	// Session setup
+	if (cConnect.Create(c_Session) == false) {
+		ISLLogError(303, "Failed to setup the OpenISL session %s.", c_Session);
+		return -3;
+	}
+	ISLLogInfo(105, "The session %s has been setup.", cConnect.GetSessionId().c_str());
+	//
+	// ISL connection
+	if (cConnect.Connect(true) == false) {
+		ISLLogError(309, "Failed to connect the inputs to ISL transmitters.");
+		return -10;
+	}
+	ISLLogInfo(110, "Connected to the transmitters (futex: %s, lock-free: %s, wait policy: %s, batch: %d).",
+		cConnect.IsFutex() ? "yes" : "no", cConnect.IsLockFree() ? "yes" : "no",
+		isl::CVariable::GetWaitPolicyStr(cConnect.GetWaitPolicy()).c_str(), stCmdLine.m_nBatch);
+	//
+	// Stream
+	std::chrono::steady_clock::time_point tpStart = std::chrono::steady_clock::now();
+	if (stCmdLine.m_bConsumer) {
+		int nErrors = 0;
+		int nReceived = Consume(cIO, stCmdLine, &nErrors);
+		std::chrono::steady_clock::time_point tpEnd = std::chrono::steady_clock::now();
+		double dElapsed = std::chrono::duration<double, std::milli>(tpEnd - tpStart).count();
+		ISLLogInfo(111, "Samples: %d, batch: %d, elapsed: %.2fms, rate: %.0f samples/s",
+			nReceived, stCmdLine.m_nBatch, dElapsed, (dElapsed > 0.0 ? 1000.0 * nReceived / dElapsed : 0.0));
+		if (nErrors != 0) {
+			ISLLogWarning(203, "%d sample(s) received out of order.", nErrors);
+		}
+	}
+	else {
+		Produce(cIO, stCmdLine);
+	}
+	//
+	// Closing the connection
+	if (cConnect.Disconnect() == false) {
+		ISLLogError(308, "Failed to disconnect from the ISL session.");
+		return -8;
+	}
+	//
+	//
+	return 0;
+}